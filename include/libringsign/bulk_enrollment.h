@@ -0,0 +1,46 @@
+#ifndef RING_SIGNATURE_LIB_BULK_ENROLLMENT_H
+#define RING_SIGNATURE_LIB_BULK_ENROLLMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ring_signature_lib {
+
+// 批量签发的二进制消息，作为分帧协议中的一帧发送（见 kgc_server.h），多字节整数均为大端：
+//   请求：magic "RSBQ" | u8 版本 | u32 条目数 | 条目 {u16 ID 长度 | ID | u8 点长度 | 部分公钥 X_i 的八位组编码}
+//   响应：magic "RSBP" | u8 版本 | u8 update_config | u32 条目数 |
+//         条目 {u8 状态 | 成功: u8 点长度 | Y_i 压缩编码 | u16 长度 | z_i 大端字节
+//                      | 失败: u16 长度 | 错误信息}
+// 响应条目与请求条目一一对应、顺序相同；单个条目无效只影响该条目。
+const size_t kBulkMagicSize = 4;
+const uint8_t kBulkFormatVersion = 1;
+
+struct BulkEnrollmentRequest {
+    std::string id;
+    std::string partial_pub;  // X_i 的八位组编码（压缩或非压缩）
+};
+
+struct BulkEnrollmentResult {
+    bool ok = false;
+    std::string partial_system_pub;  // Y_i 的压缩编码
+    std::string partial_priv;        // z_i 的大端字节
+    std::string error;
+};
+
+// 帧是否为批量请求（只检查 magic，frame 至少包含前 kBulkMagicSize 字节时才能判断）
+bool IsBulkRequest(std::string_view frame);
+
+std::string EncodeBulkRequest(const std::vector<BulkEnrollmentRequest>& requests);
+// 格式错误时抛出异常
+std::vector<BulkEnrollmentRequest> DecodeBulkRequest(std::string_view frame);
+
+std::string EncodeBulkResponse(const std::vector<BulkEnrollmentResult>& results, bool update_config);
+// 格式错误时抛出异常；update_config 非空时写入响应中的标志
+std::vector<BulkEnrollmentResult> DecodeBulkResponse(std::string_view frame, bool* update_config = nullptr);
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_BULK_ENROLLMENT_H
@@ -9,12 +9,17 @@ namespace ring_signature_lib {
 
 const std::string DEFAULT_HASH_TYPE = "SHA256";
 const int DEFAULT_CURVE_NID = NID_secp256k1;
+// 新建系统使用的哈希输入编码版本；配置中缺少 "transcript_version" 时按 v1 处理
+const int DEFAULT_TRANSCRIPT_VERSION = 2;
 
 const std::string DEFAULT_CONFIG_PATH = "config/system_config.json";
 const std::string DEFAULT_KEY_PATH = "config/system_key.json";
 
 const std::string DEFAULT_SIGN_KEY_PATH = "config/sign_key.json";
 
+// signd 守护进程默认监听的 Unix 域套接字路径
+const std::string DEFAULT_SIGND_SOCKET_PATH = "config/signd.sock";
+
 class ConfigManager {
 public:
     static nlohmann::json LoadJson(const std::string& path);
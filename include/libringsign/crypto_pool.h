@@ -0,0 +1,102 @@
+#ifndef RING_SIGNATURE_LIB_CRYPTO_POOL_H
+#define RING_SIGNATURE_LIB_CRYPTO_POOL_H
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ring_signature_lib {
+
+// 线程局部的密码学上下文池：
+// - 每个线程只获取一次 HMAC 实现，并按 (摘要算法, 密钥) 缓存已设置密钥的 HMAC 上下文模板，
+//   使用时以 EVP_MAC_CTX_dup 复制，避免每次哈希都重新获取算法与设置密钥；
+// - 复用空闲的 BN_CTX，避免签名/验证中反复分配。
+// 各线程的缓存互不共享，无需加锁；线程退出时释放。
+class CryptoContextPool {
+public:
+    // 返回当前线程中已设置密钥的 HMAC 上下文模板，调用方不得修改或释放，须复制后使用
+    static const EVP_MAC_CTX* KeyedHmac(const EVP_MD* md, const std::string& key);
+
+    // 从当前线程的空闲列表取出 BN_CTX，没有空闲时新建
+    static BN_CTX* AcquireBnCtx();
+    // 归还 BN_CTX，空闲列表已满时直接释放
+    static void ReleaseBnCtx(BN_CTX* ctx);
+
+    // 每个线程缓存的 HMAC 模板数上限，超出时清空重建
+    static const size_t kMaxKeyedHmacs = 64;
+    // 每个线程保留的空闲 BN_CTX 数上限
+    static const size_t kMaxIdleBnCtxs = 8;
+};
+
+// 从线程局部池借用 BN_CTX，析构时归还
+class ScopedBnCtx {
+public:
+    ScopedBnCtx() : ctx_(CryptoContextPool::AcquireBnCtx()) {}
+    ~ScopedBnCtx() { CryptoContextPool::ReleaseBnCtx(ctx_); }
+
+    ScopedBnCtx(const ScopedBnCtx&) = delete;
+    ScopedBnCtx& operator=(const ScopedBnCtx&) = delete;
+
+    BN_CTX* get() const { return ctx_; }
+
+private:
+    BN_CTX* ctx_;
+};
+
+// 生成 [0, range) 内均匀分布的随机数写入 r（拒绝采样，随机字节取自私有 DRBG），
+// 与 BN_priv_rand_range 不同，随机字节在栈上生成，不分配堆内存；失败时抛出异常
+void RandRange(BIGNUM* r, const BIGNUM* range);
+
+// 单次签名/验证操作的临时对象分配器：从当前线程的栈中借出 BIGNUM、EC_POINT 与临时指针列表，
+// 析构时整体归还，预热后不再分配堆内存。
+// - 借出的 BIGNUM 值为 0，归还时清零（可能保存随机数）；借出的点为无穷远点，
+//   点按曲线（EC_METHOD 与曲线 NID）分栈复用，同一曲线的不同 EC_GROUP 对象共享；
+// - 借出的列表为空，归还时保留容量。
+// 作用域按后进先出嵌套：同一线程上后创建的 ScopedArena 须先析构。借出的对象只在作用域内有效，
+// 作用域内可交给其他线程读写（如并行分块的部分和），但只能在创建它的线程上借出与析构。
+class ScopedArena {
+public:
+    explicit ScopedArena(const EC_GROUP* group);
+    ~ScopedArena();
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    BIGNUM* Bn();
+    EC_POINT* Point();
+    // 借出空列表，T 可为 EC_POINT*、const EC_POINT*、BIGNUM*、const BIGNUM* 或 unsigned char
+    template <typename T>
+    std::vector<T>& List();
+
+    // 最外层作用域结束时每个栈保留的空闲对象数上限，超出部分释放
+    static const size_t kMaxIdleObjects = 1 << 16;
+
+    // 线程局部栈，定义见 crypto_pool.cpp
+    struct BnStack;
+    struct PointStack;
+    struct ListStacks;
+
+private:
+    static const size_t kListKinds = 5;
+
+    const EC_GROUP* group_;
+    BnStack* bns_;
+    PointStack* points_;
+    ListStacks* lists_;
+    size_t bn_mark_;
+    size_t point_mark_;
+    size_t list_marks_[kListKinds];
+};
+
+// 把一组点批量转为仿射坐标（Z = 1），点的值不变。每个点单独编码或转换时各需一次域求逆，
+// 这里用 Montgomery 同时求逆合并为一次求逆与每点若干次乘法；无穷远点保持不变。
+// 临时对象从 ScopedArena 借出，预热后不分配堆内存（EC_POINTs_make_affine 每次为每个点分配 BIGNUM）。
+// 在编码（PointEncoding、point2oct）或作为多标量乘法基点之前调用；失败时抛出异常
+void MakeAffine(const EC_GROUP* group, EC_POINT* const* points, size_t count, BN_CTX* ctx);
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_CRYPTO_POOL_H
@@ -0,0 +1,70 @@
+#ifndef RING_SIGNATURE_LIB_EC_BACKEND_H
+#define RING_SIGNATURE_LIB_EC_BACKEND_H
+
+#include <openssl/ec.h>
+#include <openssl/bn.h>
+#include <memory>
+#include <vector>
+
+namespace ring_signature_lib {
+
+// 椭圆曲线运算后端：签名、验证与密钥签发中的变基标量乘法、多标量乘法和定基点表都经由它完成。
+// 输入输出统一为 OpenSSL 的 EC_POINT 与 BIGNUM，其余代码（编码、哈希、序列化）与后端无关。
+// OpenSSL 后端适用于任意曲线；secp256k1 另有原生实现，由 ForGroup 按曲线自动选择。
+// 原生实现的变基标量乘法与多标量乘法不是常数时间实现，秘密标量一律经由 FixedBase::MulSecret。
+class EcBackend {
+public:
+    // 定基点表：对一个基点预计算倍点，之后的标量乘法只需加法
+    class FixedBase {
+    public:
+        virtual ~FixedBase() = default;
+
+        // 计算 r = k * base，失败时抛出异常；ctx 可为 nullptr。
+        // 查表与点加法不是常数时间实现，只用于公开标量（θ、φ、ψ、h_i 等）
+        virtual void Mul(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const = 0;
+
+        // 计算 r = k * base，k 为秘密标量（私钥、部分私钥、签名随机数）时使用：
+        // 不查表，经由 EC_POINT_mul 单点路径的常数时间蒙哥马利阶梯；失败时抛出异常，ctx 可为 nullptr
+        virtual void MulSecret(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const = 0;
+
+        // 返回基点
+        virtual const EC_POINT* GetBase() const = 0;
+    };
+
+    virtual ~EcBackend() = default;
+
+    // 后端名称，用于日志与基准测试输出
+    virtual const char* Name() const = 0;
+
+    // 计算 r = k * point，失败时抛出异常；r 可与 point 相同
+    virtual void Mul(const EC_GROUP* group, EC_POINT* r, const EC_POINT* point, const BIGNUM* k,
+                     BN_CTX* ctx) const = 0;
+
+    // 计算 r = Σ scalars[i] * points[i]，失败时抛出异常
+    virtual void MultiMul(const EC_GROUP* group, EC_POINT* r,
+                          const std::vector<const EC_POINT*>& points,
+                          const std::vector<const BIGNUM*>& scalars,
+                          BN_CTX* ctx) const = 0;
+
+    // 为 base 构建定基点表；teeth 为 OpenSSL 梳状表的齿数，原生后端使用自己的窗口大小
+    virtual std::unique_ptr<FixedBase> NewFixedBase(const EC_GROUP* group, const EC_POINT* base,
+                                                    int teeth) const = 0;
+
+    // 按群选择后端：曲线 NID 为 secp256k1 且未禁用原生实现时返回原生后端，否则返回 OpenSSL 后端
+    static const EcBackend& ForGroup(const EC_GROUP* group);
+
+    // OpenSSL 通用后端（梳状定基点表与 Straus/Pippenger 多标量乘法），用于对照测试
+    static const EcBackend& OpenSsl();
+
+    // 指定曲线的原生后端，没有时返回 nullptr
+    static const EcBackend* Native(int curve_nid);
+
+    // 启用或禁用原生后端（默认启用；环境变量 RINGSIGN_EC_BACKEND=openssl 时默认禁用），
+    // 只影响之后创建的 Signer 与 KeyGenerator
+    static void SetNativeEnabled(bool enabled);
+    static bool NativeEnabled();
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_EC_BACKEND_H
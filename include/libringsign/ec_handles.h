@@ -0,0 +1,71 @@
+#ifndef RING_SIGNATURE_LIB_EC_HANDLES_H
+#define RING_SIGNATURE_LIB_EC_HANDLES_H
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace ring_signature_lib {
+
+// OpenSSL 对象的 RAII 句柄：离开作用域或异常展开时自动释放。
+// BIGNUM 可能保存私钥或随机数，释放前清零。
+struct BnDeleter {
+    void operator()(BIGNUM* bn) const { BN_clear_free(bn); }
+};
+struct EcPointDeleter {
+    void operator()(EC_POINT* point) const { EC_POINT_free(point); }
+};
+struct EcGroupDeleter {
+    void operator()(EC_GROUP* group) const { EC_GROUP_free(group); }
+};
+struct OpensslStringDeleter {
+    void operator()(char* str) const { OPENSSL_free(str); }
+};
+
+using BnPtr = std::unique_ptr<BIGNUM, BnDeleter>;
+using EcPointPtr = std::unique_ptr<EC_POINT, EcPointDeleter>;
+using EcGroupPtr = std::unique_ptr<EC_GROUP, EcGroupDeleter>;
+using OpensslString = std::unique_ptr<char, OpensslStringDeleter>;
+
+// BIGNUM 的十六进制字符串（与 BN_bn2hex 相同），不泄漏 OpenSSL 分配的缓冲区
+inline std::string BnToHex(const BIGNUM* bn) {
+    OpensslString hex(BN_bn2hex(bn));
+    if (!hex) {
+        throw std::runtime_error("Failed to convert BIGNUM to hex");
+    }
+    return std::string(hex.get());
+}
+
+// 点的非压缩格式十六进制字符串（与 EC_POINT_point2hex 相同），不泄漏 OpenSSL 分配的缓冲区
+inline std::string PointToHex(const EC_GROUP* group, const EC_POINT* point, BN_CTX* ctx = nullptr) {
+    OpensslString hex(EC_POINT_point2hex(group, point, POINT_CONVERSION_UNCOMPRESSED, ctx));
+    if (!hex) {
+        throw std::runtime_error("Failed to convert EC point to hex");
+    }
+    return std::string(hex.get());
+}
+
+// 由十六进制字符串构造 BIGNUM，格式错误时抛出异常
+inline BnPtr BnFromHex(const std::string& hex) {
+    BIGNUM* bn = nullptr;
+    if (!BN_hex2bn(&bn, hex.c_str())) {
+        throw std::runtime_error("Failed to parse BIGNUM from hex");
+    }
+    return BnPtr(bn);
+}
+
+// 由十六进制字符串构造点，格式错误或不在曲线上时抛出异常
+inline EcPointPtr PointFromHex(const EC_GROUP* group, const std::string& hex, BN_CTX* ctx = nullptr) {
+    EcPointPtr point(EC_POINT_new(group));
+    if (!point || !EC_POINT_hex2point(group, hex.c_str(), point.get(), ctx)) {
+        throw std::runtime_error("Failed to parse EC point from hex");
+    }
+    return point;
+}
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_EC_HANDLES_H
@@ -4,6 +4,7 @@
 #include <openssl/bn.h>
 #include <openssl/evp.h>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 
 namespace ring_signature_lib {
@@ -16,16 +17,77 @@ public:
     // 计算哈希值，并返回 BIGNUM 格式
     BIGNUM* hashToBn(const std::string& data) const;
 
+    // 批量计算 count 条数据的哈希值，依次写入已有的 out[i]，结果与逐条调用 hashToBn 相同。
+    // SHA256 按 HashState::FinalToBnBatch 多条一组并行压缩，其他摘要逐条计算
+    void hashToBnBatch(const std::string_view* data, BIGNUM* const* out, size_t count) const;
+
     // 返回哈希密钥
     std::string GetKey() const { return hash_key_; }
 
     // 返回哈希类型
     std::string GetType() const { return hash_type_; }
 
+    // 低层摘要状态的存储大小（字节），不小于 MD5/SHA512 的上下文结构与 Sha256MultiBuffer::State
+    static const size_t kDigestStateSize = 224;
+
 private:
     std::string hash_key_;
     std::string hash_type_;
     const EVP_MD* evp_md_;
+    // MD5、SHA512（低层接口）与 SHA256（Sha256MultiBuffer::State）直接实现 HMAC：
+    // 预先吸收 K ^ ipad 与 K ^ opad 的两个摘要状态是普通结构体，复制时无需分配内存；
+    // 其他摘要（SM3），以及启用 FIPS 或摘要不由 default provider 提供时为 0，走 EVP_MAC 路径
+    int digest_kind_;
+    alignas(8) unsigned char hmac_inner_[kDigestStateSize];
+    alignas(8) unsigned char hmac_outer_[kDigestStateSize];
+
+    friend class HashState;
+};
+
+// 增量哈希状态：数据可分多次写入，结果与对拼接后的数据调用 hashToBn 相同。
+// 复制时会复制已写入数据的中间状态，可对公共前缀只哈希一次，再分别写入不同后缀。
+// 较短的写入（ID、点编码、长度前缀等）先攒入固定大小的缓冲区，凑满后一次写入 HMAC，
+// 减少逐字段调用 EVP_MAC_update 的开销，且内存占用与写入总量无关。
+// MD5/SHA256/SHA512 的状态为普通结构体，构造、复制与输出都不分配堆内存。
+class HashState {
+public:
+    explicit HashState(const HashUtils& hash);
+    ~HashState();
+
+    HashState(const HashState& other);
+    HashState& operator=(const HashState& other);
+    HashState(HashState&& other) noexcept;
+    HashState& operator=(HashState&& other) noexcept;
+
+    void Update(const void* data, size_t len);
+    void Update(std::string_view data) { Update(data.data(), data.size()); }
+
+    // 输出哈希值并转换为 BIGNUM，之后不可再写入
+    BIGNUM* FinalToBn();
+    // 输出哈希值写入已有的 BIGNUM（如 ScopedArena 借出的对象），不分配新的 BIGNUM
+    void FinalToBn(BIGNUM* out);
+
+    // 批量输出：states[i] 的哈希值写入 out[i]，结果与逐个调用 FinalToBn 相同，之后各状态不可再写入。
+    // SHA256 状态每 kBatchSize 个一组，缓冲区中的剩余数据、填充与 HMAC 外层哈希交给
+    // Sha256MultiBuffer 多通道并行压缩；其他摘要逐个输出。不分配堆内存
+    static void FinalToBnBatch(HashState* const* states, BIGNUM* const* out, size_t count);
+
+    // 写入缓冲区大小（字节），不小于此长度的数据直接写入 HMAC
+    static const size_t kBufferSize = 512;
+    // FinalToBnBatch 每组的状态数，与最宽的多缓冲实现（AVX-512，16 通道）一致
+    static constexpr size_t kBatchSize = 16;
+
+private:
+    EVP_MAC_CTX* ctx_;  // 仅 EVP_MAC 路径使用
+    int digest_kind_;
+    alignas(8) unsigned char inner_[HashUtils::kDigestStateSize];  // 已吸收 K ^ ipad 与已写入数据
+    alignas(8) unsigned char outer_[HashUtils::kDigestStateSize];  // 已吸收 K ^ opad
+    unsigned char buffer_[kBufferSize];
+    size_t buffered_;
+
+    void flush();
+    size_t final(unsigned char* out);
+    static void final_sha256_batch(HashState* const* states, BIGNUM* const* out, size_t count);
 };
 
 } // namespace ring_signature_lib
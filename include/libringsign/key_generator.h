@@ -1,13 +1,21 @@
 #ifndef RING_SIGNATURE_LIB_KEY_GENERATOR_H
 #define RING_SIGNATURE_LIB_KEY_GENERATOR_H
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <openssl/ec.h>
 #include <openssl/bn.h>
 #include <nlohmann/json.hpp>
 #include "libringsign/hash_utils.h"
 #include "libringsign/config_manager.h"
+#include "libringsign/ec_backend.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/precompute.h"
+#include "libringsign/thread_pool.h"
+#include "libringsign/transcript.h"
 
 namespace ring_signature_lib {
 
@@ -25,23 +33,53 @@ public:
 
     int GetCurveNid() const { return curve_nid_; }
     std::string GetHashType() const { return hash_type_; }
-    const BIGNUM* GetPrivateKey() const { return private_key_; }
-    const EC_POINT* GetPublicKey() const { return public_key_; }
-    EC_GROUP* GetGroup() const { return group_; }
+    // 系统公开参数（与 system_config.json 的内容相同），可分发给签名者
+    nlohmann::json GetPublicConfig() const;
+    // 系统的哈希输入编码版本，决定 H_1 的输入编码
+    int GetTranscriptVersion() const { return transcript_version_; }
+    // 设置系统的哈希输入编码版本，须在保存配置与签发部分密钥之前调用
+    void SetTranscriptVersion(int version);
+    const BIGNUM* GetPrivateKey() const { return private_key_.get(); }
+    const EC_POINT* GetPublicKey() const { return public_key_.get(); }
+    EC_GROUP* GetGroup() const { return group_.get(); }
     const std::vector<std::string>& GetHashKeys() const {
     return hash_keys_;
 }
+    // 获取系统参数的固定基点预计算层
+    PrecomputeCache* GetPrecomputeCache() const { return precompute_.get(); }
+    // 椭圆曲线运算后端，初始化或加载配置时按曲线选择，须在此之后调用
+    const EcBackend& GetEcBackend() const { return *backend_; }
 
+    // 为签名者签发部分公钥 Y_i 与部分私钥 z_i，返回值归调用方所有。
+    // seed 为 0 时系统状态参数 ξ 取自 OpenSSL 的随机数，否则由 seed 确定（便于复现）；可在多个线程中并发调用
     std::pair<EC_POINT*, BIGNUM*> GenerateSignKey(const std::string& signer_id, const EC_POINT* signer_public_key, unsigned int seed = 0);
+    // 批量签发：同一批共用系统状态参数，按 SetThreadCount 设置的线程数分块并行，每个分块使用自己的 BN_CTX；
+    // 结果与输入顺序一致，与逐个调用 GenerateSignKey(同一非零 seed) 相同
+    std::vector<std::pair<EcPointPtr, BnPtr>> GenerateSignKeys(
+        const std::pair<std::string, const EC_POINT*>* signers, size_t count, unsigned int seed = 0);
+    std::vector<std::pair<EcPointPtr, BnPtr>> GenerateSignKeys(
+        const std::vector<std::pair<std::string, const EC_POINT*>>& signers, unsigned int seed = 0);
+
+    // 设置批量签发使用的线程数（含调用线程），0 或 1 表示单线程（默认）
+    void SetThreadCount(size_t threads);
+    size_t GetThreadCount() const { return pool_ ? pool_->Size() : 1; }
+
+    // 批量签发时每个分块的最少签名者数
+    static const size_t kMinSignKeysPerChunk = 64;
 
 private:
     int curve_nid_;
     std::string hash_type_;
-    EC_GROUP* group_;
-    BIGNUM* private_key_;
-    EC_POINT* public_key_;
+    int transcript_version_;
+    EcGroupPtr group_;
+    BnPtr private_key_;
+    EcPointPtr public_key_;
+    PointEncoding public_key_encoding_;  // P_pub 的编码，H_1 中每次签发都要写入
     std::vector<std::string> hash_keys_;
     std::vector<HashUtils> hash_;
+    const EcBackend* backend_;
+    std::shared_ptr<PrecomputeCache> precompute_;
+    std::shared_ptr<ThreadPool> pool_;  // 批量签发的线程池，单线程时为空
     bool is_initialized_;
 
     void initialize(unsigned int seed);
@@ -49,7 +87,10 @@ private:
     void load_public_config(const std::string& config_path);
     void save_keys(const std::string& system_key_path);
     void load_keys(const std::string& system_key_path);
-    std::pair<EC_POINT*, BIGNUM*> generate_sign_key(const std::string& signer_id, const EC_POINT* signer_public_key, unsigned int seed);
+    void generate_sign_key(const std::string& signer_id, const EC_POINT* signer_public_key,
+                           const std::string& system_state_param, EC_POINT* partial_system_public_key,
+                           BIGNUM* partial_private_key, BN_CTX* ctx);
+    static std::string system_state_param(unsigned int seed);
 };
 
 } // namespace ring_signature_lib
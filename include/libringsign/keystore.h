@@ -0,0 +1,74 @@
+#ifndef RING_SIGNATURE_LIB_KEYSTORE_H
+#define RING_SIGNATURE_LIB_KEYSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "libringsign/mapped_file.h"
+
+namespace ring_signature_lib {
+
+class RingContext;
+
+// 公钥目录（keystore）：把大量环成员的公钥与环上下文的预计算结果编译为一个二进制文件，
+// 以只读内存映射打开，打开时只检查头部，不解析成员；多个进程映射同一文件时共享页缓存。
+// 多字节整数均为大端：
+//   头部：magic "RKEY" | u8 格式版本 | u8 transcript 版本 | u8 点宽度 | u8 标量宽度 |
+//         u32 曲线 NID | u32 成员数 n | u32 ID 表字节数 | 系统参数指纹（32 字节，见 Signer::SystemFingerprint）
+//   索引：n 个 {u32 ID 偏移 | u32 ID 长度}，按 ID 字节序升序（与 RingContext 的成员顺序一致）
+//   记录：n 个 {X_i | Y_i（压缩编码）| K_i（非压缩编码）| h_i（标量宽度，左侧补零）}，与索引一一对应
+// K_i 只作为多标量乘法的基点使用，以非压缩编码存储，加载时省去一次开平方。
+//   ID 表：各成员 ID 依次拼接
+// h_i 与 K_i 依赖系统公钥、H_1 的密钥与 transcript 版本，系统参数更换后须重新编译。
+const uint8_t kKeystoreFormatVersion = 1;
+const size_t kKeystoreFingerprintSize = 32;
+
+class Keystore {
+public:
+    // 映射并检查头部与各区域的长度，格式错误时抛出异常
+    explicit Keystore(const std::string& path);
+
+    // 由已预计算 K_i 的环上下文编译公钥目录并写入 path；先写入临时文件再重命名，
+    // 已映射旧文件的进程不受影响。fingerprint 与 transcript_version 取自构建环上下文的系统参数
+    static void Save(const std::string& path, const RingContext& ring, const std::string& fingerprint,
+                     int transcript_version);
+
+    size_t Size() const { return count_; }
+    int TranscriptVersion() const { return transcript_version_; }
+    int CurveNid() const { return curve_nid_; }
+    std::string_view Fingerprint() const { return fingerprint_; }
+    size_t PointSize() const { return point_size_; }
+    size_t ScalarSize() const { return scalar_size_; }
+
+    // 按 ID 二分查找成员位置，未找到时返回 -1
+    long IndexOf(std::string_view id) const;
+
+    // 第 i 个成员的字段，均为引用映射内容的视图；PointSize 为压缩编码的宽度
+    std::string_view Id(size_t i) const;
+    std::string_view X(size_t i) const { return record(i).substr(0, point_size_); }
+    std::string_view Y(size_t i) const { return record(i).substr(point_size_, point_size_); }
+    std::string_view K(size_t i) const { return record(i).substr(2 * point_size_, 2 * point_size_ - 1); }
+    std::string_view H(size_t i) const { return record(i).substr(4 * point_size_ - 1, scalar_size_); }
+
+private:
+    MappedFile file_;
+    int transcript_version_;
+    int curve_nid_;
+    size_t point_size_;
+    size_t scalar_size_;
+    size_t count_;
+    std::string_view fingerprint_;
+    std::string_view index_;
+    std::string_view records_;
+    std::string_view ids_;
+
+    std::string_view record(size_t i) const {
+        size_t size = 4 * point_size_ - 1 + scalar_size_;
+        return records_.substr(i * size, size);
+    }
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_KEYSTORE_H
@@ -0,0 +1,131 @@
+#ifndef RING_SIGNATURE_LIB_KGC_SERVER_H
+#define RING_SIGNATURE_LIB_KGC_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "libringsign/key_generator.h"
+#include "libringsign/network_utils.h"
+
+namespace ring_signature_lib {
+
+struct KgcServerOptions {
+    std::string ip = "127.0.0.1";
+    int port = 8080;                    // 为 0 时绑定临时端口（见 KgcServer::Port）
+    int backlog = 1024;                 // listen 队列长度
+    size_t max_connections = 4096;      // 同时打开的连接数上限，达到后暂停 accept，新连接留在内核队列中
+    size_t workers = 0;                 // 计算部分密钥的工作线程数，0 表示硬件并发数
+    size_t max_request_size = 64 * 1024;  // 单个请求（帧）的最大字节数
+    size_t max_bulk_request_size = 32u << 20;  // 批量签发请求帧的最大字节数（约 70 万个签名者）
+    size_t max_pipeline = 64;           // 每个连接上已读取但未写出响应的请求数上限，达到后暂停读取
+    size_t max_read_per_wakeup = 1u << 20;  // 每次可读事件从一个连接读取的最大字节数，其余留待下次事件
+    double report_interval = 5.0;       // 输出签发速率的间隔（秒），0 表示不输出
+    bool update_config = false;         // 响应中的 update_config 标志（-newsys 时为 1）
+    bool verbose = false;               // 逐个输出签名者 ID
+};
+
+// 事件驱动的 KGC 服务（Linux epoll）：单线程在非阻塞套接字上完成 accept 与收发，
+// 部分密钥的计算交给工作线程池，结果经 eventfd 通知回 I/O 线程写出。
+//
+// 连接的第一个字节决定协议：
+//   '{'：旧协议，发送一个不分帧的 JSON 请求 {"id", "partial_pub"}，收到 JSON 响应后连接关闭；
+//   其他：分帧协议（见 network_utils.h），持久连接，每帧一个请求，可不等响应连续发送（流水线），
+//         响应按请求顺序逐帧返回，客户端关闭写端或断开后结束。
+// 请求 {"op": "enroll", "id", "partial_pub"}（缺少 op 时为 enroll）签发部分密钥，
+// {"op": "params"} 返回系统公开参数；失败时响应 {"error": ...}。
+// 分帧协议下还可发送批量签发帧（格式见 bulk_enrollment.h），一帧携带成千上万个签名者，
+// 由一个工作线程共用 BN_CTX 逐个签发，返回一个按条目顺序排列的响应帧。
+class KgcServer {
+public:
+    KgcServer(KeyGenerator& keygen, const KgcServerOptions& options);
+    ~KgcServer();
+
+    KgcServer(const KgcServer&) = delete;
+    KgcServer& operator=(const KgcServer&) = delete;
+
+    // 运行事件循环，直到 Stop 被调用
+    void Run();
+    // 可在任意线程或信号处理函数中调用
+    void Stop();
+
+    int Port() const { return server_.Port(); }
+    size_t Enrollments() const { return enrollments_.load(); }
+    size_t Errors() const { return errors_.load(); }
+
+    // 处理一条请求并返回响应 JSON（工作线程调用）；请求无效时返回 {"error": ...}
+    std::string HandleRequest(const std::string& request);
+    // 处理一个批量签发帧并返回响应帧；帧格式错误时抛出异常，单个条目无效只影响该条目
+    std::string HandleBulkRequest(std::string_view request);
+
+private:
+    enum class Protocol { Unknown, Legacy, Framed };
+    struct Connection {
+        Protocol protocol = Protocol::Unknown;
+        std::string in;                          // 未解析的输入
+        std::string out;                         // 待写出的响应
+        size_t written = 0;
+        uint64_t next_seq = 0;                   // 下一个请求的序号
+        uint64_t next_write = 0;                 // 下一个应写出的响应序号
+        std::map<uint64_t, std::string> ready;   // 已完成但前序响应尚未写出的响应
+        size_t in_flight = 0;                    // 已交给工作线程、尚未完成的请求数
+        uint32_t events = 0;                     // 当前在 epoll 中关注的事件
+        bool eof = false;                        // 对端已关闭写端，或不再读取（旧协议）
+        bool discard = false;                    // 已拒绝过大的请求：响应写出后关闭写端，丢弃其余输入直到对端关闭
+        bool write_shutdown = false;             // 已关闭写端
+        size_t discarded = 0;                    // 拒绝请求后丢弃的输入字节数
+        bool closed = false;                     // 连接出错，工作线程的结果返回后直接关闭
+    };
+    struct Job {
+        int fd;
+        uint64_t seq;
+        std::string data;  // 请求内容，完成后为响应内容
+    };
+
+    KeyGenerator& keygen_;
+    KgcServerOptions options_;
+    TCPServer server_;
+    int epoll_fd_;
+    int event_fd_;
+    std::atomic<bool> stop_;
+    std::atomic<size_t> enrollments_;
+    std::atomic<size_t> errors_;
+
+    std::unordered_map<int, Connection> connections_;  // 仅 I/O 线程访问
+    bool accepting_;
+
+    std::vector<std::thread> workers_;
+    std::mutex jobs_mutex_;
+    std::condition_variable jobs_cv_;
+    std::deque<Job> jobs_;       // 待计算的请求
+    std::mutex done_mutex_;
+    std::vector<Job> done_;      // 已计算的响应
+
+    void worker_loop();
+    void set_accepting(bool accepting);
+    void accept_connections();
+    void on_readable(int fd);
+    // 连接上未解析输入的上限：旧协议为一个请求，分帧协议为一个批量请求帧及其长度头
+    size_t input_limit(const Connection& conn) const;
+    void on_writable(int fd);
+    // 解析已缓冲的请求并交给工作线程，随后决定关闭连接或更新关注的事件
+    void process(int fd, Connection& conn);
+    void dispatch(int fd, Connection& conn, std::string request);
+    void respond(int fd, Connection& conn, uint64_t seq, std::string response);
+    void update_events(int fd, Connection& conn);
+    void drain_completions();
+    void close_connection(int fd);
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_KGC_SERVER_H
@@ -0,0 +1,40 @@
+#ifndef RING_SIGNATURE_LIB_MAPPED_FILE_H
+#define RING_SIGNATURE_LIB_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ring_signature_lib {
+
+// 只读内存映射文件：内容直接来自页缓存，不复制到用户态缓冲区。
+// 默认提示内核按顺序访问（MADV_SEQUENTIAL），便于预读并及时回收已读页面；
+// 按索引随机查找的文件（如公钥目录）使用 Access::Random，避免无用的预读。
+// 空文件不做映射，View() 返回空视图；Windows 下退化为一次性读入内存。
+class MappedFile {
+public:
+    enum class Access { Sequential, Random };
+
+    // 打开或映射失败时抛出异常
+    explicit MappedFile(const std::string& path, Access access = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 文件内容的视图，在 MappedFile 析构前有效
+    std::string_view View() const { return std::string_view(static_cast<const char*>(data_), size_); }
+    size_t Size() const { return size_; }
+
+private:
+    void* data_;
+    size_t size_;
+
+    void release();
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_MAPPED_FILE_H
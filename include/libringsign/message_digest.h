@@ -0,0 +1,55 @@
+#ifndef RING_SIGNATURE_LIB_MESSAGE_DIGEST_H
+#define RING_SIGNATURE_LIB_MESSAGE_DIGEST_H
+
+#include <openssl/evp.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ring_signature_lib {
+
+// 签名中消息的输入方式，记录在签名元数据 "message_mode" 中
+// raw：消息原文直接作为方案中的 msg
+// digest：先对消息做流式摘要，方案中的 msg 为带算法名的摘要值，大文件只需读取一次
+const std::string MESSAGE_MODE_RAW = "raw";
+const std::string MESSAGE_MODE_DIGEST = "digest";
+
+// 消息摘要：按固定大小分块写入，不需要把整个消息读入内存
+class MessageDigest {
+public:
+    // algorithm 为 OpenSSL 摘要算法名（如 SHA256、SHA512、SM3），不支持时抛出异常
+    explicit MessageDigest(const std::string& algorithm = kDefaultAlgorithm);
+    ~MessageDigest();
+
+    MessageDigest(const MessageDigest&) = delete;
+    MessageDigest& operator=(const MessageDigest&) = delete;
+
+    void Update(const void* data, size_t len);
+    void Update(std::string_view data) { Update(data.data(), data.size()); }
+
+    // 输出摘要并转换为方案中使用的 msg，之后不可再写入
+    std::string FinalToMessage();
+
+    const std::string& GetAlgorithm() const { return algorithm_; }
+
+    // 以只读内存映射方式读取文件，按 chunk_size 字节分块写入摘要，返回方案中使用的 msg
+    static std::string DigestFile(const std::string& path, const std::string& algorithm = kDefaultAlgorithm,
+                                  size_t chunk_size = kDefaultChunkSize);
+    // 对内存中的消息计算方案中使用的 msg
+    static std::string DigestString(std::string_view data, const std::string& algorithm = kDefaultAlgorithm);
+
+    // 由算法名与摘要值构造方案中使用的 msg。加入域分隔前缀与算法名，
+    // 避免摘要模式的签名被当作对摘要字节串本身（或其他算法摘要）的原文签名
+    static std::string ToMessage(const std::string& algorithm, const unsigned char* digest, size_t len);
+
+    static const std::string kDefaultAlgorithm;
+    static const size_t kDefaultChunkSize = 1 << 20;
+
+private:
+    std::string algorithm_;
+    EVP_MD_CTX* ctx_;
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_MESSAGE_DIGEST_H
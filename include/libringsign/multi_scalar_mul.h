@@ -0,0 +1,45 @@
+#ifndef RING_SIGNATURE_LIB_MULTI_SCALAR_MUL_H
+#define RING_SIGNATURE_LIB_MULTI_SCALAR_MUL_H
+
+#include <openssl/ec.h>
+#include <openssl/bn.h>
+#include <vector>
+
+namespace ring_signature_lib {
+
+// 多标量乘法引擎：计算 r = Σ scalars[i] * points[i]
+// 小规模输入使用 Straus（交错固定窗口），大规模输入使用 Pippenger（桶方法），
+// 算法与窗口大小根据点的数量自动选择。
+class MultiScalarMul {
+public:
+    // 计算多标量乘法，失败时抛出异常
+    static void Compute(const EC_GROUP* group, EC_POINT* r,
+                        const std::vector<const EC_POINT*>& points,
+                        const std::vector<const BIGNUM*>& scalars,
+                        BN_CTX* ctx);
+
+    // 根据点的数量和标量位数选择 Pippenger 窗口大小
+    static int PippengerWindow(size_t n, int bits);
+
+    // 点数量不超过该阈值时使用 Straus（经验值：Straus 预计算表中的点非仿射，
+    // 加法代价高于 Pippenger 中对仿射输入点的混合加法）
+    static const size_t kStrausThreshold = 24;
+
+    // Straus 每个点的预计算窗口大小
+    static const int kStrausWindow = 4;
+
+private:
+    // digits 为各点标量的小端字节串，依次存放，每个 len 字节
+    static void straus(const EC_GROUP* group, EC_POINT* r,
+                       const std::vector<const EC_POINT*>& points,
+                       const unsigned char* digits, size_t len,
+                       int bits, BN_CTX* ctx);
+    static void pippenger(const EC_GROUP* group, EC_POINT* r,
+                          const std::vector<const EC_POINT*>& points,
+                          const unsigned char* digits, size_t len,
+                          int bits, BN_CTX* ctx);
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_MULTI_SCALAR_MUL_H
@@ -1,13 +1,32 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include <string_view>
+
+// 长度前缀分帧：每帧为 4 字节大端长度加负载，收发循环直到整帧完成（处理短读写与 EINTR）。
+// 同一连接上可连续发送多帧（持久连接、流水线请求）。
+const size_t kMaxFrameSize = 256u << 20;
+void SendFrame(int fd, std::string_view payload);
+// 读取一帧到 payload；对端在帧边界关闭连接时返回 false，
+// 长度超过 max_size 或连接在帧中间断开时抛出异常
+bool RecvFrame(int fd, std::string& payload, size_t max_size = kMaxFrameSize);
 
 class TCPServer {
 public:
-    TCPServer(const std::string& ip, int port);
+    // backlog 为内核中等待 accept 的连接队列长度；port 为 0 时绑定临时端口
+    TCPServer(const std::string& ip, int port, int backlog = 128);
     ~TCPServer();
     int Accept(); // 返回已连接的socket fd
+    int Fd() const { return server_fd_; }
+    int Port() const; // 实际绑定的端口
+    // 无分帧的单次收发（旧协议）：Recv 只读取一次，最多 4095 字节
     std::string Recv(int client_fd);
     void Send(int client_fd, const std::string& msg);
+    // 分帧收发，见 SendFrame/RecvFrame
+    void SendFrame(int client_fd, std::string_view msg) { ::SendFrame(client_fd, msg); }
+    bool RecvFrame(int client_fd, std::string& msg, size_t max_size = kMaxFrameSize) {
+        return ::RecvFrame(client_fd, msg, max_size);
+    }
     void Close(int client_fd);
     void CloseServer();
 private:
@@ -19,11 +38,44 @@ public:
     TCPClient(const std::string& ip, int port);
     ~TCPClient();
     void Connect();
+    // 无分帧的单次收发（旧协议）：Recv 只读取一次，最多 4095 字节
     void Send(const std::string& msg);
     std::string Recv();
+    // 分帧收发：连接建立后可反复请求，也可先连续发送多帧再依次读取响应
+    void SendFrame(std::string_view msg) { ::SendFrame(sock_fd_, msg); }
+    bool RecvFrame(std::string& msg, size_t max_size = kMaxFrameSize) { return ::RecvFrame(sock_fd_, msg, max_size); }
+    int Fd() const { return sock_fd_; }
     void Close();
 private:
     int sock_fd_;
     std::string ip_;
     int port_;
-}; 
\ No newline at end of file
+};
+
+#ifndef _WIN32
+// Unix 域套接字服务端，供本机守护进程（signd）使用；套接字文件权限为 0600，仅属主可连接。
+// 启动时删除残留的套接字文件，已有服务在该路径监听或路径不是套接字时抛出异常；关闭时删除
+class UnixSocketServer {
+public:
+    UnixSocketServer(const std::string& path, int backlog = 64);
+    ~UnixSocketServer();
+    int Accept(); // 返回已连接的socket fd
+    void Close(int client_fd);
+    void CloseServer();
+private:
+    int server_fd_;
+    std::string path_;
+};
+
+class UnixSocketClient {
+public:
+    explicit UnixSocketClient(const std::string& path);
+    ~UnixSocketClient();
+    void Connect();
+    int Fd() const { return sock_fd_; }
+    void Close();
+private:
+    int sock_fd_;
+    std::string path_;
+};
+#endif 
\ No newline at end of file
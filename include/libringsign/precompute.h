@@ -0,0 +1,112 @@
+#ifndef RING_SIGNATURE_LIB_PRECOMPUTE_H
+#define RING_SIGNATURE_LIB_PRECOMPUTE_H
+
+#include <openssl/ec.h>
+#include <openssl/bn.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "libringsign/ec_backend.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/hash_utils.h"
+
+namespace ring_signature_lib {
+
+// 固定基点预计算表（Lim-Lee 梳状法）
+// 对 t 个齿、d = ceil(bits / t) 的梳子预存 2^t - 1 个仿射点，
+// 之后每次标量乘法只需 d 次倍点和至多 d 次混合加法。
+// 注意：查表与点加法均不是常数时间实现，秘密标量须使用 MulSecret。
+// 这是 OpenSSL 后端的定基点表，适用于任意曲线。
+class FixedBaseTable : public EcBackend::FixedBase {
+public:
+    FixedBaseTable(const EC_GROUP* group, const EC_POINT* base, int teeth = kDefaultTeeth);
+    ~FixedBaseTable() override;
+
+    FixedBaseTable(const FixedBaseTable&) = delete;
+    FixedBaseTable& operator=(const FixedBaseTable&) = delete;
+
+    // 计算 r = k * base，失败时抛出异常；ctx 可为 nullptr
+    void Mul(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const override;
+
+    // 常数时间计算 r = k * base（EC_POINT_mul），不使用预计算表
+    void MulSecret(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const override;
+
+    // 返回基点
+    const EC_POINT* GetBase() const override { return base_; }
+
+    static const int kDefaultTeeth = 8;
+    // 支持的群阶最大字节数（P-521 为 66 字节），标量在栈上展开
+    static const int kMaxScalarBytes = 66;
+
+private:
+    const EC_GROUP* group_;
+    EC_POINT* base_;
+    int teeth_;                      // 齿数 t
+    int spacing_;                    // 齿间距 d
+    std::vector<EC_POINT*> table_;   // table_[j - 1] = Σ_{bit k of j} 2^(k*d) * base
+};
+
+// 系统参数的预计算层：持有生成元 G、系统公钥 P_pub 的固定基点表，
+// 以及按事件字符串索引的 E = H_0(event) * G 表的 LRU 缓存。
+// 各表由指定的椭圆曲线后端构建，未指定时使用 OpenSSL 梳状表（FixedBaseTable）。
+class PrecomputeCache {
+public:
+    // 事件表缓存的统计信息，用于确定缓存容量
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t size;
+        size_t capacity;
+    };
+
+    PrecomputeCache(const EC_GROUP* group, const EC_POINT* system_public_key,
+                    const HashUtils& event_hash, size_t event_capacity = kDefaultEventCapacity,
+                    const EcBackend* backend = nullptr);
+
+    PrecomputeCache(const PrecomputeCache&) = delete;
+    PrecomputeCache& operator=(const PrecomputeCache&) = delete;
+
+    const EcBackend::FixedBase& Generator() const { return *generator_; }
+    const EcBackend::FixedBase& SystemPublicKey() const { return *system_public_key_; }
+
+    // 获取事件点 E = H_0(event) * G 的预计算表，未命中时计算并放入缓存
+    std::shared_ptr<const EcBackend::FixedBase> EventTable(const std::string& event);
+
+    // 设置事件表缓存容量（至少为 1），超出部分按 LRU 淘汰
+    void SetEventCapacity(size_t capacity);
+
+    Stats GetStats() const;
+
+    static constexpr size_t kDefaultEventCapacity = 16;
+
+private:
+    using LruList = std::list<std::pair<std::string, std::shared_ptr<const EcBackend::FixedBase>>>;
+
+    EcGroupPtr group_;  // 自有的群副本，缓存可在多个签名者之间共享而不依赖其中任何一个的生命周期
+    HashUtils event_hash_;
+    const EcBackend* backend_;  // 为空时使用 FixedBaseTable
+    std::unique_ptr<EcBackend::FixedBase> generator_;
+    std::unique_ptr<EcBackend::FixedBase> system_public_key_;
+
+    std::unique_ptr<EcBackend::FixedBase> new_table(const EC_POINT* base) const;
+
+    mutable std::mutex mutex_;
+    size_t event_capacity_;
+    LruList lru_;                                                  // 表头为最近使用
+    std::unordered_map<std::string, LruList::iterator> events_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+
+    void evict_locked();
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_PRECOMPUTE_H
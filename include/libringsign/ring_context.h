@@ -0,0 +1,86 @@
+#ifndef RING_SIGNATURE_LIB_RING_CONTEXT_H
+#define RING_SIGNATURE_LIB_RING_CONTEXT_H
+
+#include <openssl/ec.h>
+#include <openssl/bn.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "libringsign/hash_utils.h"
+#include "libringsign/precompute.h"
+#include "libringsign/thread_pool.h"
+#include "libringsign/transcript.h"
+
+namespace ring_signature_lib {
+
+class Keystore;
+
+// 环上下文：保存只依赖环成员的预计算结果，可在多次签名/验证之间复用。
+// 包括按 ID 排序后的成员顺序、公钥编码、h_i = H_1(ID_i || X_i || P_pub)
+// 以及合并点 K_i = X_i + Y_i + h_i * P_pub。
+class RingContext {
+public:
+    using Member = std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>;
+
+    struct Entry {
+        std::string id;          // 成员 ID
+        EC_POINT* X;             // 公钥 X_i
+        EC_POINT* Y;             // 公钥 Y_i
+        PointEncoding X_enc;     // X_i 在各 transcript 版本下的编码
+        PointEncoding Y_enc;     // Y_i 在各 transcript 版本下的编码
+        BIGNUM* h;               // h_i = H_1(ID_i || X_i || P_pub)
+        EC_POINT* XY;            // X_i + Y_i（仿射坐标）
+        EC_POINT* K;             // K_i = X_i + Y_i + h_i * P_pub（仿射坐标），未预计算时为 nullptr
+    };
+
+    // 由成员列表构建环上下文，成员公钥会被复制；存在重复 ID 时抛出异常。
+    // h_i 按系统的 transcript 版本 transcript_version 编码。
+    // combine 为 false 时不预计算 K_i（需要 n 次固定基点乘法），
+    // 适用于只使用一次的环，签名/验证改为聚合 ∑ a_i h_i 后乘 P_pub。
+    // 提供 pool 时按成员分块并行计算编码、h_i 与 K_i。
+    RingContext(const EC_GROUP* group, const EC_POINT* system_public_key, const HashUtils& id_hash,
+                int transcript_version, const std::vector<Member>& members, const EcBackend::FixedBase* system_public_key_table = nullptr,
+                bool combine = true, ThreadPool* pool = nullptr);
+    // 由公钥目录中的成员构建环上下文，indices 为成员在目录中的位置，须严格升序（即按 ID 排序且不重复）。
+    // X_i、Y_i、h_i 与 K_i 直接取自目录，只需解压缩点，不再计算 H_1 与 h_i * P_pub；
+    // combine 为 false 时不读取 K_i。目录须与系统参数一致（见 Signer::CreateRingContext），数据无效时抛出异常
+    RingContext(const EC_GROUP* group, const Keystore& keystore, const std::vector<size_t>& indices,
+                bool combine = true, ThreadPool* pool = nullptr);
+    ~RingContext();
+
+    RingContext(RingContext&& other) noexcept;
+    RingContext& operator=(RingContext&& other) noexcept;
+    RingContext(const RingContext&) = delete;
+    RingContext& operator=(const RingContext&) = delete;
+
+    size_t Size() const { return entries_.size(); }
+    const Entry& operator[](size_t i) const { return entries_[i]; }
+    const std::vector<Entry>& Entries() const { return entries_; }
+    const EC_GROUP* GetGroup() const { return group_; }
+    // 是否已预计算合并点 K_i
+    bool HasCombinedPoints() const { return combined_; }
+
+    // 按 ID 二分查找成员位置，未找到时返回 -1
+    int IndexOf(const std::string& id) const;
+
+    // 并行处理环成员时每个分块的最少成员数，更小的环留在调用线程上执行
+    static const size_t kMinMembersPerChunk = 64;
+
+private:
+    const EC_GROUP* group_;
+    std::vector<Entry> entries_;
+    bool combined_;
+
+    // entry 的 id、X、Y 已由调用方填入（X、Y 为仿射坐标）
+    void build_entry(Entry& entry, const EC_POINT* system_public_key, const PointEncoding& ppub_enc,
+                     const HashUtils& id_hash, int transcript_version,
+                     const EcBackend::FixedBase* system_public_key_table, EC_POINT* temp_point, BN_CTX* ctx);
+    void load_entry(Entry& entry, const Keystore& keystore, size_t index, BN_CTX* ctx);
+    // 将 [begin, end) 内成员的 X_i + Y_i 与 K_i 统一转为仿射坐标
+    void normalize_points(size_t begin, size_t end, BN_CTX* ctx);
+    void release();
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_RING_CONTEXT_H
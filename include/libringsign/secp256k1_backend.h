@@ -0,0 +1,21 @@
+#ifndef RING_SIGNATURE_LIB_SECP256K1_BACKEND_H
+#define RING_SIGNATURE_LIB_SECP256K1_BACKEND_H
+
+#include "libringsign/ec_backend.h"
+
+namespace ring_signature_lib {
+
+// secp256k1 的原生后端，不经过 OpenSSL 的通用 EC_POINT 运算：
+//   - 域元素为 4 个 64 位字，按 p = 2^256 - 2^32 - 977 的特殊形式约化，求逆用固定的加法链
+//   - 点运算使用 Jacobian 坐标（a = 0 的倍点公式）与仿射点的混合加法
+//   - 变基标量乘法与多标量乘法用 GLV 自同态 λ(x, y) = (βx, y) 把标量拆为两个约 128 位的半长标量，
+//     每个点的奇数倍点表按 wNAF 查表；多标量乘法的所有倍点表共用一次域求逆转为仿射坐标，
+//     点多时改用有符号数字的 Pippenger 桶方法，输入点仿射化后全部为混合加法
+//   - 定基点表按 5 位有符号窗口预存仿射倍点，乘法只做加法不做倍点
+// 首次使用时用 OpenSSL 核对曲线参数与 GLV 常数，不一致时抛出异常。
+// 临时数组按线程缓存，预热后标量乘法不分配堆内存。查表与点加法均不是常数时间实现。
+const EcBackend& Secp256k1Backend();
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_SECP256K1_BACKEND_H
@@ -0,0 +1,64 @@
+#ifndef RING_SIGNATURE_LIB_SHA256_MULTI_H
+#define RING_SIGNATURE_LIB_SHA256_MULTI_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ring_signature_lib {
+
+// SHA-256 多缓冲压缩：多条互相独立的消息（通道）各自从给定的链接值出发，压缩若干个 64 字节分组。
+// 运行时按 CPU 选择实现：AVX-512（16 通道）、AVX2（8 通道）、SHA-NI（两条通道交错）
+// 或可移植的标量实现，各实现的结果相同。
+// State 是本模块自有的单条消息状态：增量写入时逐个分组压缩，FinalBatch 把多条消息的剩余数据
+// 与填充放进各自的通道并行压缩。HMAC 的内外两层由 HashState::FinalToBnBatch 组装。
+class Sha256MultiBuffer {
+public:
+    enum Kernel {
+        kScalar = 0,
+        kShaNi,
+        kAvx2,
+        kAvx512,
+    };
+
+    struct Lane {
+        uint32_t* state;              // 8 个字的链接值，原地更新
+        const unsigned char* blocks;  // block_count 个连续的 64 字节分组
+        size_t block_count;
+    };
+
+    // 单条消息的 SHA-256 状态：链接值、已写入的总字节数与不满一个分组的数据。
+    // 普通结构体，按值复制即可保存中间状态（如 HMAC 已吸收填充密钥的状态），不分配内存
+    struct State {
+        uint32_t h[8];
+        uint64_t length;
+        unsigned char block[64];  // 前 length % 64 字节有效
+    };
+
+    static void Init(State& state);
+    // 增量写入，满一个分组即压缩（有 SHA-NI 时用 SHA-NI，否则用标量实现）
+    static void Update(State& state, const void* data, size_t len);
+    // 填充并输出 32 字节摘要
+    static void Final(State& state, unsigned char* out);
+    // 各状态先写入 data[i] 的 len[i] 字节再输出摘要到 out + 32 * i；剩余数据与填充
+    // 按当前选择的实现多通道并行压缩，count 不限。不分配堆内存
+    static void FinalBatch(State* const* states, const unsigned char* const* data, const size_t* len,
+                           unsigned char* out, size_t count);
+
+    // 用当前选择的实现压缩全部通道，各通道的分组数可以不同
+    static void Compress(Lane* lanes, size_t count);
+    // 用指定实现压缩（对照测试与基准测试用），CPU 不支持时抛出异常
+    static void Compress(Kernel kernel, Lane* lanes, size_t count);
+
+    // CPU 与编译器是否支持该实现
+    static bool IsSupported(Kernel kernel);
+    // 当前选择的实现：环境变量 RINGSIGN_SHA256_KERNEL（scalar、shani、avx2、avx512）指定且受支持时
+    // 使用指定实现，否则为 CPU 支持的最快实现
+    static Kernel Active();
+    static const char* Name(Kernel kernel);
+    // 每次并行处理的通道数
+    static size_t Width(Kernel kernel);
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_SHA256_MULTI_H
@@ -0,0 +1,97 @@
+#ifndef RING_SIGNATURE_LIB_SIGN_SERVICE_H
+#define RING_SIGNATURE_LIB_SIGN_SERVICE_H
+
+#include <openssl/ec.h>
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "libringsign/config_manager.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/ring_context.h"
+#include "libringsign/signer.h"
+
+namespace ring_signature_lib {
+
+// 签名结果的 JSON 表示，与 ./sign -o 写出的签名文件格式相同；digest_algorithm 为空表示原文模式
+nlohmann::json SignatureToJson(const EC_GROUP* group, const Signature& signature,
+                               const std::string& digest_algorithm);
+
+// 常驻签名服务：签名者的系统参数与密钥只加载、校验一次，环成员公钥与环上下文（含 K_i）缓存复用。
+// 供 signd 守护进程使用，Sign 与 HandleRequest 可在多个线程中并发调用。
+//
+// 请求协议（每条消息为一帧，见 network_utils.h 的 SendFrame/RecvFrame）：
+//   请求头帧 {"op": "sign", "ring": [ID...], "event": ..., "message_digest": 可选摘要算法}，
+//   随后的一帧为消息原文（摘要模式下为客户端计算的摘要）；
+//   {"op": "status"} 没有消息帧。
+//   响应帧 {"status": "ok", "signer_id": ..., "signature": {...}} 或 {"status": "error", "error": ...}。
+class SignService {
+public:
+    // 加载系统参数与签名者密钥并校验密钥，失败时抛出异常；
+    // 环成员公钥从 config_dir/<ID>_config.json 读取（ID 只允许 [A-Za-z0-9_.-] 且不含 ".."），
+    // 最多缓存 kMemberCacheCapacity 个成员公钥，配置文件修改时间变化后重新读取；
+    // 最多缓存 ring_cache_capacity 个环，环上下文使用构建时读取的成员公钥
+    SignService(const std::string& config_path, const std::string& sign_key_path,
+                const std::string& config_dir = "config", size_t ring_cache_capacity = 64);
+
+    SignService(const SignService&) = delete;
+    SignService& operator=(const SignService&) = delete;
+
+    const std::string& SignerId() const { return signer_id_; }
+    Signer& GetSigner() { return signer_; }
+
+    // 对消息签名并返回签名 JSON；ring_ids 可以包含或不包含签名者自己，顺序与重复无关
+    nlohmann::json Sign(std::string_view msg, const std::string& event, const std::vector<std::string>& ring_ids,
+                        const std::string& digest_algorithm = "");
+
+    // 处理一条请求，请求头中的 op 决定是否需要消息帧（见 NeedsPayload）；错误以响应 JSON 返回，不抛出异常
+    nlohmann::json HandleRequest(const nlohmann::json& header, std::string_view payload);
+    static bool NeedsPayload(const nlohmann::json& header);
+
+    // 在已连接的套接字上循环处理请求直到客户端关闭连接；消息帧超过 max_message_size 或连接异常时抛出异常
+    void ServeConnection(int fd, size_t max_message_size);
+
+    // 环上下文缓存统计
+    size_t RingCacheHits() const;
+    size_t RingCacheMisses() const;
+
+    static const size_t kMemberCacheCapacity = 4096;
+
+private:
+    using MemberKey = std::pair<EcPointPtr, EcPointPtr>;
+    using RingKey = std::vector<std::string>;
+
+    struct CachedMember {
+        std::shared_ptr<const MemberKey> key;
+        std::filesystem::file_time_type mtime;  // 读取时配置文件的修改时间
+    };
+
+    Signer signer_;
+    std::string signer_id_;
+    std::string config_dir_;
+    size_t ring_cache_capacity_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, CachedMember> members_;
+    // 按最近使用排序的环上下文，键为排序去重后的成员 ID 列表
+    std::list<std::pair<RingKey, std::shared_ptr<const RingContext>>> rings_;
+    std::map<RingKey, decltype(rings_)::iterator> ring_index_;
+    size_t ring_hits_;
+    size_t ring_misses_;
+    size_t requests_;
+
+    std::shared_ptr<const MemberKey> member(const std::string& id);
+    std::shared_ptr<const RingContext> ring(const std::vector<std::string>& ring_ids);
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_SIGN_SERVICE_H
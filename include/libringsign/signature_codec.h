@@ -0,0 +1,68 @@
+#ifndef RING_SIGNATURE_LIB_SIGNATURE_CODEC_H
+#define RING_SIGNATURE_LIB_SIGNATURE_CODEC_H
+
+#include <openssl/ec.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "libringsign/signer.h"
+#include "libringsign/thread_pool.h"
+
+namespace ring_signature_lib {
+
+// 紧凑的二进制签名格式（与 JSON 签名文件并存），多字节整数均为大端：
+//   头部：magic "RSIG" | u8 格式版本 | u8 transcript 版本 | u8 标志 | u8 标量宽度 | u8 点宽度 |
+//         u8 摘要算法名长度 | 摘要算法名 | u32 环大小 n
+//   主体：A_1..A_n | T（各为点宽度字节的压缩编码，无穷远点为全零）| φ | ψ（各为标量宽度字节，左侧补零）
+//   校验和（标志位 kSignatureFlagChecksum）：之前全部字节的 SHA-256 前 8 字节，只用于发现损坏，不提供认证
+// secp256k1 上标量为 32 字节、点为 33 字节，n 个成员的签名为 n * 33 + 33 + 64 字节加上头部。
+// 摘要算法名为空表示原文模式，否则为摘要模式（与 JSON 的 message_mode / message_digest 相同）。
+const uint8_t kSignatureFormatVersion = 1;
+const uint8_t kSignatureFlagChecksum = 0x01;
+const size_t kSignatureChecksumSize = 8;
+
+// 编码签名；checksum 为 true 时附加校验和
+std::string EncodeSignature(const EC_GROUP* group, const Signature& signature,
+                            const std::string& digest_algorithm = "", bool checksum = true);
+
+// 数据是否以二进制签名的 magic 开头
+bool IsBinarySignature(std::string_view data);
+
+// 二进制签名的零拷贝视图：构造时只解析头部、检查长度与校验和，各字段以视图引用原始数据
+// （可直接引用内存映射的签名文件），数据须在视图使用期间保持有效。格式错误时抛出异常。
+class SignatureView {
+public:
+    explicit SignatureView(std::string_view data);
+
+    int TranscriptVersion() const { return transcript_version_; }
+    size_t RingSize() const { return ring_size_; }
+    bool HasChecksum() const { return (flags_ & kSignatureFlagChecksum) != 0; }
+    // 摘要算法名，原文模式下为空
+    std::string_view MessageDigest() const { return digest_algorithm_; }
+    size_t PointSize() const { return point_size_; }
+    size_t ScalarSize() const { return scalar_size_; }
+
+    std::string_view A(size_t i) const { return body_.substr(i * point_size_, point_size_); }
+    std::string_view T() const { return body_.substr(ring_size_ * point_size_, point_size_); }
+    std::string_view Phi() const { return body_.substr((ring_size_ + 1) * point_size_, scalar_size_); }
+    std::string_view Psi() const { return body_.substr((ring_size_ + 1) * point_size_ + scalar_size_, scalar_size_); }
+
+    // 解码全部点与标量并验证：宽度与群一致、点在曲线上、标量小于群的阶。
+    // 点的解压缩是主要开销，共用 BN_CTX 逐个完成；pool 非空时按分块并行，每个分块使用自己的 BN_CTX。
+    // 返回的 A_i、φ、ψ、T 归调用方所有；任一字段无效时抛出异常
+    Signature Decode(const EC_GROUP* group, ThreadPool* pool = nullptr) const;
+
+private:
+    int transcript_version_;
+    uint8_t flags_;
+    size_t scalar_size_;
+    size_t point_size_;
+    size_t ring_size_;
+    std::string_view digest_algorithm_;
+    std::string_view body_;
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_SIGNATURE_CODEC_H
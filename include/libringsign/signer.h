@@ -3,11 +3,20 @@
 
 #include <openssl/ec.h>
 #include <openssl/bn.h>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include "libringsign/hash_utils.h"
 #include "libringsign/config_manager.h"
+#include "libringsign/ec_backend.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/precompute.h"
+#include "libringsign/ring_context.h"
+#include "libringsign/thread_pool.h"
+#include "libringsign/transcript.h"
 
 namespace ring_signature_lib {
 
@@ -16,9 +25,19 @@ struct Signature {
     BIGNUM* phi;               // 签名的一部分
     BIGNUM* psi;               // 签名的另一部分
     EC_POINT* T;               // 签名的点 T
+    int transcript_version;    // H_3 / H_4 输入的编码版本
 
-    Signature(std::vector<EC_POINT*> A, BIGNUM* phi, BIGNUM* psi, EC_POINT* T)
-        : A(std::move(A)), phi(phi), psi(psi), T(T) {}
+    Signature(std::vector<EC_POINT*> A, BIGNUM* phi, BIGNUM* psi, EC_POINT* T,
+              int transcript_version = TRANSCRIPT_VERSION_1)
+        : A(std::move(A)), phi(phi), psi(psi), T(T), transcript_version(transcript_version) {}
+};
+
+// 批量验证的单个输入：签名及其消息、事件与环上下文，均以引用（视图）持有，调用期间须保持有效
+struct SignatureInput {
+    const Signature& signature;
+    std::string_view msg;
+    const std::string& event;
+    const RingContext& ring;
 };
 
 class Signer {
@@ -28,6 +47,9 @@ public:
 
     // 初始化函数，传入ID和配置文件路径，加载配置并完成初始化
     void Initialize(const std::string& id, const std::string& config_path);
+    // 以另一个已初始化签名者的系统参数初始化，共享其预计算表，不再读取配置文件与构建表；
+    // 用于批量生成大量签名者的密钥
+    void Initialize(const std::string& id, const Signer& parameters);
 
     // 生成用户密钥对并向 KGC 请求部分密钥
     std::pair<std::string, EC_POINT*> GeneratePartialKey(unsigned int seed = 0);
@@ -44,49 +66,108 @@ public:
 
 
     // 获取私钥和部分私钥的接口
-    const BIGNUM* GetPrivateKey() const { return private_key_; }
-    const BIGNUM* GetPartialPrivateKey() const { return partial_private_key_; }
+    const BIGNUM* GetPrivateKey() const { return private_key_.get(); }
+    const BIGNUM* GetPartialPrivateKey() const { return partial_private_key_.get(); }
     // 获取完整的用户公钥
-    std::pair<EC_POINT*, EC_POINT*> GetPublicKey() const { return {full_public_key_[0], full_public_key_[1]}; }
-    EC_GROUP* GetGroup() const { return group_; }
+    std::pair<EC_POINT*, EC_POINT*> GetPublicKey() const { return {full_public_key_[0].get(), full_public_key_[1].get()}; }
+    EC_GROUP* GetGroup() const { return group_.get(); }
+    // 系统的哈希输入编码版本：决定 H_1 的编码以及新生成签名的版本
+    int GetTranscriptVersion() const { return transcript_version_; }
+    // 获取系统参数的固定基点预计算层（含事件表缓存命中统计）
+    PrecomputeCache* GetPrecomputeCache() const { return precompute_.get(); }
+    // 椭圆曲线运算后端，加载系统参数时按曲线选择（见 EcBackend::ForGroup），须在初始化之后调用
+    const EcBackend& GetEcBackend() const { return *backend_; }
+
+    // 设置签名与验证使用的线程数（含调用线程），0 或 1 表示单线程（默认）。
+    // 多线程时环成员按分块并行处理，各分块的部分和按分块顺序归约；
+    // 分块数随环大小自适应，成员数不足 2 * RingContext::kMinMembersPerChunk 的环仍在调用线程上执行。
+    void SetThreadCount(size_t threads);
+    size_t GetThreadCount() const { return pool_ ? pool_->Size() : 1; }
 
     // 获取所有参数的字符串表示，用于测试和比较
     std::string GetParametersAsString() const;
 
-    // 生成环签名的公开接口：用于输入验证
+    // 由环成员列表构建可复用的环上下文（排序、编码、h_i 与 K_i 只计算一次）
+    RingContext CreateRingContext(const std::vector<RingContext::Member>& members, bool combine = true) const;
+    // 由公钥目录中的成员构建环上下文：按 ID 二分查找成员并直接采用目录中的 h_i 与 K_i。
+    // 目录不是按本系统参数编译、成员不存在或重复时抛出异常
+    RingContext CreateRingContext(const Keystore& keystore, const std::vector<std::string>& ids,
+                                  bool combine = true) const;
+
+    // 系统参数指纹：h_i 与 K_i 所依赖的曲线、transcript 版本、P_pub 与 H_1 的 SHA-256，
+    // 用于识别按其他系统参数编译的公钥目录
+    std::string SystemFingerprint() const;
+
+    // 生成环签名的公开接口：用于输入验证。签名使用系统的 transcript 版本。
+    // 返回的 A_i、φ、ψ、T 归调用方所有；签名过程中的临时对象从线程局部的 ScopedArena 借出，
+    // 使用预先构建的环上下文且单线程时，预热后除返回值外不再分配堆内存
     Signature Sign(
-        const std::string& msg, const std::string& event,
-        std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> other_signer_pkc);
+        std::string_view msg, const std::string& event,
+        const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& other_signer_pkc);
+
+    // 使用预先构建的环上下文生成环签名，环中必须包含 signer 自己
+    Signature Sign(std::string_view msg, const std::string& event, const RingContext& ring);
+
+    // 验证环签名的公开接口，transcript_version 为签名的 H_3 / H_4 编码版本（旧签名为 v1）。
+    // 环成员含重复 ID 时返回 false，不抛出异常
+    bool Verify(
+        const std::vector<EC_POINT*>& A,
+        BIGNUM* phi,
+        BIGNUM* psi,
+        EC_POINT* T,
+        std::string_view msg,
+        const std::string& event,
+        const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& ring_pubkeys,
+        int transcript_version = TRANSCRIPT_VERSION_1);
 
-    // 验证环签名的公开接口
+    // 使用预先构建的环上下文验证环签名
     bool Verify(
         const std::vector<EC_POINT*>& A,
         BIGNUM* phi,
         BIGNUM* psi,
         EC_POINT* T,
-        const std::string& msg,
+        std::string_view msg,
         const std::string& event,
-        std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> ring_pubkeys);
+        const RingContext& ring,
+        int transcript_version = TRANSCRIPT_VERSION_1);
 
+    // 验证 Signature 结构体，编码版本取自签名
+    bool Verify(
+        const Signature& signature, std::string_view msg, const std::string& event,
+        const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& ring_pubkeys);
+    bool Verify(const Signature& signature, std::string_view msg, const std::string& event, const RingContext& ring);
 
+    // 批量验证多个环签名：以随机小指数 w_j 对各签名的验证方程加权求和，合并为一次多标量乘法；
+    // 合并检查失败时二分定位无效签名。使用同一 RingContext 对象或同一事件的签名共享基点。
+    // 返回与输入顺序一致的验证结果。
+    std::vector<bool> VerifyBatch(const SignatureInput* inputs, size_t count);
+    std::vector<bool> VerifyBatch(const std::vector<SignatureInput>& inputs);
 
+    // 批量验证中随机权重的位数，单个无效签名通过合并检查的概率约为 2^-kBatchWeightBits
+    static const int kBatchWeightBits = 128;
 
 private:
     std::string id_;                        // 用户ID
-    BIGNUM* private_key_;                   // 用户的私钥 x_i
-    EC_POINT* full_public_key_[2];          // 用户的完整公钥，包含 X_i 和 Y_i
-    BIGNUM* partial_private_key_;           // 用户的部分私钥 z_i
-    BIGNUM* id_hash_;                       // ID绑定的哈希值 H_1(ID_i || X_i || P_pub)
-    EC_POINT* system_public_key_;           // 系统公钥 P_pub
-    EC_GROUP* group_;                       // 椭圆曲线群
+    EcGroupPtr group_;                      // 椭圆曲线群
+    BnPtr private_key_;                     // 用户的私钥 x_i
+    EcPointPtr full_public_key_[2];         // 用户的完整公钥，包含 X_i 和 Y_i
+    BnPtr partial_private_key_;             // 用户的部分私钥 z_i
+    BnPtr id_hash_;                         // ID绑定的哈希值 H_1(ID_i || X_i || P_pub)
+    EcPointPtr system_public_key_;          // 系统公钥 P_pub
     std::vector<HashUtils> hash_;                // 哈希函数列表
     int curve_nid_;                         // 椭圆曲线的 NID
     std::string hash_type_;                 // 哈希类型
+    int transcript_version_;                // 系统的哈希输入编码版本
+    const EcBackend* backend_;              // 标量乘法与多标量乘法的后端
+    std::shared_ptr<PrecomputeCache> precompute_;  // G、P_pub 及事件点的预计算表
+    std::shared_ptr<ThreadPool> pool_;      // 并行签名的线程池，单线程时为空
 
     bool is_initialized_;                   // 标识是否已初始化
     bool is_partial_key_generated_;         // 标识是否生成了部分密钥
     bool is_full_key_generated_;            // 标识是否生成了完整密钥
 
+    struct BatchItem;                       // 批量验证中单个签名的预处理结果
+
     void initialize_id(const std::string& id);
     void load_config(const std::string& path);
     void generate_partial_key(unsigned int seed);
@@ -94,11 +175,13 @@ private:
     bool verify_key(const EC_POINT* partial_system_public_key, const BIGNUM* partial_private_key) const;
     void save_key(const std::string& sign_key_path);
     void load_key(const std::string& sign_key_path);
+    // 计算 h_i = H_1(ID_i || X_i || P_pub)
+    BIGNUM* compute_id_hash(BN_CTX* ctx) const;
 
     // 私有的签名生成函数：实现具体签名生成逻辑
     std::tuple<std::vector<EC_POINT*>, BIGNUM*, BIGNUM*, EC_POINT*> sign(
-        const std::string& msg, const std::string& event,
-        const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& L, int signer_index);
+        std::string_view msg, const std::string& event,
+        const RingContext& L, int signer_index);
 
     // 验证函数声明
     bool verify(
@@ -106,9 +189,28 @@ private:
         BIGNUM* phi,
         BIGNUM* psi,
         EC_POINT* T,
-        const std::string& msg,
+        std::string_view msg,
         const std::string& event,
-        const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& L);
+        const RingContext& L,
+        int transcript_version);
+
+    // 写入 H_3 的公共前缀 msg || event，各成员的 a_i 由该中间状态复制后继续计算
+    Transcript member_hash_prefix(int transcript_version, std::string_view msg, const std::string& event) const;
+    // 计算 a_i = H_3(msg || event || ID_i || X_i || Y_i || A_i) 写入 out，prefix 为 member_hash_prefix 的结果，
+    // 环成员编码取自环上下文
+    void member_hash(BIGNUM* out, const Transcript& prefix, const RingContext::Entry& member,
+                     const EC_POINT* A_i, BN_CTX* ctx) const;
+    // 对 [begin, end) 中除 skip 以外的成员依次计算 a_i 写入 out（skip 为 -1 时不跳过），
+    // 每 HashState::kBatchSize 个成员一组由多缓冲 SHA-256 并行输出
+    void member_hash_batch(BIGNUM* const* out, const Transcript& prefix, const RingContext& L,
+                           const EC_POINT* const* A, size_t begin, size_t end, int skip, BN_CTX* ctx) const;
+
+    // 对 items 中 indices 指定的签名做一次加权合并检查
+    bool verify_batch_subset(const std::vector<std::unique_ptr<BatchItem>>& items,
+                             const std::vector<size_t>& indices);
+    // 二分定位无效签名；known_bad 表示该子集已知包含无效签名，可跳过整体检查
+    void verify_batch_bisect(const std::vector<std::unique_ptr<BatchItem>>& items,
+                             const std::vector<size_t>& indices, bool known_bad, std::vector<bool>& results);
 };
 
 } // namespace ring_signature_lib
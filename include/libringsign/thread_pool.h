@@ -0,0 +1,52 @@
+#ifndef RING_SIGNATURE_LIB_THREAD_POOL_H
+#define RING_SIGNATURE_LIB_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ring_signature_lib {
+
+// 库内部使用的固定大小线程池。
+// ParallelFor 将区间划分为连续分块，调用线程也参与执行，因此在工作线程内嵌套调用不会死锁。
+class ThreadPool {
+public:
+    // threads 为总并发数（含调用线程），至少为 1；为 1 时不创建工作线程
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t Size() const { return workers_.size() + 1; }
+
+    // count 个元素划分出的分块数：每块至少 min_chunk_size 个元素，且不超过 Size()，至少为 1（count 为 0 时为 0）。
+    // 元素较少时只划分出一个分块，直接在调用线程上执行。
+    size_t ChunkCount(size_t count, size_t min_chunk_size = 1) const;
+
+    // 将 [0, count) 均分为 ChunkCount(count, min_chunk_size) 个连续分块并行执行 fn(chunk, begin, end)，
+    // 阻塞至全部完成。分块编号与区间只由参数和 Size() 决定，调用方可按分块编号顺序做确定性归约。
+    // 任一分块抛出的异常会在全部分块结束后于调用线程重新抛出。
+    void ParallelFor(size_t count, const std::function<void(size_t chunk, size_t begin, size_t end)>& fn,
+                     size_t min_chunk_size = 1);
+
+    // 默认线程数：硬件并发数，无法获取时为 1
+    static size_t DefaultThreadCount();
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_;
+
+    void worker_loop();
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_THREAD_POOL_H
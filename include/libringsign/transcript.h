@@ -0,0 +1,65 @@
+#ifndef RING_SIGNATURE_LIB_TRANSCRIPT_H
+#define RING_SIGNATURE_LIB_TRANSCRIPT_H
+
+#include <openssl/ec.h>
+#include <openssl/bn.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "libringsign/hash_utils.h"
+
+namespace ring_signature_lib {
+
+// 哈希输入（transcript）的编码版本
+// v1：各字段直接拼接，点使用非压缩格式的十六进制字符串
+// v2：各字段以 4 字节大端长度为前缀，点使用压缩格式的二进制编码
+const int TRANSCRIPT_VERSION_1 = 1;
+const int TRANSCRIPT_VERSION_2 = 2;
+
+// 点在两种 transcript 版本下的编码，可在环上下文中缓存
+struct PointEncoding {
+    std::string hex;         // v1：非压缩格式的十六进制字符串（与 EC_POINT_point2hex 相同）
+    std::string compressed;  // v2：压缩格式的二进制编码
+
+    // 对点做一次非压缩编码，再由其派生两种编码
+    static PointEncoding Encode(const EC_GROUP* group, const EC_POINT* point, BN_CTX* ctx);
+};
+
+// 按指定版本把各字段直接写入哈希状态，不再拼接中间字符串。
+// 可复制：复制后的 transcript 从当前已写入的前缀继续。
+class Transcript {
+public:
+    // 版本不受支持时抛出异常
+    Transcript(const HashUtils& hash, int version);
+
+    // 写入字节串（消息、事件、ID 等），可直接引用内存映射的文件内容
+    void AppendString(std::string_view data);
+    // 写入点，按版本选择编码
+    void AppendPoint(const EC_GROUP* group, const EC_POINT* point, BN_CTX* ctx);
+    // 写入已缓存编码的点
+    void AppendPoint(const PointEncoding& encoding);
+
+    // 输出哈希值（BIGNUM），之后不可再写入
+    BIGNUM* FinalToBn() { return state_.FinalToBn(); }
+    // 输出哈希值写入已有的 BIGNUM
+    void FinalToBn(BIGNUM* out) { state_.FinalToBn(out); }
+    // 批量输出：transcripts[i] 的哈希值写入 out[i]，见 HashState::FinalToBnBatch
+    static void FinalToBnBatch(Transcript* const* transcripts, BIGNUM* const* out, size_t count);
+
+    int GetVersion() const { return version_; }
+
+    // 版本号是否受支持
+    static bool IsSupported(int version) {
+        return version == TRANSCRIPT_VERSION_1 || version == TRANSCRIPT_VERSION_2;
+    }
+
+private:
+    HashState state_;
+    int version_;
+
+    void append_length(size_t len);
+};
+
+} // namespace ring_signature_lib
+
+#endif // RING_SIGNATURE_LIB_TRANSCRIPT_H
@@ -0,0 +1,148 @@
+#include "libringsign/bulk_enrollment.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+namespace {
+
+const char kRequestMagic[kBulkMagicSize] = {'R', 'S', 'B', 'Q'};
+const char kResponseMagic[kBulkMagicSize] = {'R', 'S', 'B', 'P'};
+
+void put_u8(std::string& out, size_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+void put_u16(std::string& out, size_t value) {
+    if (value > 0xFFFF) throw std::length_error("Bulk enrollment field too long");
+    out.push_back(static_cast<char>(value >> 8));
+    out.push_back(static_cast<char>(value));
+}
+
+void put_u32(std::string& out, size_t value) {
+    if (value > 0xFFFFFFFFu) throw std::length_error("Too many bulk enrollment entries");
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<char>(value >> shift));
+}
+
+void put_bytes8(std::string& out, const std::string& data) {
+    if (data.size() > 0xFF) throw std::length_error("Bulk enrollment field too long");
+    put_u8(out, data.size());
+    out += data;
+}
+
+void put_bytes16(std::string& out, const std::string& data) {
+    put_u16(out, data.size());
+    out += data;
+}
+
+// 按顺序读取字段，越界时抛出异常
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data), pos_(0) {}
+
+    const unsigned char* take(size_t n) {
+        if (data_.size() - pos_ < n) throw std::runtime_error("Truncated bulk enrollment message");
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data_.data() + pos_);
+        pos_ += n;
+        return p;
+    }
+    size_t u8() { return take(1)[0]; }
+    size_t u16() {
+        const unsigned char* p = take(2);
+        return (static_cast<size_t>(p[0]) << 8) | p[1];
+    }
+    size_t u32() {
+        const unsigned char* p = take(4);
+        return (static_cast<size_t>(p[0]) << 24) | (static_cast<size_t>(p[1]) << 16) |
+               (static_cast<size_t>(p[2]) << 8) | p[3];
+    }
+    std::string bytes(size_t n) { return std::string(reinterpret_cast<const char*>(take(n)), n); }
+    size_t remaining() const { return data_.size() - pos_; }
+
+private:
+    std::string_view data_;
+    size_t pos_;
+};
+
+void read_header(Reader& reader, const char* magic) {
+    if (std::memcmp(reader.take(kBulkMagicSize), magic, kBulkMagicSize) != 0) {
+        throw std::runtime_error("Not a bulk enrollment message");
+    }
+    if (reader.u8() != kBulkFormatVersion) {
+        throw std::runtime_error("Unsupported bulk enrollment format version");
+    }
+}
+
+} // namespace
+
+bool IsBulkRequest(std::string_view frame) {
+    return frame.size() >= kBulkMagicSize && std::memcmp(frame.data(), kRequestMagic, kBulkMagicSize) == 0;
+}
+
+std::string EncodeBulkRequest(const std::vector<BulkEnrollmentRequest>& requests) {
+    std::string out(kRequestMagic, kBulkMagicSize);
+    put_u8(out, kBulkFormatVersion);
+    put_u32(out, requests.size());
+    for (const auto& request : requests) {
+        put_bytes16(out, request.id);
+        put_bytes8(out, request.partial_pub);
+    }
+    return out;
+}
+
+std::vector<BulkEnrollmentRequest> DecodeBulkRequest(std::string_view frame) {
+    Reader reader(frame);
+    read_header(reader, kRequestMagic);
+    size_t count = reader.u32();
+    // 每个条目至少 3 字节，条目数不可信时避免按其预留过多内存
+    if (count > reader.remaining() / 3) throw std::runtime_error("Truncated bulk enrollment message");
+
+    std::vector<BulkEnrollmentRequest> requests(count);
+    for (auto& request : requests) {
+        request.id = reader.bytes(reader.u16());
+        request.partial_pub = reader.bytes(reader.u8());
+    }
+    if (reader.remaining() != 0) throw std::runtime_error("Trailing bytes in bulk enrollment message");
+    return requests;
+}
+
+std::string EncodeBulkResponse(const std::vector<BulkEnrollmentResult>& results, bool update_config) {
+    std::string out(kResponseMagic, kBulkMagicSize);
+    put_u8(out, kBulkFormatVersion);
+    put_u8(out, update_config ? 1 : 0);
+    put_u32(out, results.size());
+    for (const auto& result : results) {
+        put_u8(out, result.ok ? 1 : 0);
+        if (result.ok) {
+            put_bytes8(out, result.partial_system_pub);
+            put_bytes16(out, result.partial_priv);
+        } else {
+            put_bytes16(out, result.error.substr(0, 0xFFFF));
+        }
+    }
+    return out;
+}
+
+std::vector<BulkEnrollmentResult> DecodeBulkResponse(std::string_view frame, bool* update_config) {
+    Reader reader(frame);
+    read_header(reader, kResponseMagic);
+    bool update = reader.u8() != 0;
+    size_t count = reader.u32();
+    if (count > reader.remaining() / 3) throw std::runtime_error("Truncated bulk enrollment message");
+
+    std::vector<BulkEnrollmentResult> results(count);
+    for (auto& result : results) {
+        result.ok = reader.u8() != 0;
+        if (result.ok) {
+            result.partial_system_pub = reader.bytes(reader.u8());
+            result.partial_priv = reader.bytes(reader.u16());
+        } else {
+            result.error = reader.bytes(reader.u16());
+        }
+    }
+    if (reader.remaining() != 0) throw std::runtime_error("Trailing bytes in bulk enrollment message");
+    if (update_config) *update_config = update;
+    return results;
+}
+
+} // namespace ring_signature_lib
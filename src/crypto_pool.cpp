@@ -0,0 +1,384 @@
+// EC_GROUP_method_of 在 OpenSSL 3.0 中标记为弃用，但仍是判断点与群是否兼容的唯一公开接口；
+// EC_POINT_get/set_Jprojective_coordinates_GFp 同样弃用，但仍是读写射影坐标的唯一公开接口
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include "libringsign/crypto_pool.h"
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace ring_signature_lib {
+
+struct ScopedArena::BnStack {
+    std::vector<BIGNUM*> items;  // [0, top) 已借出，[top, size) 空闲且值为 0
+    size_t top = 0;
+
+    ~BnStack() {
+        for (auto* bn : items) BN_clear_free(bn);
+    }
+};
+
+struct ScopedArena::PointStack {
+    const EC_METHOD* method;
+    int curve_nid;
+    std::vector<EC_POINT*> items;  // [0, top) 已借出
+    size_t top = 0;
+    // MakeAffine 求逆用的域 Montgomery 上下文与指数 p - 2，首次使用时创建
+    BN_MONT_CTX* field_mont = nullptr;
+    BIGNUM* field_exponent = nullptr;
+
+    PointStack(const EC_METHOD* method, int curve_nid) : method(method), curve_nid(curve_nid) {}
+    ~PointStack() {
+        for (auto* point : items) EC_POINT_free(point);
+        BN_MONT_CTX_free(field_mont);
+        BN_free(field_exponent);
+    }
+};
+
+template <typename T>
+struct ListStack {
+    std::vector<std::unique_ptr<std::vector<T>>> lists;  // [0, top) 已借出
+    size_t top = 0;
+
+    std::vector<T>& Borrow() {
+        if (top == lists.size()) {
+            lists.emplace_back(new std::vector<T>());
+        }
+        std::vector<T>& list = *lists[top++];
+        list.clear();
+        return list;
+    }
+};
+
+// List<T>() 支持的每种元素类型各一个栈
+struct ScopedArena::ListStacks {
+    ListStack<EC_POINT*> points;
+    ListStack<const EC_POINT*> const_points;
+    ListStack<BIGNUM*> bns;
+    ListStack<const BIGNUM*> const_bns;
+    ListStack<unsigned char> bytes;
+
+    size_t* tops[kListKinds] = {&points.top, &const_points.top, &bns.top, &const_bns.top, &bytes.top};
+
+    template <typename T> ListStack<T>& get();
+};
+
+template <> ListStack<EC_POINT*>& ScopedArena::ListStacks::get<EC_POINT*>() { return points; }
+template <> ListStack<const EC_POINT*>& ScopedArena::ListStacks::get<const EC_POINT*>() { return const_points; }
+template <> ListStack<BIGNUM*>& ScopedArena::ListStacks::get<BIGNUM*>() { return bns; }
+template <> ListStack<const BIGNUM*>& ScopedArena::ListStacks::get<const BIGNUM*>() { return const_bns; }
+template <> ListStack<unsigned char>& ScopedArena::ListStacks::get<unsigned char>() { return bytes; }
+
+namespace {
+
+// RandRange 支持的范围最大字节数
+const size_t kMaxRandBytes = 128;
+
+struct ThreadState {
+    EVP_MAC* mac = nullptr;
+    std::unordered_map<std::string, EVP_MAC_CTX*> hmacs;  // 键为 "摘要名\0密钥"
+    std::vector<BN_CTX*> idle_bn_ctxs;
+
+    // ScopedArena 使用的栈
+    ScopedArena::BnStack bns;
+    std::vector<std::unique_ptr<ScopedArena::PointStack>> point_stacks;  // 每种曲线一个
+    ScopedArena::ListStacks lists;
+
+    ~ThreadState() {
+        clear_hmacs();
+        EVP_MAC_free(mac);
+        for (auto* ctx : idle_bn_ctxs) BN_CTX_free(ctx);
+    }
+
+    ScopedArena::PointStack* point_stack(const EC_GROUP* group) {
+        const EC_METHOD* method = EC_GROUP_method_of(group);
+        int curve_nid = EC_GROUP_get_curve_name(group);
+        for (auto& stack : point_stacks) {
+            if (stack->method == method && stack->curve_nid == curve_nid) return stack.get();
+        }
+        point_stacks.emplace_back(new ScopedArena::PointStack(method, curve_nid));
+        return point_stacks.back().get();
+    }
+
+    void clear_hmacs() {
+        for (auto& entry : hmacs) EVP_MAC_CTX_free(entry.second);
+        hmacs.clear();
+    }
+};
+
+ThreadState& thread_state() {
+    thread_local ThreadState state;
+    return state;
+}
+
+// 按费马小定理 r = a^(p - 2) mod p 求域逆元。BN_mod_inverse 的欧几里得迭代偶尔走到 BN_div
+// 的长商分支，使 BN_CTX 中的临时对象扩容；幂运算的临时对象大小固定，预热后不再分配
+void field_inverse(const EC_GROUP* group, BIGNUM* r, const BIGNUM* a, BN_CTX* ctx) {
+    ScopedArena::PointStack* stack = thread_state().point_stack(group);
+    const BIGNUM* p = EC_GROUP_get0_field(group);
+    if (!stack->field_mont) {
+        BN_MONT_CTX* mont = BN_MONT_CTX_new();
+        BIGNUM* exponent = BN_dup(p);
+        if (!mont || !exponent || !BN_MONT_CTX_set(mont, p, ctx) || !BN_sub_word(exponent, 2)) {
+            BN_MONT_CTX_free(mont);
+            BN_free(exponent);
+            throw std::runtime_error("Failed to prepare field inversion");
+        }
+        stack->field_mont = mont;
+        stack->field_exponent = exponent;
+    }
+    if (!BN_mod_exp_mont(r, a, stack->field_exponent, p, ctx, stack->field_mont)) {
+        throw std::runtime_error("Failed to normalize points");
+    }
+}
+
+// 点加法的次数，用于预先扩容新点的坐标
+const int kPresizePointAdds = 16;
+
+// 预先扩容新点的坐标。ec_GFp_simple_add 以 BN_rshift1 把 (n + p) / 2 写入结果的 Y 坐标，
+// n 为奇数时被除数比域多一个字，坐标随之扩容，是否扩容取决于数据；点复用时保留容量。
+// 坐标不能直接设置为更长的值（写入时先按域约简），这里在新点上依次计算 G, 2G, 3G, ...，
+// 固定序列中的奇数情形使坐标扩容，之后的运算不再因数据不同而分配
+void presize_point(const EC_GROUP* group, EC_POINT* point) {
+    const EC_POINT* generator = EC_GROUP_get0_generator(group);
+    if (!generator) return;
+    ScopedBnCtx scoped_ctx;
+    if (!EC_POINT_copy(point, generator)) {
+        throw std::runtime_error("Failed to allocate EC point");
+    }
+    for (int i = 0; i < kPresizePointAdds; ++i) {
+        if (!EC_POINT_add(group, point, point, generator, scoped_ctx.get())) {
+            throw std::runtime_error("Failed to allocate EC point");
+        }
+    }
+}
+
+} // namespace
+
+const EVP_MAC_CTX* CryptoContextPool::KeyedHmac(const EVP_MD* md, const std::string& key) {
+    ThreadState& state = thread_state();
+    const char* digest = EVP_MD_get0_name(md);
+    std::string cache_key(digest);
+    cache_key.push_back('\0');
+    cache_key += key;
+
+    auto it = state.hmacs.find(cache_key);
+    if (it != state.hmacs.end()) {
+        return it->second;
+    }
+
+    if (!state.mac) {
+        state.mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+        if (!state.mac) {
+            throw std::runtime_error("Failed to fetch HMAC");
+        }
+    }
+
+    EVP_MAC_CTX* ctx = EVP_MAC_CTX_new(state.mac);
+    if (!ctx) {
+        throw std::runtime_error("Failed to create HMAC context");
+    }
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>(digest), 0),
+        OSSL_PARAM_END
+    };
+    if (!EVP_MAC_init(ctx, reinterpret_cast<const unsigned char*>(key.data()), key.size(), params)) {
+        EVP_MAC_CTX_free(ctx);
+        throw std::runtime_error("Failed to initialize HMAC context");
+    }
+
+    if (state.hmacs.size() >= kMaxKeyedHmacs) {
+        state.clear_hmacs();
+    }
+    state.hmacs.emplace(std::move(cache_key), ctx);
+    return ctx;
+}
+
+BN_CTX* CryptoContextPool::AcquireBnCtx() {
+    ThreadState& state = thread_state();
+    if (!state.idle_bn_ctxs.empty()) {
+        BN_CTX* ctx = state.idle_bn_ctxs.back();
+        state.idle_bn_ctxs.pop_back();
+        return ctx;
+    }
+    BN_CTX* ctx = BN_CTX_new();
+    if (!ctx) {
+        throw std::runtime_error("Failed to allocate BN_CTX");
+    }
+    return ctx;
+}
+
+void CryptoContextPool::ReleaseBnCtx(BN_CTX* ctx) {
+    if (!ctx) return;
+    ThreadState& state = thread_state();
+    if (state.idle_bn_ctxs.size() >= kMaxIdleBnCtxs) {
+        BN_CTX_free(ctx);
+        return;
+    }
+    state.idle_bn_ctxs.push_back(ctx);
+}
+
+void RandRange(BIGNUM* r, const BIGNUM* range) {
+    int bits = BN_num_bits(range);
+    int len = (bits + 7) / 8;
+    unsigned char bytes[kMaxRandBytes];
+    if (BN_is_zero(range) || BN_is_negative(range) || len > static_cast<int>(sizeof(bytes))) {
+        throw std::invalid_argument("Unsupported random range");
+    }
+    // 取 bits 位随机数，落在范围外时重新生成，期望次数小于 2
+    unsigned char top_mask = static_cast<unsigned char>(0xff >> (8 * len - bits));
+    bool ok = false;
+    do {
+        if (RAND_priv_bytes(bytes, len) <= 0) break;
+        bytes[0] &= top_mask;
+        if (!BN_bin2bn(bytes, len, r)) break;
+        ok = BN_cmp(r, range) < 0;
+    } while (!ok);
+    OPENSSL_cleanse(bytes, sizeof(bytes));
+    if (!ok) {
+        throw std::runtime_error("Failed to generate random number");
+    }
+}
+
+ScopedArena::ScopedArena(const EC_GROUP* group) : group_(group) {
+    ThreadState& state = thread_state();
+    bns_ = &state.bns;
+    points_ = state.point_stack(group);
+    lists_ = &state.lists;
+    bn_mark_ = bns_->top;
+    point_mark_ = points_->top;
+    for (size_t i = 0; i < kListKinds; ++i) {
+        list_marks_[i] = *lists_->tops[i];
+    }
+}
+
+ScopedArena::~ScopedArena() {
+    // 借出的 BIGNUM 可能保存随机数或私钥相关的中间值，归还前清零
+    for (size_t i = bn_mark_; i < bns_->top; ++i) {
+        BN_clear(bns_->items[i]);
+    }
+    bns_->top = bn_mark_;
+    points_->top = point_mark_;
+    for (size_t i = 0; i < kListKinds; ++i) {
+        *lists_->tops[i] = list_marks_[i];
+    }
+
+    // 最外层作用域结束时释放超出上限的空闲对象，避免一次超大环之后长期占用内存
+    if (bn_mark_ == 0) {
+        while (bns_->items.size() > kMaxIdleObjects) {
+            BN_clear_free(bns_->items.back());
+            bns_->items.pop_back();
+        }
+    }
+    if (point_mark_ == 0) {
+        while (points_->items.size() > kMaxIdleObjects) {
+            EC_POINT_free(points_->items.back());
+            points_->items.pop_back();
+        }
+    }
+}
+
+BIGNUM* ScopedArena::Bn() {
+    if (bns_->top == bns_->items.size()) {
+        BIGNUM* bn = BN_new();
+        if (!bn) {
+            throw std::runtime_error("Failed to allocate BIGNUM");
+        }
+        try {
+            bns_->items.push_back(bn);
+        } catch (...) {
+            BN_free(bn);
+            throw;
+        }
+    }
+    return bns_->items[bns_->top++];
+}
+
+EC_POINT* ScopedArena::Point() {
+    if (points_->top == points_->items.size()) {
+        EC_POINT* point = EC_POINT_new(group_);
+        if (!point) {
+            throw std::runtime_error("Failed to allocate EC point");
+        }
+        try {
+            presize_point(group_, point);
+            points_->items.push_back(point);
+        } catch (...) {
+            EC_POINT_free(point);
+            throw;
+        }
+    }
+    EC_POINT* point = points_->items[points_->top];
+    if (!EC_POINT_set_to_infinity(group_, point)) {
+        throw std::runtime_error("Failed to reset EC point");
+    }
+    ++points_->top;
+    return point;
+}
+
+template <typename T>
+std::vector<T>& ScopedArena::List() {
+    return lists_->get<T>().Borrow();
+}
+
+template std::vector<EC_POINT*>& ScopedArena::List<EC_POINT*>();
+template std::vector<const EC_POINT*>& ScopedArena::List<const EC_POINT*>();
+template std::vector<BIGNUM*>& ScopedArena::List<BIGNUM*>();
+template std::vector<const BIGNUM*>& ScopedArena::List<const BIGNUM*>();
+template std::vector<unsigned char>& ScopedArena::List<unsigned char>();
+
+void MakeAffine(const EC_GROUP* group, EC_POINT* const* points, size_t count, BN_CTX* ctx) {
+    ScopedArena arena(group);
+    const BIGNUM* p = EC_GROUP_get0_field(group);
+    BIGNUM* x = arena.Bn();
+    BIGNUM* y = arena.Bn();
+    BIGNUM* z = arena.Bn();
+    BIGNUM* inv = arena.Bn();
+    BIGNUM* z_inv = arena.Bn();
+    BIGNUM* one = arena.Bn();
+    BN_one(one);
+
+    // Jacobian 坐标 (X, Y, Z) 对应仿射坐标 (X / Z^2, Y / Z^3)。
+    // 前向累乘 prefix_k = Z_1 ... Z_k，对最终乘积求逆一次，再反向逐个剥离出 1 / Z_k
+    std::vector<EC_POINT*>& finite = arena.List<EC_POINT*>();
+    std::vector<BIGNUM*>& prefix = arena.List<BIGNUM*>();
+    finite.reserve(count);
+    prefix.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (EC_POINT_is_at_infinity(group, points[i])) continue;
+        if (!EC_POINT_get_Jprojective_coordinates_GFp(group, points[i], nullptr, nullptr, z, ctx)) {
+            throw std::runtime_error("Failed to read projective coordinates");
+        }
+        BIGNUM* product = arena.Bn();
+        if (prefix.empty() ? !BN_copy(product, z) : !BN_mod_mul(product, prefix.back(), z, p, ctx)) {
+            throw std::runtime_error("Failed to normalize points");
+        }
+        finite.push_back(points[i]);
+        prefix.push_back(product);
+    }
+    if (finite.empty()) return;
+    field_inverse(group, inv, prefix.back(), ctx);
+
+    for (size_t k = finite.size(); k-- > 0;) {
+        EC_POINT* point = finite[k];
+        if (!EC_POINT_get_Jprojective_coordinates_GFp(group, point, x, y, z, ctx)) {
+            throw std::runtime_error("Failed to read projective coordinates");
+        }
+        // 1 / Z_k = (1 / prefix_k) * prefix_{k-1}，随后 1 / prefix_{k-1} = (1 / prefix_k) * Z_k
+        bool ok = k > 0 ? BN_mod_mul(z_inv, inv, prefix[k - 1], p, ctx) && BN_mod_mul(inv, inv, z, p, ctx)
+                        : BN_copy(z_inv, inv) != nullptr;
+        // x = X / Z^2，y = Y / Z^3
+        ok = ok && BN_mod_sqr(z, z_inv, p, ctx) && BN_mod_mul(x, x, z, p, ctx) &&
+             BN_mod_mul(z, z, z_inv, p, ctx) && BN_mod_mul(y, y, z, p, ctx) &&
+             EC_POINT_set_Jprojective_coordinates_GFp(group, point, x, y, one, ctx);
+        if (!ok) {
+            throw std::runtime_error("Failed to normalize points");
+        }
+    }
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,78 @@
+#include "libringsign/ec_backend.h"
+#include "libringsign/multi_scalar_mul.h"
+#include "libringsign/precompute.h"
+#include "libringsign/secp256k1_backend.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+namespace {
+
+class OpenSslBackend : public EcBackend {
+public:
+    const char* Name() const override { return "openssl"; }
+
+    void Mul(const EC_GROUP* group, EC_POINT* r, const EC_POINT* point, const BIGNUM* k,
+             BN_CTX* ctx) const override {
+        if (!EC_POINT_mul(group, r, nullptr, point, k, ctx)) {
+            throw std::runtime_error("Point multiplication failed");
+        }
+    }
+
+    void MultiMul(const EC_GROUP* group, EC_POINT* r, const std::vector<const EC_POINT*>& points,
+                  const std::vector<const BIGNUM*>& scalars, BN_CTX* ctx) const override {
+        MultiScalarMul::Compute(group, r, points, scalars, ctx);
+    }
+
+    std::unique_ptr<FixedBase> NewFixedBase(const EC_GROUP* group, const EC_POINT* base,
+                                            int teeth) const override {
+        return std::unique_ptr<FixedBase>(new FixedBaseTable(group, base, teeth));
+    }
+};
+
+// 默认启用原生后端，环境变量 RINGSIGN_EC_BACKEND=openssl 时禁用
+bool native_enabled_by_default() {
+    const char* value = std::getenv("RINGSIGN_EC_BACKEND");
+    return !value || std::strcmp(value, "openssl") != 0;
+}
+
+std::atomic<bool>& native_enabled() {
+    static std::atomic<bool> enabled(native_enabled_by_default());
+    return enabled;
+}
+
+} // namespace
+
+const EcBackend& EcBackend::OpenSsl() {
+    static const OpenSslBackend backend;
+    return backend;
+}
+
+const EcBackend* EcBackend::Native(int curve_nid) {
+    if (curve_nid == NID_secp256k1) {
+        return &Secp256k1Backend();
+    }
+    return nullptr;
+}
+
+const EcBackend& EcBackend::ForGroup(const EC_GROUP* group) {
+    if (NativeEnabled()) {
+        if (const EcBackend* native = Native(EC_GROUP_get_curve_name(group))) {
+            return *native;
+        }
+    }
+    return OpenSsl();
+}
+
+void EcBackend::SetNativeEnabled(bool enabled) {
+    native_enabled().store(enabled);
+}
+
+bool EcBackend::NativeEnabled() {
+    return native_enabled().load();
+}
+
+} // namespace ring_signature_lib
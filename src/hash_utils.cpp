@@ -1,51 +1,263 @@
+// MD5_*、SHA512_* 低层接口在 OpenSSL 3.0 中标记为弃用，但其上下文是普通结构体，
+// 可按值复制而不分配内存，EVP 接口的复制总会分配新的上下文；SHA256 使用 Sha256MultiBuffer
+// 自有的状态，以便批量输出时直接作为多通道压缩的输入。低层实现不经过 provider，
+// 只在未启用 FIPS 且摘要由 default provider 提供时使用，其余情况走 EVP_MAC
+#define OPENSSL_SUPPRESS_DEPRECATED
 #include "libringsign/hash_utils.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/sha256_multi.h"
 #include <openssl/evp.h>
 #include <openssl/core_names.h>
 #include <openssl/macros.h>
+#include <openssl/md5.h>
 #include <openssl/params.h>
+#include <openssl/provider.h>
 #include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
 #include <stdexcept>
 
 namespace ring_signature_lib {
 
-HashUtils::HashUtils(const std::string& key, const std::string& type) : hash_key_(key), hash_type_(type) {
+namespace {
+
+// 低层摘要接口，下标为 digest_kind_（0 表示走 EVP_MAC 路径）
+struct DigestOps {
+    size_t block_size;
+    int (*init)(void* state);
+    int (*update)(void* state, const void* data, size_t len);
+    int (*final)(unsigned char* out, void* state);
+    size_t digest_size;
+};
+
+const int kDigestEvp = 0;
+const int kDigestMd5 = 1;
+const int kDigestSha256 = 2;
+const int kDigestSha512 = 3;
+
+const DigestOps kDigestOps[] = {
+    {0, nullptr, nullptr, nullptr, 0},
+    {MD5_CBLOCK,
+     [](void* s) { return MD5_Init(static_cast<MD5_CTX*>(s)); },
+     [](void* s, const void* d, size_t n) { return MD5_Update(static_cast<MD5_CTX*>(s), d, n); },
+     [](unsigned char* out, void* s) { return MD5_Final(out, static_cast<MD5_CTX*>(s)); },
+     MD5_DIGEST_LENGTH},
+    {SHA256_CBLOCK,
+     [](void* s) {
+         Sha256MultiBuffer::Init(*static_cast<Sha256MultiBuffer::State*>(s));
+         return 1;
+     },
+     [](void* s, const void* d, size_t n) {
+         Sha256MultiBuffer::Update(*static_cast<Sha256MultiBuffer::State*>(s), d, n);
+         return 1;
+     },
+     [](unsigned char* out, void* s) {
+         Sha256MultiBuffer::Final(*static_cast<Sha256MultiBuffer::State*>(s), out);
+         return 1;
+     },
+     SHA256_DIGEST_LENGTH},
+    {SHA512_CBLOCK,
+     [](void* s) { return SHA512_Init(static_cast<SHA512_CTX*>(s)); },
+     [](void* s, const void* d, size_t n) { return SHA512_Update(static_cast<SHA512_CTX*>(s), d, n); },
+     [](unsigned char* out, void* s) { return SHA512_Final(out, static_cast<SHA512_CTX*>(s)); },
+     SHA512_DIGEST_LENGTH},
+};
+
+// 低层实现只等价于 default provider 的摘要：启用 FIPS，或配置使该摘要由其他 provider
+// （FIPS、硬件加速等）提供时，保持经由 EVP_MAC，使 provider 配置继续生效
+bool builtin_hmac_allowed(const char* name) {
+    if (EVP_default_properties_is_fips_enabled(nullptr)) return false;
+    EVP_MD* md = EVP_MD_fetch(nullptr, name, nullptr);
+    if (!md) return false;
+    const OSSL_PROVIDER* provider = EVP_MD_get0_provider(md);
+    bool allowed = provider && std::strcmp(OSSL_PROVIDER_get0_name(provider), "default") == 0;
+    EVP_MD_free(md);
+    return allowed;
+}
+
+static_assert(sizeof(MD5_CTX) <= HashUtils::kDigestStateSize, "digest state storage too small");
+static_assert(sizeof(Sha256MultiBuffer::State) <= HashUtils::kDigestStateSize, "digest state storage too small");
+static_assert(sizeof(SHA512_CTX) <= HashUtils::kDigestStateSize, "digest state storage too small");
+
+} // namespace
+
+HashUtils::HashUtils(const std::string& key, const std::string& type)
+    : hash_key_(key), hash_type_(type), digest_kind_(kDigestEvp) {
     if (type == "SHA256") {
         evp_md_ = EVP_sha256();
+        digest_kind_ = kDigestSha256;
     } else if (type == "SHA512") {
         evp_md_ = EVP_sha512();
+        digest_kind_ = kDigestSha512;
     } else if (type == "MD5") {
         evp_md_ = EVP_md5();
+        digest_kind_ = kDigestMd5;
     } else if (type == "SM3") {
         evp_md_ = EVP_sm3();
     } else {
         throw std::invalid_argument("Unsupported hash type");
     }
+    if (digest_kind_ != kDigestEvp && !builtin_hmac_allowed(type.c_str())) {
+        digest_kind_ = kDigestEvp;
+    }
+    if (digest_kind_ == kDigestEvp) return;
+
+    // HMAC(K, m) = H((K' ^ opad) || H((K' ^ ipad) || m))，K' 为补零到分组长度的密钥，
+    // 超过分组长度的密钥先取摘要；两个吸收了填充密钥的状态只计算一次
+    const DigestOps& ops = kDigestOps[digest_kind_];
+    unsigned char block[SHA512_CBLOCK] = {0};
+    if (key.size() > ops.block_size) {
+        ops.init(hmac_inner_);
+        ops.update(hmac_inner_, key.data(), key.size());
+        ops.final(block, hmac_inner_);
+    } else {
+        std::memcpy(block, key.data(), key.size());
+    }
+    unsigned char pad[SHA512_CBLOCK];
+    for (size_t i = 0; i < ops.block_size; ++i) pad[i] = block[i] ^ 0x36;
+    ops.init(hmac_inner_);
+    ops.update(hmac_inner_, pad, ops.block_size);
+    for (size_t i = 0; i < ops.block_size; ++i) pad[i] = block[i] ^ 0x5c;
+    ops.init(hmac_outer_);
+    ops.update(hmac_outer_, pad, ops.block_size);
+    OPENSSL_cleanse(block, sizeof(block));
+    OPENSSL_cleanse(pad, sizeof(pad));
 }
 
-BIGNUM* HashUtils::hashToBn(const std::string& data) const {
-    unsigned char hash[EVP_MAX_MD_SIZE];
-    size_t hash_len;
+HashState::HashState(const HashUtils& hash) : ctx_(nullptr), digest_kind_(hash.digest_kind_), buffered_(0) {
+    if (digest_kind_ != kDigestEvp) {
+        std::memcpy(inner_, hash.hmac_inner_, sizeof(inner_));
+        std::memcpy(outer_, hash.hmac_outer_, sizeof(outer_));
+        return;
+    }
+    // 复制当前线程缓存的已设置密钥的 HMAC 上下文，无需重新获取算法与设置密钥
+    ctx_ = EVP_MAC_CTX_dup(CryptoContextPool::KeyedHmac(hash.evp_md_, hash.hash_key_));
+    if (!ctx_) {
+        throw std::runtime_error("Failed to create HMAC context");
+    }
+}
+
+HashState::~HashState() {
+    EVP_MAC_CTX_free(ctx_);
+}
 
-    EVP_MAC* mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
-    if (!mac) {
-        throw std::runtime_error("Failed to fetch HMAC");
+HashState::HashState(const HashState& other)
+    : ctx_(nullptr), digest_kind_(other.digest_kind_), buffered_(other.buffered_) {
+    if (other.ctx_) {
+        ctx_ = EVP_MAC_CTX_dup(other.ctx_);
+        if (!ctx_) {
+            throw std::runtime_error("Failed to copy HMAC context");
+        }
+    } else {
+        std::memcpy(inner_, other.inner_, sizeof(inner_));
+        std::memcpy(outer_, other.outer_, sizeof(outer_));
     }
+    std::memcpy(buffer_, other.buffer_, buffered_);
+}
 
-    EVP_MAC_CTX* ctx = EVP_MAC_CTX_new(mac);
-    EVP_MAC_free(mac);
-    if (!ctx) {
-        throw std::runtime_error("Failed to create HMAC context");
+HashState& HashState::operator=(const HashState& other) {
+    if (this != &other) {
+        EVP_MAC_CTX* ctx = nullptr;
+        if (other.ctx_) {
+            ctx = EVP_MAC_CTX_dup(other.ctx_);
+            if (!ctx) {
+                throw std::runtime_error("Failed to copy HMAC context");
+            }
+        } else {
+            std::memcpy(inner_, other.inner_, sizeof(inner_));
+            std::memcpy(outer_, other.outer_, sizeof(outer_));
+        }
+        EVP_MAC_CTX_free(ctx_);
+        ctx_ = ctx;
+        digest_kind_ = other.digest_kind_;
+        buffered_ = other.buffered_;
+        std::memcpy(buffer_, other.buffer_, buffered_);
+    }
+    return *this;
+}
+
+HashState::HashState(HashState&& other) noexcept
+    : ctx_(other.ctx_), digest_kind_(other.digest_kind_), buffered_(other.buffered_) {
+    if (!ctx_) {
+        std::memcpy(inner_, other.inner_, sizeof(inner_));
+        std::memcpy(outer_, other.outer_, sizeof(outer_));
     }
+    std::memcpy(buffer_, other.buffer_, buffered_);
+    other.ctx_ = nullptr;
+    other.buffered_ = 0;
+}
 
-    OSSL_PARAM params[] = {
-        OSSL_PARAM_construct_utf8_string("digest", const_cast<char*>(EVP_MD_get0_name(evp_md_)), 0),
-        OSSL_PARAM_END
-    };
-    EVP_MAC_init(ctx, reinterpret_cast<const unsigned char*>(hash_key_.c_str()), hash_key_.length(), params);
-    EVP_MAC_update(ctx, reinterpret_cast<const unsigned char*>(data.c_str()), data.length());
-    EVP_MAC_final(ctx, hash, &hash_len, sizeof(hash));
-    EVP_MAC_CTX_free(ctx);
+HashState& HashState::operator=(HashState&& other) noexcept {
+    if (this != &other) {
+        EVP_MAC_CTX_free(ctx_);
+        ctx_ = other.ctx_;
+        digest_kind_ = other.digest_kind_;
+        if (!ctx_) {
+            std::memcpy(inner_, other.inner_, sizeof(inner_));
+            std::memcpy(outer_, other.outer_, sizeof(outer_));
+        }
+        buffered_ = other.buffered_;
+        std::memcpy(buffer_, other.buffer_, buffered_);
+        other.ctx_ = nullptr;
+        other.buffered_ = 0;
+    }
+    return *this;
+}
 
+void HashState::Update(const void* data, size_t len) {
+    if (len == 0) return;
+    if (buffered_ + len <= kBufferSize) {
+        std::memcpy(buffer_ + buffered_, data, len);
+        buffered_ += len;
+        return;
+    }
+    flush();
+    if (len < kBufferSize) {
+        std::memcpy(buffer_, data, len);
+        buffered_ = len;
+        return;
+    }
+    bool ok = ctx_ ? EVP_MAC_update(ctx_, static_cast<const unsigned char*>(data), len)
+                   : kDigestOps[digest_kind_].update(inner_, data, len);
+    if (!ok) {
+        throw std::runtime_error("Failed to update HMAC");
+    }
+}
+
+void HashState::flush() {
+    if (buffered_ == 0) return;
+    bool ok = ctx_ ? EVP_MAC_update(ctx_, buffer_, buffered_)
+                   : kDigestOps[digest_kind_].update(inner_, buffer_, buffered_);
+    if (!ok) {
+        throw std::runtime_error("Failed to update HMAC");
+    }
+    buffered_ = 0;
+}
+
+size_t HashState::final(unsigned char* out) {
+    flush();
+    if (ctx_) {
+        size_t hash_len;
+        if (!EVP_MAC_final(ctx_, out, &hash_len, EVP_MAX_MD_SIZE)) {
+            throw std::runtime_error("Failed to finalize HMAC");
+        }
+        return hash_len;
+    }
+    const DigestOps& ops = kDigestOps[digest_kind_];
+    unsigned char inner_hash[EVP_MAX_MD_SIZE];
+    if (!ops.final(inner_hash, inner_) || !ops.update(outer_, inner_hash, ops.digest_size) ||
+        !ops.final(out, outer_)) {
+        throw std::runtime_error("Failed to finalize HMAC");
+    }
+    return ops.digest_size;
+}
+
+BIGNUM* HashState::FinalToBn() {
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    size_t hash_len = final(hash);
     BIGNUM* result = BN_bin2bn(hash, hash_len, nullptr);
     if (!result) {
         throw std::runtime_error("Failed to convert hash to BIGNUM");
@@ -53,4 +265,86 @@ BIGNUM* HashUtils::hashToBn(const std::string& data) const {
     return result;
 }
 
+void HashState::FinalToBn(BIGNUM* out) {
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    size_t hash_len = final(hash);
+    if (!BN_bin2bn(hash, hash_len, out)) {
+        throw std::runtime_error("Failed to convert hash to BIGNUM");
+    }
+}
+
+void HashState::FinalToBnBatch(HashState* const* states, BIGNUM* const* out, size_t count) {
+    HashState* batch[kBatchSize];
+    BIGNUM* batch_out[kBatchSize];
+    size_t pending = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (states[i]->digest_kind_ != kDigestSha256) {
+            states[i]->FinalToBn(out[i]);
+            continue;
+        }
+        batch[pending] = states[i];
+        batch_out[pending] = out[i];
+        if (++pending == kBatchSize) {
+            final_sha256_batch(batch, batch_out, pending);
+            pending = 0;
+        }
+    }
+    if (pending > 0) {
+        final_sha256_batch(batch, batch_out, pending);
+    }
+}
+
+void HashState::final_sha256_batch(HashState* const* states, BIGNUM* const* out, size_t count) {
+    // 只有前 count 项有效，其余项值初始化，使编译器能确认传给 FinalBatch 的数组已初始化
+    Sha256MultiBuffer::State* lanes[kBatchSize] = {};
+    const unsigned char* data[kBatchSize] = {};
+    size_t len[kBatchSize] = {};
+    unsigned char inner_hash[kBatchSize * SHA256_DIGEST_LENGTH] = {};
+    unsigned char hash[kBatchSize * SHA256_DIGEST_LENGTH] = {};
+
+    // 内层：H((K' ^ ipad) || m)，中间状态之后写入缓冲区中的剩余数据
+    for (size_t i = 0; i < count; ++i) {
+        HashState& state = *states[i];
+        lanes[i] = reinterpret_cast<Sha256MultiBuffer::State*>(state.inner_);
+        data[i] = state.buffer_;
+        len[i] = state.buffered_;
+    }
+    Sha256MultiBuffer::FinalBatch(lanes, data, len, inner_hash, count);
+
+    // 外层：H((K' ^ opad) || 内层摘要)
+    for (size_t i = 0; i < count; ++i) {
+        states[i]->buffered_ = 0;
+        lanes[i] = reinterpret_cast<Sha256MultiBuffer::State*>(states[i]->outer_);
+        data[i] = inner_hash + SHA256_DIGEST_LENGTH * i;
+        len[i] = SHA256_DIGEST_LENGTH;
+    }
+    Sha256MultiBuffer::FinalBatch(lanes, data, len, hash, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!BN_bin2bn(hash + SHA256_DIGEST_LENGTH * i, SHA256_DIGEST_LENGTH, out[i])) {
+            throw std::runtime_error("Failed to convert hash to BIGNUM");
+        }
+    }
+}
+
+BIGNUM* HashUtils::hashToBn(const std::string& data) const {
+    HashState state(*this);
+    state.Update(data);
+    return state.FinalToBn();
+}
+
+void HashUtils::hashToBnBatch(const std::string_view* data, BIGNUM* const* out, size_t count) const {
+    for (size_t begin = 0; begin < count; begin += HashState::kBatchSize) {
+        size_t n = std::min(count - begin, HashState::kBatchSize);
+        std::optional<HashState> states[HashState::kBatchSize];
+        HashState* pointers[HashState::kBatchSize];
+        for (size_t i = 0; i < n; ++i) {
+            states[i].emplace(*this);
+            states[i]->Update(data[begin + i]);
+            pointers[i] = &*states[i];
+        }
+        HashState::FinalToBnBatch(pointers, out + begin, n);
+    }
+}
+
 } // namespace ring_signature_lib
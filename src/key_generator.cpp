@@ -1,5 +1,6 @@
 #include "libringsign/key_generator.h"
 #include "libringsign/config_manager.h"
+#include "libringsign/crypto_pool.h"
 #include <openssl/rand.h>
 #include <openssl/obj_mac.h>
 #include <stdexcept>
@@ -15,11 +16,10 @@ namespace ring_signature_lib {
 KeyGenerator::KeyGenerator() 
     : curve_nid_(DEFAULT_CURVE_NID),
       hash_type_(DEFAULT_HASH_TYPE),
-      group_(nullptr),
-      private_key_(nullptr),
-      public_key_(nullptr),
+      transcript_version_(DEFAULT_TRANSCRIPT_VERSION),
       hash_keys_(5),
       hash_(),
+      backend_(nullptr),
       is_initialized_(false) {}
 
 void KeyGenerator::Initialize(unsigned int seed) {
@@ -33,6 +33,7 @@ void KeyGenerator::Initialize(unsigned int seed) {
 void KeyGenerator::initialize(unsigned int seed) {
     curve_nid_ = DEFAULT_CURVE_NID;
     hash_type_ = DEFAULT_HASH_TYPE;
+    transcript_version_ = DEFAULT_TRANSCRIPT_VERSION;
 
     // 使用当前时间作为随机种子（如果 seed == 0）
     if (seed == 0) {
@@ -41,32 +42,21 @@ void KeyGenerator::initialize(unsigned int seed) {
     srand(seed);
 
     // 使用 curve_nid_ 创建群 group_
-    group_ = EC_GROUP_new_by_curve_name(curve_nid_);
+    group_.reset(EC_GROUP_new_by_curve_name(curve_nid_));
     if (!group_) {
         throw std::runtime_error("Failed to create EC group");
     }
 
-    // 获取群的阶，确保私钥在阶范围内
-    BIGNUM* group_order = BN_new();
-    if (!group_order || !EC_GROUP_get_order(group_, group_order, nullptr)) {
-        EC_GROUP_free(group_);
-        BN_free(group_order);
-        throw std::runtime_error("Failed to get group order");
-    }
-
     // 生成私钥，使其在群的阶内
-    private_key_ = BN_new();
-    if (!private_key_ || !BN_rand_range(private_key_, group_order)) {
-        EC_GROUP_free(group_);
-        BN_free(group_order);
+    private_key_.reset(BN_new());
+    if (!private_key_ || !BN_rand_range(private_key_.get(), EC_GROUP_get0_order(group_.get()))) {
         throw std::runtime_error("Failed to generate private key within group order");
     }
-    BN_free(group_order);
 
     // 使用 group_ 生成公钥
-    public_key_ = EC_POINT_new(group_);
-    if (!public_key_ || !EC_POINT_mul(group_, public_key_, private_key_, nullptr, nullptr, nullptr)) {
-        EC_GROUP_free(group_);
+    public_key_.reset(EC_POINT_new(group_.get()));
+    if (!public_key_ ||
+        !EC_POINT_mul(group_.get(), public_key_.get(), private_key_.get(), nullptr, nullptr, nullptr)) {
         throw std::runtime_error("Failed to generate public key");
     }
 
@@ -76,6 +66,18 @@ void KeyGenerator::initialize(unsigned int seed) {
         hash_keys_[i] = key;
         hash_.emplace_back(key, hash_type_);
     }
+
+    backend_ = &EcBackend::ForGroup(group_.get());
+    precompute_ = std::make_shared<PrecomputeCache>(group_.get(), public_key_.get(), hash_[0],
+                                                    PrecomputeCache::kDefaultEventCapacity, backend_);
+    public_key_encoding_ = PointEncoding::Encode(group_.get(), public_key_.get(), nullptr);
+}
+
+void KeyGenerator::SetTranscriptVersion(int version) {
+    if (!Transcript::IsSupported(version)) {
+        throw std::invalid_argument("Unsupported transcript version");
+    }
+    transcript_version_ = version;
 }
 
 void KeyGenerator::SaveConfig(const std::string& config_path, const std::string& system_key_path) {
@@ -90,32 +92,40 @@ void KeyGenerator::SaveConfig(const std::string& config_path, const std::string&
 void KeyGenerator::LoadConfig(const std::string& config_path, const std::string& system_key_path) {
     load_public_config(config_path);
     load_keys(system_key_path);
+    backend_ = &EcBackend::ForGroup(group_.get());
+    precompute_ = std::make_shared<PrecomputeCache>(group_.get(), public_key_.get(), hash_[0],
+                                                    PrecomputeCache::kDefaultEventCapacity, backend_);
+    public_key_encoding_ = PointEncoding::Encode(group_.get(), public_key_.get(), nullptr);
 
     is_initialized_ = true;
 }
 
 void KeyGenerator::save_public_config(const std::string& config_path) {
+    json j = GetPublicConfig();
+
+    std::ofstream file(config_path);
+    if (file.is_open()) {
+        file << j.dump(4);
+        file.close();
+    } else {
+        throw std::runtime_error("Failed to open config file for saving");
+    }
+}
+
+json KeyGenerator::GetPublicConfig() const {
     json j;
     j["curve_nid"] = curve_nid_;
     j["hash_type"] = hash_type_;
+    j["transcript_version"] = transcript_version_;
 
     // 将公钥转换为十六进制并保存
-    char* pub_key_hex = EC_POINT_point2hex(group_, public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    j["system_public_key"] = pub_key_hex;
-    OPENSSL_free(pub_key_hex);
+    j["system_public_key"] = PointToHex(group_.get(), public_key_.get());
 
     // 保存哈希密钥
     for (const auto& key : hash_keys_) {
         j["hash_keys"].push_back(key);
     }
-
-    std::ofstream file(config_path);
-    if (file.is_open()) {
-        file << j.dump(4);
-        file.close();
-    } else {
-        throw std::runtime_error("Failed to open config file for saving");
-    }
+    return j;
 }
 
 void KeyGenerator::load_public_config(const std::string& config_path) {
@@ -130,22 +140,21 @@ void KeyGenerator::load_public_config(const std::string& config_path) {
 
     curve_nid_ = j["curve_nid"];
     hash_type_ = j["hash_type"];
+    transcript_version_ = j.value("transcript_version", TRANSCRIPT_VERSION_1);
+    if (!Transcript::IsSupported(transcript_version_)) {
+        throw std::runtime_error("Unsupported transcript version in config");
+    }
 
     // 如果未初始化 group_，使用 curve_nid_ 创建
     if (!group_) {
-        group_ = EC_GROUP_new_by_curve_name(curve_nid_);
+        group_.reset(EC_GROUP_new_by_curve_name(curve_nid_));
         if (!group_) {
             throw std::runtime_error("Failed to create EC group");
         }
     }
 
     // 加载公钥
-    std::string pub_key_hex = j["system_public_key"];
-    public_key_ = EC_POINT_new(group_);
-    if (!EC_POINT_hex2point(group_, pub_key_hex.c_str(), public_key_, nullptr)) {
-        EC_GROUP_free(group_);
-        throw std::runtime_error("Failed to parse public key from hex");
-    }
+    public_key_ = PointFromHex(group_.get(), j["system_public_key"].get<std::string>());
 
     // 加载哈希密钥
     hash_keys_ = j["hash_keys"].get<std::vector<std::string>>();
@@ -159,14 +168,10 @@ void KeyGenerator::save_keys(const std::string& system_key_path) {
     json j;
 
     // 保存公钥
-    char* pub_key_hex = EC_POINT_point2hex(group_, public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    j["system_public_key"] = pub_key_hex;
-    OPENSSL_free(pub_key_hex);
+    j["system_public_key"] = PointToHex(group_.get(), public_key_.get());
 
     // 保存私钥
-    char* private_key_hex = BN_bn2hex(private_key_);
-    j["system_private_key"] = private_key_hex;
-    OPENSSL_free(private_key_hex);
+    j["system_private_key"] = BnToHex(private_key_.get());
 
     std::ofstream key_file(system_key_path);
     if (key_file.is_open()) {
@@ -189,26 +194,17 @@ void KeyGenerator::load_keys(const std::string& system_key_path) {
 
     // 如果未初始化 group_，使用 curve_nid_ 创建
     if (!group_) {
-        group_ = EC_GROUP_new_by_curve_name(curve_nid_);
+        group_.reset(EC_GROUP_new_by_curve_name(curve_nid_));
         if (!group_) {
             throw std::runtime_error("Failed to create EC group");
         }
     }
 
     // 加载公钥
-    std::string pub_key_hex = j["system_public_key"];
-    public_key_ = EC_POINT_new(group_);
-    if (!EC_POINT_hex2point(group_, pub_key_hex.c_str(), public_key_, nullptr)) {
-        EC_GROUP_free(group_);
-        throw std::runtime_error("Failed to parse public key from hex");
-    }
+    public_key_ = PointFromHex(group_.get(), j["system_public_key"].get<std::string>());
 
     // 加载私钥
-    std::string private_key_hex = j["system_private_key"];
-    private_key_ = BN_new();
-    if (!private_key_ || !BN_hex2bn(&private_key_, private_key_hex.c_str())) {
-        throw std::runtime_error("Failed to load private key from hex");
-    }
+    private_key_ = BnFromHex(j["system_private_key"].get<std::string>());
 }
 
 std::pair<EC_POINT*, BIGNUM*> KeyGenerator::GenerateSignKey(const std::string& signer_id, const EC_POINT* signer_public_key, unsigned int seed) {
@@ -216,62 +212,121 @@ std::pair<EC_POINT*, BIGNUM*> KeyGenerator::GenerateSignKey(const std::string& s
         throw std::runtime_error("System not initialized");
     }
 
-    // 使用指定的种子初始化随机数生成器（若 seed 为 0 则使用当前时间）
-    if (seed == 0) {
-        seed = static_cast<unsigned int>(std::time(nullptr));
+    EcPointPtr partial_system_public_key(EC_POINT_new(group_.get()));
+    BnPtr partial_private_key(BN_new());
+    if (!partial_system_public_key || !partial_private_key) {
+        throw std::runtime_error("Failed to allocate partial key");
     }
-    srand(seed);
+    // 临时 BIGNUM 从线程局部的分配器借出，返回或抛出异常时归还并清零
+    ScopedBnCtx scoped_ctx;
+    generate_sign_key(signer_id, signer_public_key, system_state_param(seed),
+                      partial_system_public_key.get(), partial_private_key.get(), scoped_ctx.get());
+
+    // 返回部分公钥 Y_i 和部分私钥 z_i
+    return {partial_system_public_key.release(), partial_private_key.release()};
+}
+
+std::vector<std::pair<EcPointPtr, BnPtr>> KeyGenerator::GenerateSignKeys(
+    const std::pair<std::string, const EC_POINT*>* signers, size_t count, unsigned int seed) {
+    if (!is_initialized_) {
+        throw std::runtime_error("System not initialized");
+    }
+
+    // 同一批签名者共用系统状态参数；结果按输入下标写入，与分块方式无关
+    const std::string state = system_state_param(seed);
+    std::vector<std::pair<EcPointPtr, BnPtr>> keys(count);
+    auto issue = [&](size_t, size_t begin, size_t end) {
+        // 每个分块在自己的线程上借出 BN_CTX，分块内的签名者共用
+        ScopedBnCtx scoped_ctx;
+        for (size_t i = begin; i < end; ++i) {
+            EcPointPtr partial_system_public_key(EC_POINT_new(group_.get()));
+            BnPtr partial_private_key(BN_new());
+            if (!partial_system_public_key || !partial_private_key) {
+                throw std::runtime_error("Failed to allocate partial key");
+            }
+            generate_sign_key(signers[i].first, signers[i].second, state,
+                              partial_system_public_key.get(), partial_private_key.get(), scoped_ctx.get());
+            keys[i] = {std::move(partial_system_public_key), std::move(partial_private_key)};
+        }
+    };
+    if (pool_) {
+        pool_->ParallelFor(count, issue, kMinSignKeysPerChunk);
+    } else {
+        issue(0, 0, count);
+    }
+    return keys;
+}
 
-    // Step 1: 计算 h_i = H_1(signer_id || X_i || P_pub)
-    std::string data = signer_id + 
-                       EC_POINT_point2hex(group_, signer_public_key, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                       EC_POINT_point2hex(group_, public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    BIGNUM* id_hash = hash_[1].hashToBn(data);  // 使用 H_1 哈希计算
-
-    // Step 2: 计算 y_i = H_2(signer_id || 系统参数)
-    std::string system_state_param = "system_state_" + std::to_string(seed);  // 系统状态参数 ξ，包含 seed
-    data = signer_id + system_state_param;
-    BIGNUM* partial_system_key = hash_[2].hashToBn(data);  // 使用 H_2 哈希计算
-
-    // Step 3: 计算部分公钥 Y_i = y_i * G，直接使用 group_ 的生成元
-    EC_POINT* partial_system_public_key = EC_POINT_new(group_);
-    if (!partial_system_public_key || !EC_POINT_mul(group_, partial_system_public_key, partial_system_key, nullptr, nullptr, nullptr)) {
-        BN_free(id_hash);
-        BN_free(partial_system_key);
-        EC_POINT_free(partial_system_public_key);
+std::vector<std::pair<EcPointPtr, BnPtr>> KeyGenerator::GenerateSignKeys(
+    const std::vector<std::pair<std::string, const EC_POINT*>>& signers, unsigned int seed) {
+    return GenerateSignKeys(signers.data(), signers.size(), seed);
+}
+
+void KeyGenerator::SetThreadCount(size_t threads) {
+    if (threads <= 1) {
+        pool_.reset();
+    } else if (!pool_ || pool_->Size() != threads) {
+        pool_ = std::make_shared<ThreadPool>(threads);
+    }
+}
+
+std::string KeyGenerator::system_state_param(unsigned int seed) {
+    if (seed != 0) {
+        return "system_state_" + std::to_string(seed);
+    }
+    // 未指定种子时从 OpenSSL 的私有 DRBG 取随机数（各线程独立的 DRBG 实例，线程安全），
+    // 不再用 srand/time：全局状态在多线程下不安全，且按时间推算的 ξ 可被猜到
+    unsigned char random[16];
+    if (RAND_priv_bytes(random, sizeof(random)) != 1) {
+        throw std::runtime_error("Failed to generate system state parameter");
+    }
+    static const char digits[] = "0123456789abcdef";
+    std::string state = "system_state_";
+    for (unsigned char byte : random) {
+        state += digits[byte >> 4];
+        state += digits[byte & 0x0F];
+    }
+    return state;
+}
+
+void KeyGenerator::generate_sign_key(const std::string& signer_id, const EC_POINT* signer_public_key,
+                                     const std::string& system_state_param, EC_POINT* partial_system_public_key,
+                                     BIGNUM* partial_private_key, BN_CTX* ctx) {
+    ScopedArena arena(group_.get());
+
+    // Step 1: 计算 h_i = H_1(signer_id || X_i || P_pub)，按系统的 transcript 版本编码，P_pub 的编码已缓存
+    Transcript id_transcript(hash_[1], transcript_version_);
+    id_transcript.AppendString(signer_id);
+    id_transcript.AppendPoint(group_.get(), signer_public_key, ctx);
+    id_transcript.AppendPoint(public_key_encoding_);
+    BIGNUM* id_hash = arena.Bn();
+    id_transcript.FinalToBn(id_hash);  // 使用 H_1 哈希计算
+
+    // Step 2: 计算 y_i = H_2(signer_id || 系统参数)，系统状态参数 ξ 由 seed 或随机数决定
+    HashState partial_hash(hash_[2]);  // 使用 H_2 哈希计算
+    partial_hash.Update(signer_id);
+    partial_hash.Update(system_state_param);
+    BIGNUM* partial_system_key = arena.Bn();
+    partial_hash.FinalToBn(partial_system_key);
+
+    // Step 3: 计算部分公钥 Y_i = y_i * G。y_i 泄露即可由 z_i = y_i + h_i * s 求出 s，使用常数时间实现
+    try {
+        precompute_->Generator().MulSecret(partial_system_public_key, partial_system_key, ctx);
+    } catch (const std::exception&) {
         throw std::runtime_error("Failed to calculate partial public key");
     }
 
     // Step 4: 计算部分私钥 z_i = y_i + h_i * s
-    BIGNUM* partial_private_key = BN_new();
-    BIGNUM* temp = BN_new();
-    BN_CTX* ctx = BN_CTX_new();
-    if (!partial_private_key || !temp || !ctx) {
-        BN_free(id_hash);
-        BN_free(partial_system_key);
-        EC_POINT_free(partial_system_public_key);
-        BN_free(temp);
-        BN_CTX_free(ctx);
-        throw std::runtime_error("Failed to allocate BIGNUMs for partial private key calculation");
-    }
+    BIGNUM* temp = arena.Bn();
 
     // temp = h_i * s
-    if (!BN_mul(temp, id_hash, private_key_, ctx)) {
+    if (!BN_mul(temp, id_hash, private_key_.get(), ctx)) {
         throw std::runtime_error("Failed to calculate h_i * s");
     }
     // z_i = y_i + temp
     if (!BN_add(partial_private_key, partial_system_key, temp)) {
         throw std::runtime_error("Failed to calculate partial private key");
     }
-
-    // 清理临时变量
-    BN_free(id_hash);
-    BN_free(partial_system_key);
-    BN_free(temp);
-    BN_CTX_free(ctx);
-
-    // 返回部分公钥 Y_i 和部分私钥 z_i
-    return {partial_system_public_key, partial_private_key};
 }
 
 } // namespace ring_signature_lib
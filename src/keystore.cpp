@@ -0,0 +1,157 @@
+#include "libringsign/keystore.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ring_context.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+namespace {
+
+const char kMagic[4] = {'R', 'K', 'E', 'Y'};
+// magic、格式版本、transcript 版本、点宽度、标量宽度、曲线 NID、成员数、ID 表字节数、指纹
+const size_t kHeaderSize = 4 + 4 + 4 + 4 + 4 + kKeystoreFingerprintSize;
+const size_t kIndexEntrySize = 8;
+
+void put_u32(std::string& out, size_t value) {
+    if (value > 0xFFFFFFFFu) throw std::length_error("Keystore too large");
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<char>(value >> shift));
+}
+
+size_t get_u32(const char* p) {
+    const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+    return (static_cast<size_t>(u[0]) << 24) | (static_cast<size_t>(u[1]) << 16) |
+           (static_cast<size_t>(u[2]) << 8) | u[3];
+}
+
+void append_point(std::string& out, const EC_GROUP* group, const EC_POINT* point, point_conversion_form_t form,
+                  size_t width, BN_CTX* ctx) {
+    size_t offset = out.size();
+    out.resize(offset + width, '\0');
+    if (EC_POINT_point2oct(group, point, form,
+                           reinterpret_cast<unsigned char*>(&out[offset]), width, ctx) != width) {
+        throw std::runtime_error("Failed to encode keystore point");
+    }
+}
+
+} // namespace
+
+Keystore::Keystore(const std::string& path) : file_(path, MappedFile::Access::Random) {
+    std::string_view data = file_.View();
+    if (data.size() < kHeaderSize || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a keystore: " + path);
+    }
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(data.data());
+    if (header[4] != kKeystoreFormatVersion) {
+        throw std::runtime_error("Unsupported keystore format version: " + path);
+    }
+    transcript_version_ = header[5];
+    point_size_ = header[6];
+    scalar_size_ = header[7];
+    curve_nid_ = static_cast<int>(get_u32(data.data() + 8));
+    count_ = get_u32(data.data() + 12);
+    size_t ids_size = get_u32(data.data() + 16);
+    fingerprint_ = data.substr(20, kKeystoreFingerprintSize);
+
+    size_t record_size = 4 * point_size_ - 1 + scalar_size_;
+    size_t index_size = count_ * kIndexEntrySize;
+    if (point_size_ < 2 || scalar_size_ == 0 ||
+        data.size() != kHeaderSize + index_size + count_ * record_size + ids_size) {
+        throw std::runtime_error("Corrupted keystore: " + path);
+    }
+    index_ = data.substr(kHeaderSize, index_size);
+    records_ = data.substr(kHeaderSize + index_size, count_ * record_size);
+    ids_ = data.substr(kHeaderSize + index_size + count_ * record_size);
+}
+
+std::string_view Keystore::Id(size_t i) const {
+    const char* entry = index_.data() + i * kIndexEntrySize;
+    size_t offset = get_u32(entry);
+    size_t length = get_u32(entry + 4);
+    if (offset > ids_.size() || length > ids_.size() - offset) {
+        throw std::runtime_error("Corrupted keystore index");
+    }
+    return ids_.substr(offset, length);
+}
+
+long Keystore::IndexOf(std::string_view id) const {
+    size_t lo = 0;
+    size_t hi = count_;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (Id(mid) < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == count_ || Id(lo) != id) {
+        return -1;
+    }
+    return static_cast<long>(lo);
+}
+
+void Keystore::Save(const std::string& path, const RingContext& ring, const std::string& fingerprint,
+                    int transcript_version) {
+    if (!ring.HasCombinedPoints()) {
+        throw std::invalid_argument("Keystore requires a ring context with combined points");
+    }
+    if (fingerprint.size() != kKeystoreFingerprintSize) {
+        throw std::invalid_argument("Invalid system fingerprint");
+    }
+    const EC_GROUP* group = ring.GetGroup();
+    size_t point_size = 1 + (static_cast<size_t>(EC_GROUP_get_degree(group)) + 7) / 8;
+    size_t scalar_size = static_cast<size_t>(BN_num_bytes(EC_GROUP_get0_order(group)));
+    size_t count = ring.Size();
+
+    std::string ids;
+    std::string index;
+    index.reserve(count * kIndexEntrySize);
+    for (const auto& entry : ring.Entries()) {
+        put_u32(index, ids.size());
+        put_u32(index, entry.id.size());
+        ids += entry.id;
+    }
+
+    std::string out(kMagic, sizeof(kMagic));
+    out.push_back(static_cast<char>(kKeystoreFormatVersion));
+    out.push_back(static_cast<char>(transcript_version));
+    out.push_back(static_cast<char>(point_size));
+    out.push_back(static_cast<char>(scalar_size));
+    put_u32(out, static_cast<size_t>(EC_GROUP_get_curve_name(group)));
+    put_u32(out, count);
+    put_u32(out, ids.size());
+    out += fingerprint;
+    out.reserve(out.size() + index.size() + count * (4 * point_size - 1 + scalar_size) + ids.size());
+    out += index;
+
+    ScopedBnCtx scoped_ctx;
+    for (const auto& entry : ring.Entries()) {
+        append_point(out, group, entry.X, POINT_CONVERSION_COMPRESSED, point_size, scoped_ctx.get());
+        append_point(out, group, entry.Y, POINT_CONVERSION_COMPRESSED, point_size, scoped_ctx.get());
+        append_point(out, group, entry.K, POINT_CONVERSION_UNCOMPRESSED, 2 * point_size - 1, scoped_ctx.get());
+        size_t offset = out.size();
+        out.resize(offset + scalar_size, '\0');
+        if (BN_bn2binpad(entry.h, reinterpret_cast<unsigned char*>(&out[offset]), static_cast<int>(scalar_size)) < 0) {
+            throw std::runtime_error("Failed to encode keystore scalar");
+        }
+    }
+    out += ids;
+
+    // 先写临时文件再重命名，正在映射旧文件的进程继续看到完整的旧内容
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            throw std::runtime_error("Failed to write keystore: " + temp_path);
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("Failed to replace keystore: " + path);
+    }
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,484 @@
+#include "libringsign/kgc_server.h"
+#include "libringsign/bulk_enrollment.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/thread_pool.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ring_signature_lib {
+
+using json = nlohmann::json;
+
+namespace {
+
+// 监听套接字与 eventfd 在 epoll 中的标识；连接以其 fd 标识
+const uint64_t kListenTag = UINT64_MAX;
+const uint64_t kEventTag = UINT64_MAX - 1;
+
+void set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw std::runtime_error("fcntl(O_NONBLOCK) failed");
+    }
+}
+
+void epoll_update(int epoll_fd, int op, int fd, uint32_t events, uint64_t tag) {
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.u64 = tag;
+    if (epoll_ctl(epoll_fd, op, fd, &ev) < 0) {
+        throw std::runtime_error("epoll_ctl() failed");
+    }
+}
+
+} // namespace
+
+KgcServer::KgcServer(KeyGenerator& keygen, const KgcServerOptions& options)
+    : keygen_(keygen),
+      options_(options),
+      server_(options.ip, options.port, options.backlog),
+      epoll_fd_(-1),
+      event_fd_(-1),
+      stop_(false),
+      enrollments_(0),
+      errors_(0),
+      accepting_(false) {
+    if (options_.workers == 0) options_.workers = ThreadPool::DefaultThreadCount();
+    if (options_.max_connections == 0) options_.max_connections = 1;
+
+    set_nonblocking(server_.Fd());
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || event_fd_ < 0) {
+        if (epoll_fd_ >= 0) close(epoll_fd_);
+        if (event_fd_ >= 0) close(event_fd_);
+        throw std::runtime_error("Failed to create epoll/eventfd");
+    }
+    epoll_update(epoll_fd_, EPOLL_CTL_ADD, server_.Fd(), EPOLLIN, kListenTag);
+    accepting_ = true;
+    epoll_update(epoll_fd_, EPOLL_CTL_ADD, event_fd_, EPOLLIN, kEventTag);
+
+    for (size_t i = 0; i < options_.workers; ++i) {
+        workers_.emplace_back(&KgcServer::worker_loop, this);
+    }
+}
+
+KgcServer::~KgcServer() {
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        stop_ = true;
+    }
+    jobs_cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+    for (auto& [fd, conn] : connections_) close(fd);
+    close(event_fd_);
+    close(epoll_fd_);
+}
+
+void KgcServer::Stop() {
+    stop_ = true;
+    uint64_t one = 1;
+    ssize_t n = write(event_fd_, &one, sizeof(one));
+    (void)n;
+}
+
+std::string KgcServer::HandleRequest(const std::string& request) {
+    try {
+        if (IsBulkRequest(request)) {
+            return HandleBulkRequest(request);
+        }
+        json j = json::parse(request);
+        std::string op = j.value("op", "enroll");
+        if (op == "params") {
+            return keygen_.GetPublicConfig().dump();
+        }
+        if (op != "enroll") {
+            throw std::runtime_error("Unknown op: " + op);
+        }
+
+        std::string signer_id = j.at("id").get<std::string>();
+        EC_GROUP* group = keygen_.GetGroup();
+        EcPointPtr partial_pub = PointFromHex(group, j.at("partial_pub").get<std::string>());
+
+        auto [partial_system_pub, partial_priv] = keygen_.GenerateSignKey(signer_id, partial_pub.get());
+        EcPointPtr partial_system_pub_handle(partial_system_pub);
+        BnPtr partial_priv_handle(partial_priv);
+
+        // 不再发送系统参数更新，只发送部分密钥
+        json resp = {
+            {"partial_system_pub", PointToHex(group, partial_system_pub)},
+            {"partial_priv", BnToHex(partial_priv)},
+            {"update_config", options_.update_config ? 1 : 0}
+        };
+        ++enrollments_;
+        if (options_.verbose) {
+            std::cout << "已为签名者 " << signer_id << " 分发系统部分密钥。" << std::endl;
+        }
+        return resp.dump();
+    } catch (const std::exception& e) {
+        ++errors_;
+        return json{{"error", e.what()}}.dump();
+    }
+}
+
+std::string KgcServer::HandleBulkRequest(std::string_view request) {
+    std::vector<BulkEnrollmentRequest> requests = DecodeBulkRequest(request);
+    EC_GROUP* group = keygen_.GetGroup();
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+
+    // 先解码全部部分公钥，无效的条目不参与签发
+    std::vector<BulkEnrollmentResult> results(requests.size());
+    std::vector<EcPointPtr> points;
+    std::vector<std::pair<std::string, const EC_POINT*>> signers;
+    std::vector<size_t> positions;
+    points.reserve(requests.size());
+    signers.reserve(requests.size());
+    positions.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const auto& pub = requests[i].partial_pub;
+        EcPointPtr point(EC_POINT_new(group));
+        if (!point || !EC_POINT_oct2point(group, point.get(), reinterpret_cast<const unsigned char*>(pub.data()),
+                                          pub.size(), ctx) ||
+            EC_POINT_is_at_infinity(group, point.get())) {
+            results[i].error = "Invalid partial public key";
+            continue;
+        }
+        signers.emplace_back(std::move(requests[i].id), point.get());
+        points.push_back(std::move(point));
+        positions.push_back(i);
+    }
+
+    auto keys = keygen_.GenerateSignKeys(signers);
+    unsigned char buf[1 + 2 * 66];  // 最长的点编码（P-521 非压缩）
+    for (size_t k = 0; k < keys.size(); ++k) {
+        BulkEnrollmentResult& result = results[positions[k]];
+        size_t len = EC_POINT_point2oct(group, keys[k].first.get(), POINT_CONVERSION_COMPRESSED, buf, sizeof(buf), ctx);
+        if (len == 0) {
+            result.error = "Failed to encode partial system public key";
+            continue;
+        }
+        result.partial_system_pub.assign(reinterpret_cast<const char*>(buf), len);
+        result.partial_priv.resize(BN_num_bytes(keys[k].second.get()));
+        BN_bn2bin(keys[k].second.get(), reinterpret_cast<unsigned char*>(&result.partial_priv[0]));
+        result.ok = true;
+        if (options_.verbose) {
+            std::cout << "已为签名者 " << signers[k].first << " 分发系统部分密钥。" << std::endl;
+        }
+    }
+
+    size_t issued = 0;
+    for (const auto& result : results) issued += result.ok ? 1 : 0;
+    enrollments_ += issued;
+    errors_ += results.size() - issued;
+    return EncodeBulkResponse(results, options_.update_config);
+}
+
+void KgcServer::worker_loop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobs_mutex_);
+            jobs_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (stop_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job.data = HandleRequest(job.data);
+        {
+            std::lock_guard<std::mutex> lock(done_mutex_);
+            done_.push_back(std::move(job));
+        }
+        uint64_t one = 1;
+        ssize_t n = write(event_fd_, &one, sizeof(one));
+        (void)n;
+    }
+}
+
+void KgcServer::set_accepting(bool accepting) {
+    if (accepting_ == accepting) return;
+    // 达到连接数上限时不再监听可读事件，等待的连接留在内核的 listen 队列中
+    epoll_update(epoll_fd_, EPOLL_CTL_MOD, server_.Fd(), accepting ? static_cast<uint32_t>(EPOLLIN) : 0u, kListenTag);
+    accepting_ = accepting;
+}
+
+void KgcServer::accept_connections() {
+    while (connections_.size() < options_.max_connections) {
+        int fd = accept4(server_.Fd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "[KGC] accept() failed: " << strerror(errno) << std::endl;
+            }
+            break;
+        }
+        Connection& conn = connections_[fd];
+        conn.events = EPOLLIN | EPOLLRDHUP;
+        epoll_update(epoll_fd_, EPOLL_CTL_ADD, fd, conn.events, fd);
+    }
+    set_accepting(connections_.size() < options_.max_connections);
+}
+
+size_t KgcServer::input_limit(const Connection& conn) const {
+    return conn.protocol == Protocol::Framed ? options_.max_bulk_request_size + 4 : options_.max_request_size;
+}
+
+void KgcServer::on_readable(int fd) {
+    Connection& conn = connections_[fd];
+    char buf[4096];
+    // 输入超过上限一个字节即停止读取，由 process 拒绝过大的请求；每次事件的读取量有上限，
+    // 避免单个连接独占 I/O 线程，剩余数据在下次事件（水平触发）时读取
+    size_t budget = options_.max_read_per_wakeup;
+    while (budget > 0 && (conn.discard || conn.in.size() <= input_limit(conn))) {
+        size_t want = conn.discard ? std::min(sizeof(buf), budget)
+                                   : std::min({sizeof(buf), budget, input_limit(conn) + 1 - conn.in.size()});
+        ssize_t n = recv(fd, buf, want, 0);
+        if (n > 0) {
+            budget -= n;
+            if (conn.discard) {
+                // 丢弃过大请求的剩余部分，使错误响应先于连接关闭到达；对端持续发送时直接关闭
+                conn.discarded += n;
+                if (conn.discarded > input_limit(conn)) {
+                    close_connection(fd);
+                    return;
+                }
+                continue;
+            }
+            conn.in.append(buf, n);
+            if (conn.protocol == Protocol::Unknown) {
+                conn.protocol = conn.in[0] == '{' ? Protocol::Legacy : Protocol::Framed;
+            }
+            continue;
+        }
+        if (n == 0) {
+            conn.eof = true;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        close_connection(fd);
+        return;
+    }
+    process(fd, conn);
+}
+
+void KgcServer::process(int fd, Connection& conn) {
+    if (conn.protocol == Protocol::Legacy && conn.next_seq == 0) {
+        // 旧协议：请求是一个 JSON 对象，可能分多次到达；完整之前继续等待，对端在此之前关闭写端则放弃该连接
+        if (conn.in.size() > options_.max_request_size) {
+            ++errors_;
+            conn.discard = true;
+            conn.in.clear();
+            respond(fd, conn, conn.next_seq++, json{{"error", "Request too large"}}.dump());
+            return;
+        }
+        if (json::accept(conn.in)) {
+            conn.eof = true;  // 旧协议每个连接只有一个请求，不再读取
+            dispatch(fd, conn, std::move(conn.in));
+            conn.in.clear();
+        }
+    } else if (conn.protocol == Protocol::Framed && !conn.discard) {
+        // 依次取出完整的帧；已接收未响应的请求达到 max_pipeline 时，剩余输入留待响应写出后再解析
+        size_t offset = 0;
+        while (conn.in.size() - offset >= 4 && conn.next_seq - conn.next_write < options_.max_pipeline) {
+            const unsigned char* header = reinterpret_cast<const unsigned char*>(conn.in.data() + offset);
+            size_t length = (static_cast<size_t>(header[0]) << 24) | (static_cast<size_t>(header[1]) << 16) |
+                            (static_cast<size_t>(header[2]) << 8) | static_cast<size_t>(header[3]);
+            if (length > options_.max_request_size) {
+                // 超过普通请求上限的帧只能是批量签发请求，须先收到帧首的 magic 才能判断
+                std::string_view payload = std::string_view(conn.in).substr(offset + 4);
+                bool bulk = length <= options_.max_bulk_request_size;
+                if (bulk && payload.size() < kBulkMagicSize) break;
+                if (!bulk || !IsBulkRequest(payload)) {
+                    // 无法跳过过大的帧，返回错误后不再解析该连接的输入
+                    ++errors_;
+                    conn.discard = true;
+                    conn.in.clear();
+                    respond(fd, conn, conn.next_seq++, json{{"error", "Request too large"}}.dump());
+                    return;
+                }
+            }
+            if (conn.in.size() - offset - 4 < length) break;
+            dispatch(fd, conn, conn.in.substr(offset + 4, length));
+            offset += 4 + length;
+        }
+        conn.in.erase(0, offset);
+    }
+
+    if (conn.eof && conn.next_seq == conn.next_write && conn.out.empty()) {
+        // 对端已关闭且所有请求均已响应（或旧协议请求不完整）
+        close_connection(fd);
+        return;
+    }
+    if (conn.discard && !conn.write_shutdown && conn.next_seq == conn.next_write && conn.out.empty()) {
+        // 错误响应已写出：关闭写端通知对端，未读的输入仍会被丢弃，避免关闭时发送 RST 使响应丢失
+        shutdown(fd, SHUT_WR);
+        conn.write_shutdown = true;
+    }
+    update_events(fd, conn);
+}
+
+void KgcServer::dispatch(int fd, Connection& conn, std::string request) {
+    uint64_t seq = conn.next_seq++;
+    ++conn.in_flight;
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        jobs_.push_back({fd, seq, std::move(request)});
+    }
+    jobs_cv_.notify_one();
+}
+
+void KgcServer::respond(int fd, Connection& conn, uint64_t seq, std::string response) {
+    // 工作线程完成的顺序不定，按序号排队，保证响应与请求顺序一致
+    conn.ready.emplace(seq, std::move(response));
+    while (!conn.ready.empty() && conn.ready.begin()->first == conn.next_write) {
+        const std::string& data = conn.ready.begin()->second;
+        if (conn.protocol == Protocol::Framed) {
+            uint32_t length = static_cast<uint32_t>(data.size());
+            char header[4] = {static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+                              static_cast<char>(length >> 8), static_cast<char>(length)};
+            conn.out.append(header, sizeof(header));
+        }
+        conn.out += data;
+        conn.ready.erase(conn.ready.begin());
+        ++conn.next_write;
+    }
+    on_writable(fd);
+}
+
+void KgcServer::on_writable(int fd) {
+    Connection& conn = connections_[fd];
+    while (conn.written < conn.out.size()) {
+        ssize_t n = send(fd, conn.out.data() + conn.written, conn.out.size() - conn.written, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.written += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            update_events(fd, conn);
+            return;
+        }
+        // 对端已断开
+        close_connection(fd);
+        return;
+    }
+    conn.out.clear();
+    conn.written = 0;
+    // 响应写出后流水线有了空位，继续解析已缓冲的请求；旧协议写完响应后关闭连接
+    process(fd, conn);
+}
+
+void KgcServer::update_events(int fd, Connection& conn) {
+    uint32_t events = 0;
+    if (!conn.eof && conn.next_seq - conn.next_write < options_.max_pipeline) {
+        events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (conn.written < conn.out.size()) events |= EPOLLOUT;
+    if (events == conn.events) return;
+    epoll_update(epoll_fd_, EPOLL_CTL_MOD, fd, events, fd);
+    conn.events = events;
+}
+
+void KgcServer::drain_completions() {
+    uint64_t value;
+    while (read(event_fd_, &value, sizeof(value)) > 0) {
+    }
+    std::vector<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(done_mutex_);
+        done.swap(done_);
+    }
+    for (auto& job : done) {
+        auto it = connections_.find(job.fd);
+        if (it == connections_.end()) continue;
+        Connection& conn = it->second;
+        --conn.in_flight;
+        if (conn.closed) {
+            close_connection(job.fd);
+            continue;
+        }
+        respond(job.fd, conn, job.seq, std::move(job.data));
+    }
+}
+
+void KgcServer::close_connection(int fd) {
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) return;
+    if (!it->second.closed) epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    if (it->second.in_flight > 0) {
+        // 工作线程仍持有该 fd 的请求，结果全部返回后再关闭，避免 fd 被新连接复用
+        it->second.closed = true;
+        return;
+    }
+    close(fd);
+    connections_.erase(it);
+    if (!accepting_ && !stop_) set_accepting(true);
+}
+
+void KgcServer::Run() {
+    using clock = std::chrono::steady_clock;
+    auto last_report = clock::now();
+    size_t last_enrollments = enrollments_.load();
+    const auto interval = std::chrono::duration<double>(options_.report_interval);
+
+    epoll_event events[256];
+    while (!stop_) {
+        int timeout = -1;
+        if (options_.report_interval > 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                interval - (clock::now() - last_report));
+            timeout = remaining.count() > 0 ? static_cast<int>(remaining.count()) : 0;
+        }
+        int n = epoll_wait(epoll_fd_, events, 256, timeout);
+        if (n < 0 && errno != EINTR) {
+            throw std::runtime_error("epoll_wait() failed");
+        }
+        for (int i = 0; i < n; ++i) {
+            uint64_t tag = events[i].data.u64;
+            uint32_t ev = events[i].events;
+            if (tag == kListenTag) {
+                accept_connections();
+            } else if (tag == kEventTag) {
+                drain_completions();
+            } else {
+                int fd = static_cast<int>(tag);
+                if (connections_.find(fd) == connections_.end()) continue;
+                if (ev & (EPOLLHUP | EPOLLERR)) {
+                    close_connection(fd);
+                } else if (ev & EPOLLOUT) {
+                    on_writable(fd);
+                } else if (ev & (EPOLLIN | EPOLLRDHUP)) {
+                    on_readable(fd);
+                }
+            }
+        }
+
+        if (options_.report_interval > 0 && clock::now() - last_report >= interval) {
+            auto now = clock::now();
+            size_t total = enrollments_.load();
+            double seconds = std::chrono::duration<double>(now - last_report).count();
+            if (total != last_enrollments) {
+                std::cout << "[KGC] 已签发 " << total << " 个部分密钥，最近 " << seconds << " 秒: "
+                          << (total - last_enrollments) / seconds << " 个/秒，当前连接: "
+                          << connections_.size() << "，错误: " << errors_.load() << std::endl;
+            }
+            last_report = now;
+            last_enrollments = total;
+        }
+    }
+}
+
+} // namespace ring_signature_lib
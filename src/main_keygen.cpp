@@ -1,20 +1,228 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <fstream>
+#include <stdexcept>
 #include "libringsign/network_utils.h"
 #include <nlohmann/json.hpp>
 #include "libringsign/key_generator.h"
 #include "libringsign/signer.h"
 #include <vector>
+#include <algorithm>
+#include <chrono>
+#include "libringsign/bulk_enrollment.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/keystore.h"
+#include <filesystem>
+#ifdef __linux__
+#include <csignal>
+#include "libringsign/kgc_server.h"
+#include "libringsign/thread_pool.h"
+#endif
 
 using nlohmann::json;
 using namespace ring_signature_lib;
 
 void print_usage() {
     std::cout << "用法: ./keygen -kgc|-signer -ip <ip:port> [其他参数]\n";
+    std::cout << "      ./keygen -keystore <输出文件> [-ring <ring.json> | -L <环列表>] [-dir <配置目录>] [-threads <n>]\n";
+    std::cout << "KGC 参数:\n";
+    std::cout << "  -newsys: 重新初始化系统密钥并保存到 config\n";
+    std::cout << "  -backlog <n>: listen 队列长度 (默认 1024)\n";
+    std::cout << "  -max-conn <n>: 同时处理的连接数上限 (默认 4096)\n";
+    std::cout << "  -workers <n>: 计算部分密钥的工作线程数 (默认为硬件并发数)\n";
+    std::cout << "  -report <秒>: 输出签发速率的间隔 (默认 5，0 表示不输出)\n";
+    std::cout << "  -bulk-threads <n>: 签发单个批量请求的线程数 (默认为硬件并发数)\n";
+    std::cout << "  -v: 逐个输出已签发的签名者\n";
+    std::cout << "签名者参数:\n";
+    std::cout << "  -id <ID>: 签名者 ID (默认 signer1)\n";
+    std::cout << "  -o <文件>: 签名者密钥的保存路径 (默认 config/sign_key.json)\n";
+    std::cout << "  -fetch-config: 先在同一连接上从 KGC 获取系统公开参数并保存到 config/system_config.json\n";
+    std::cout << "  -bulk <文件>: 批量签发，文件中每行一个签名者 ID，密钥保存为 <目录>/<ID>_config.json\n";
+    std::cout << "  -outdir <目录>: 批量签发时密钥的保存目录 (默认 config)\n";
+    std::cout << "  -batch <n>: 批量签发时每个请求帧包含的签名者数 (默认 10000)\n";
+    std::cout << "公钥目录参数 (按 config/system_config.json 的系统参数编译):\n";
+    std::cout << "  -ring <文件>: 成员取自 ring.json 的 ring_members\n";
+    std::cout << "  -L <环列表>: 成员为逗号分隔的 ID，公钥取自 <配置目录>/<ID>_config.json\n";
+    std::cout << "  -dir <目录>: 成员配置所在目录 (默认 config)，未指定 -ring 与 -L 时收录其中全部 *_config.json\n";
+    std::cout << "  -threads <n>: 计算 h_i 与 K_i 的线程数 (默认为硬件并发数)\n";
 }
 
+// 读取成员配置中的完整公钥，缺少公钥字段的文件（如系统配置）返回 false
+bool load_member(const json& config, const EC_GROUP* group, std::vector<RingContext::Member>& members,
+                 std::vector<EcPointPtr>& points) {
+    if (!config.contains("id") || !config.contains("full_public_key_0") || !config.contains("full_public_key_1")) {
+        return false;
+    }
+    points.push_back(PointFromHex(group, config["full_public_key_0"].get<std::string>()));
+    points.push_back(PointFromHex(group, config["full_public_key_1"].get<std::string>()));
+    members.emplace_back(config["id"].get<std::string>(),
+                         std::make_pair(points[points.size() - 2].get(), points.back().get()));
+    return true;
+}
+
+// 编译公钥目录：一次性计算全部成员的 h_i 与 K_i，签名与验证时按 ID 查找，不再逐个解析成员配置
+void build_keystore(const std::string& output, const std::string& ring_path, const std::string& ring_list,
+                    const std::string& config_dir, size_t threads) {
+    auto start = std::chrono::steady_clock::now();
+    Signer system;
+    system.Initialize("", "config/system_config.json");
+    system.SetThreadCount(threads);
+    const EC_GROUP* group = system.GetGroup();
+
+    std::vector<RingContext::Member> members;
+    std::vector<EcPointPtr> points;
+    if (!ring_path.empty()) {
+        json ring = ConfigManager::LoadJson(ring_path);
+        for (const auto& member : ring["ring_members"]) {
+            if (!load_member(member, group, members, points)) {
+                throw std::runtime_error("Invalid ring member in " + ring_path);
+            }
+        }
+    } else if (!ring_list.empty()) {
+        size_t begin = 0;
+        while (begin <= ring_list.size()) {
+            size_t end = std::min(ring_list.find(',', begin), ring_list.size());
+            std::string path = config_dir + "/" + ring_list.substr(begin, end - begin) + "_config.json";
+            if (!load_member(ConfigManager::LoadJson(path), group, members, points)) {
+                throw std::runtime_error("Missing public key in " + path);
+            }
+            begin = end + 1;
+        }
+    } else {
+        const std::string suffix = "_config.json";
+        for (const auto& file : std::filesystem::directory_iterator(config_dir)) {
+            std::string name = file.path().filename().string();
+            if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+                load_member(ConfigManager::LoadJson(file.path().string()), group, members, points);
+            }
+        }
+    }
+    if (members.empty()) {
+        throw std::runtime_error("No ring members found");
+    }
+
+    RingContext ring = system.CreateRingContext(members);
+    Keystore::Save(output, ring, system.SystemFingerprint(), system.GetTranscriptVersion());
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Keystore] 已编译 " << ring.Size() << " 个成员到 " << output << "，用时 " << seconds << " 秒"
+              << std::endl;
+}
+
+// 批量签发：所有签名者共享一份系统参数，每 batch_size 个签名者的部分公钥打包为一个请求帧，
+// 全部请求帧连续发出后依次读取响应，补全并校验各签名者的密钥后保存
+void bulk_enroll(TCPClient& client, const std::string& ids_path, const std::string& output_dir, size_t batch_size) {
+    std::ifstream ids_file(ids_path);
+    if (!ids_file.is_open()) {
+        throw std::runtime_error("Failed to open ID list " + ids_path);
+    }
+    std::vector<std::string> ids;
+    std::string line;
+    while (std::getline(ids_file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) ids.push_back(line);
+    }
+    if (batch_size == 0) batch_size = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    Signer parameters;
+    parameters.Initialize("", "config/system_config.json");
+    std::vector<Signer> signers(ids.size());
+    unsigned char buf[1 + 2 * 66];
+    size_t batches = 0;
+    for (size_t begin = 0; begin < ids.size(); begin += batch_size, ++batches) {
+        size_t end = std::min(ids.size(), begin + batch_size);
+        std::vector<BulkEnrollmentRequest> requests(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            signers[i].Initialize(ids[i], parameters);
+            auto partial_key = signers[i].GeneratePartialKey();
+            size_t len = EC_POINT_point2oct(signers[i].GetGroup(), partial_key.second, POINT_CONVERSION_COMPRESSED,
+                                            buf, sizeof(buf), nullptr);
+            requests[i - begin] = {ids[i], std::string(reinterpret_cast<const char*>(buf), len)};
+        }
+        client.SendFrame(EncodeBulkRequest(requests));
+    }
+
+    size_t enrolled = 0;
+    std::string response;
+    for (size_t b = 0; b < batches; ++b) {
+        if (!client.RecvFrame(response)) {
+            throw std::runtime_error("KGC closed the connection");
+        }
+        if (!response.empty() && response[0] == '{') {
+            throw std::runtime_error("KGC error: " + json::parse(response).value("error", response));
+        }
+        auto results = DecodeBulkResponse(response);
+        size_t begin = b * batch_size;
+        if (results.size() != std::min(batch_size, ids.size() - begin)) {
+            throw std::runtime_error("Unexpected bulk enrollment response size");
+        }
+        for (size_t k = 0; k < results.size(); ++k) {
+            Signer& signer = signers[begin + k];
+            if (!results[k].ok) {
+                std::cerr << "签名者 " << ids[begin + k] << " 签发失败: " << results[k].error << std::endl;
+                continue;
+            }
+            EcPointPtr partial_system_pub(EC_POINT_new(signer.GetGroup()));
+            const auto& pub = results[k].partial_system_pub;
+            const auto& priv = results[k].partial_priv;
+            BnPtr partial_priv(BN_bin2bn(reinterpret_cast<const unsigned char*>(priv.data()),
+                                         static_cast<int>(priv.size()), nullptr));
+            if (!partial_system_pub || !partial_priv ||
+                !EC_POINT_oct2point(signer.GetGroup(), partial_system_pub.get(),
+                                    reinterpret_cast<const unsigned char*>(pub.data()), pub.size(), nullptr)) {
+                std::cerr << "签名者 " << ids[begin + k] << " 的部分密钥无效" << std::endl;
+                continue;
+            }
+            signer.GenerateFullKey(partial_system_pub.get(), partial_priv.get());
+            if (!signer.VerifyKey()) {
+                std::cerr << "签名者 " << ids[begin + k] << " 的密钥校验失败" << std::endl;
+                continue;
+            }
+            signer.SaveConfig(output_dir + "/" + ids[begin + k] + "_config.json");
+            ++enrolled;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Signer] 批量签发完成: " << enrolled << "/" << ids.size() << " 个签名者，" << batches
+              << " 个请求帧，用时 " << seconds << " 秒，密钥保存在 " << output_dir << std::endl;
+}
+
+#ifdef __linux__
+// SIGINT/SIGTERM 时停止事件循环并输出统计
+static KgcServer* g_kgc_server = nullptr;
+extern "C" void handle_signal(int) {
+    if (g_kgc_server) g_kgc_server->Stop();
+}
+#endif
+
 int main(int argc, char* argv[]) {
+    // 编译公钥目录，不需要连接 KGC
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "-keystore") != 0) continue;
+        std::string output = argv[i + 1];
+        std::string ring_path, ring_list, config_dir = "config";
+        size_t threads = ThreadPool::DefaultThreadCount();
+        for (int j = 1; j < argc; ++j) {
+            if (strcmp(argv[j], "-ring") == 0 && j + 1 < argc) {
+                ring_path = argv[++j];
+            } else if (strcmp(argv[j], "-L") == 0 && j + 1 < argc) {
+                ring_list = argv[++j];
+            } else if (strcmp(argv[j], "-dir") == 0 && j + 1 < argc) {
+                config_dir = argv[++j];
+            } else if (strcmp(argv[j], "-threads") == 0 && j + 1 < argc) {
+                threads = std::stoul(argv[++j]);
+            }
+        }
+        try {
+            build_keystore(output, ring_path, ring_list, config_dir, threads);
+        } catch (const std::exception& e) {
+            std::cerr << "[Keystore] 错误: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     if (argc < 4) {
         print_usage();
         return 1;
@@ -67,43 +275,93 @@ int main(int argc, char* argv[]) {
             keygen.LoadConfig("config/system_config.json", "config/system_key.json");
         }
 
+#ifdef __linux__
+        KgcServerOptions options;
+        options.ip = ip;
+        options.port = port;
+        options.update_config = use_newsys;
+        size_t bulk_threads = ThreadPool::DefaultThreadCount();
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "-backlog") == 0 && i + 1 < argc) {
+                options.backlog = std::stoi(argv[++i]);
+            } else if (strcmp(argv[i], "-max-conn") == 0 && i + 1 < argc) {
+                options.max_connections = std::stoul(argv[++i]);
+            } else if (strcmp(argv[i], "-workers") == 0 && i + 1 < argc) {
+                options.workers = std::stoul(argv[++i]);
+            } else if (strcmp(argv[i], "-report") == 0 && i + 1 < argc) {
+                options.report_interval = std::stod(argv[++i]);
+            } else if (strcmp(argv[i], "-bulk-threads") == 0 && i + 1 < argc) {
+                bulk_threads = std::stoul(argv[++i]);
+            } else if (strcmp(argv[i], "-v") == 0) {
+                options.verbose = true;
+            }
+        }
+        // 批量签发帧由一个工作线程接收，再分块到多个线程上签发
+        keygen.SetThreadCount(bulk_threads);
+
+        KgcServer server(keygen, options);
+        g_kgc_server = &server;
+        std::signal(SIGINT, handle_signal);
+        std::signal(SIGTERM, handle_signal);
+        std::signal(SIGPIPE, SIG_IGN);
+        std::cout << "[KGC] 等待签名者连接 (backlog " << options.backlog << "，连接上限 " << options.max_connections
+                  << "，工作线程 " << (options.workers ? options.workers : ThreadPool::DefaultThreadCount()) << ")..." << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        server.Run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[KGC] 停止服务，共签发 " << server.Enrollments() << " 个部分密钥，错误 " << server.Errors()
+                  << "，平均 " << server.Enrollments() / seconds << " 个/秒" << std::endl;
+        g_kgc_server = nullptr;
+#else
         TCPServer server(ip, port);
         std::cout << "[KGC] 等待签名者连接..." << std::endl;
         while (true) {
             int client_fd = server.Accept();
-            std::string req = server.Recv(client_fd);
-            json j = json::parse(req);
-            std::string signer_id = j["id"];
-            std::string partial_pub_hex = j["partial_pub"];
-            std::cout << "收到签名者: " << signer_id << std::endl;
-
-            // 生成系统部分密钥
-            EC_POINT* partial_pub = EC_POINT_new(keygen.GetGroup());
-            EC_POINT_hex2point(keygen.GetGroup(), partial_pub_hex.c_str(), partial_pub, nullptr);
-            auto [partial_system_pub, partial_priv] = keygen.GenerateSignKey(signer_id, partial_pub);
-
-            char* pub_hex = EC_POINT_point2hex(keygen.GetGroup(), partial_system_pub, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-            char* priv_hex = BN_bn2hex(partial_priv);
-
-            // 不再发送系统参数更新，只发送部分密钥
-            json resp = { 
-                {"partial_system_pub", pub_hex}, 
-                {"partial_priv", priv_hex},
-                {"update_config", use_newsys ? 1 : 0}
-            };
-
-            server.Send(client_fd, resp.dump());
-            server.Close(client_fd);
+            // 阻塞版本只支持分帧协议，逐帧处理直到客户端关闭连接
+            std::string req;
+            while (server.RecvFrame(client_fd, req)) {
+                if (IsBulkRequest(req)) {
+                    server.SendFrame(client_fd, json{{"error", "Bulk enrollment requires the epoll KGC"}}.dump());
+                    continue;
+                }
+                json j = json::parse(req);
+                if (j.value("op", "enroll") == "params") {
+                    server.SendFrame(client_fd, keygen.GetPublicConfig().dump());
+                    continue;
+                }
+                std::string signer_id = j["id"];
+                std::string partial_pub_hex = j["partial_pub"];
+                std::cout << "收到签名者: " << signer_id << std::endl;
 
-            OPENSSL_free(pub_hex);
-            OPENSSL_free(priv_hex);
-            EC_POINT_free(partial_pub);
-            EC_POINT_free(partial_system_pub);
-            BN_free(partial_priv);
+                // 生成系统部分密钥
+                EC_POINT* partial_pub = EC_POINT_new(keygen.GetGroup());
+                EC_POINT_hex2point(keygen.GetGroup(), partial_pub_hex.c_str(), partial_pub, nullptr);
+                auto [partial_system_pub, partial_priv] = keygen.GenerateSignKey(signer_id, partial_pub);
 
-            std::cout << "已为签名者 " << signer_id << " 分发系统部分密钥。" << std::endl;
+                char* pub_hex = EC_POINT_point2hex(keygen.GetGroup(), partial_system_pub, POINT_CONVERSION_UNCOMPRESSED, nullptr);
+                char* priv_hex = BN_bn2hex(partial_priv);
+
+                // 不再发送系统参数更新，只发送部分密钥
+                json resp = {
+                    {"partial_system_pub", pub_hex},
+                    {"partial_priv", priv_hex},
+                    {"update_config", use_newsys ? 1 : 0}
+                };
+
+                server.SendFrame(client_fd, resp.dump());
+
+                OPENSSL_free(pub_hex);
+                OPENSSL_free(priv_hex);
+                EC_POINT_free(partial_pub);
+                EC_POINT_free(partial_system_pub);
+                BN_free(partial_priv);
+
+                std::cout << "已为签名者 " << signer_id << " 分发系统部分密钥。" << std::endl;
+            }
+            server.Close(client_fd);
         }
         // server.CloseServer(); // 永久服务，若需退出可加信号处理
+#endif
     } else if (is_signer) {
         // 解析 -id 参数
         std::string signer_id = "signer1";
@@ -113,7 +371,6 @@ int main(int argc, char* argv[]) {
                 break;
             }
         }
-        std::cout << "[Signer] 启动签名者 " << signer_id << "，连接到KGC: " << ip_port << std::endl;
         // 解析 ip:port
         auto pos = ip_port.find(":");
         std::string ip = ip_port.substr(0, pos);
@@ -124,6 +381,51 @@ int main(int argc, char* argv[]) {
             ip = "127.0.0.1";
         }
 
+        bool fetch_config = false;
+        std::string bulk_path;
+        std::string output_dir = "config";
+        size_t batch_size = 10000;
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "-fetch-config") == 0) {
+                fetch_config = true;
+            } else if (strcmp(argv[i], "-bulk") == 0 && i + 1 < argc) {
+                bulk_path = argv[++i];
+            } else if (strcmp(argv[i], "-outdir") == 0 && i + 1 < argc) {
+                output_dir = argv[++i];
+            } else if (strcmp(argv[i], "-batch") == 0 && i + 1 < argc) {
+                batch_size = std::stoul(argv[++i]);
+            }
+        }
+        if (bulk_path.empty()) {
+            std::cout << "[Signer] 启动签名者 " << signer_id << "，连接到KGC: " << ip_port << std::endl;
+        } else {
+            std::cout << "[Signer] 批量签发 " << bulk_path << " 中的签名者，连接到KGC: " << ip_port << std::endl;
+        }
+
+        // 连接KGC，后续请求与响应均按帧在同一连接上收发
+        TCPClient client(ip, port);
+        client.Connect();
+        std::string resp_str;
+        if (fetch_config) {
+            client.SendFrame(json{{"op", "params"}}.dump());
+            if (!client.RecvFrame(resp_str)) {
+                throw std::runtime_error("KGC closed the connection");
+            }
+            json params = json::parse(resp_str);
+            if (params.contains("error")) {
+                throw std::runtime_error("KGC error: " + params["error"].get<std::string>());
+            }
+            std::ofstream file("config/system_config.json");
+            file << params.dump(4);
+            std::cout << "[Signer] 已从 KGC 获取系统公开参数并保存到 config/system_config.json" << std::endl;
+        }
+
+        if (!bulk_path.empty()) {
+            bulk_enroll(client, bulk_path, output_dir, batch_size);
+            client.Close();
+            return 0;
+        }
+
         // 步骤1：初始化签名者，加载系统配置
         Signer signer;
         signer.Initialize(signer_id, "config/system_config.json");
@@ -132,15 +434,18 @@ int main(int argc, char* argv[]) {
         auto partial_key = signer.GeneratePartialKey();
         char* partial_pub_hex = EC_POINT_point2hex(signer.GetGroup(), partial_key.second, POINT_CONVERSION_UNCOMPRESSED, nullptr);
 
-        // 步骤3：连接KGC，发送部分公钥和ID
-        json req = { {"id", signer_id}, {"partial_pub", partial_pub_hex} };
-        TCPClient client(ip, port);
-        client.Connect();
-        client.Send(req.dump());
+        // 步骤3：发送部分公钥和ID
+        json req = { {"op", "enroll"}, {"id", signer_id}, {"partial_pub", partial_pub_hex} };
+        client.SendFrame(req.dump());
 
         // 步骤4：接收KGC返回的系统部分密钥
-        std::string resp_str = client.Recv();
+        if (!client.RecvFrame(resp_str)) {
+            throw std::runtime_error("KGC closed the connection");
+        }
         json resp = json::parse(resp_str);
+        if (resp.contains("error")) {
+            throw std::runtime_error("KGC error: " + resp["error"].get<std::string>());
+        }
 
         EC_POINT* partial_system_pub = EC_POINT_new(signer.GetGroup());
         EC_POINT_hex2point(signer.GetGroup(), resp["partial_system_pub"].get<std::string>().c_str(), partial_system_pub, nullptr);
@@ -1,68 +1,46 @@
 #include <iostream>
+#include <algorithm>
 #include <string>
 #include <cstring>
 #include <vector>
 #include <fstream>
 #include <filesystem>
+#include <optional>
+#include <string_view>
 #include <nlohmann/json.hpp>
 #include <openssl/ec.h>
 #include <openssl/bn.h>
 #include "libringsign/signer.h"
 #include "libringsign/config_manager.h"
+#include "libringsign/mapped_file.h"
+#include "libringsign/message_digest.h"
+#include "libringsign/network_utils.h"
+#include "libringsign/sign_service.h"
+#include "libringsign/signature_codec.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/keystore.h"
 
 using namespace ring_signature_lib;
 using json = nlohmann::json;
 
 void print_usage() {
-    std::cout << "用法: ./sign -m <消息或文件> -L <环列表> -k <key文件> [-o <输出文件>]\n";
+    std::cout << "用法: ./sign -m <消息或文件> -L <环列表> (-k <key文件> | -S <套接字路径>) [-o <输出文件>] [-d <摘要算法>] [-c <分块字节数>] [-K <公钥目录>] [-f json|bin] [-no-checksum]\n";
     std::cout << "参数说明:\n";
     std::cout << "  -m: 要签名的消息或文件路径\n";
     std::cout << "  -L: 环成员列表，用逗号分隔的签名者ID (如: signer1,signer2,signer3)\n";
     std::cout << "  -k: 当前签名者的密钥文件路径\n";
+    std::cout << "  -S: 连接 signd 守护进程的 Unix 域套接字路径，由守护进程使用已加载的密钥签名 (可替代 -k)\n";
     std::cout << "  -o: 输出文件路径 (可选，默认输出到屏幕)\n";
-}
-
-// 读取文件内容
-std::string read_file_content(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        throw std::runtime_error("无法打开文件: " + file_path);
-    }
-    std::string content((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
-    file.close();
-    return content;
+    std::cout << "  -d: 摘要模式 (可选)，按指定算法 (如 SHA256、SHA512、SM3) 流式计算消息摘要后对摘要签名，\n";
+    std::cout << "      适用于大文件；不指定时对消息原文签名\n";
+    std::cout << "  -c: 摘要模式下读取文件的分块字节数 (可选，默认 " << MessageDigest::kDefaultChunkSize << ")\n";
+    std::cout << "  -K: 公钥目录文件 (可选，与 -k 一起使用，由 keygen -keystore 编译)，按 ID 查找环成员，不再逐个读取 config/<ID>_config.json\n";
+    std::cout << "  -f: 签名文件格式 (可选，默认 json)；bin 为紧凑的二进制格式 (压缩点、定长标量)，须同时指定 -o\n";
+    std::cout << "  -no-checksum: 二进制格式不附加校验和 (可选)\n";
 }
 
 // 将签名结果保存到文件
-void save_signature_to_file(const std::string& output_file, 
-                           const std::vector<EC_POINT*>& A,
-                           BIGNUM* phi, BIGNUM* psi, EC_POINT* T,
-                           EC_GROUP* group) {
-    json signature_json;
-    signature_json["A"] = json::array();
-    
-    // 保存A数组
-    for (size_t i = 0; i < A.size(); ++i) {
-        char* point_str = EC_POINT_point2hex(group, A[i], POINT_CONVERSION_UNCOMPRESSED, nullptr);
-        signature_json["A"].push_back(point_str);
-        OPENSSL_free(point_str);
-    }
-    
-    // 保存phi和psi
-    char* phi_str = BN_bn2hex(phi);
-    char* psi_str = BN_bn2hex(psi);
-    signature_json["phi"] = phi_str;
-    signature_json["psi"] = psi_str;
-    OPENSSL_free(phi_str);
-    OPENSSL_free(psi_str);
-    
-    // 保存T
-    char* t_str = EC_POINT_point2hex(group, T, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    signature_json["T"] = t_str;
-    OPENSSL_free(t_str);
-    
-    // 保存到文件
+void save_signature_to_file(const std::string& output_file, const json& signature_json) {
     std::ofstream file(output_file);
     if (file.is_open()) {
         file << signature_json.dump(4);
@@ -73,35 +51,97 @@ void save_signature_to_file(const std::string& output_file,
     }
 }
 
+// 将二进制签名保存到文件
+void save_binary_signature_to_file(const std::string& output_file, const std::string& data) {
+    std::ofstream file(output_file, std::ios::binary);
+    if (file.is_open()) {
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        file.close();
+        std::cout << "二进制签名已保存到文件: " << output_file << " (" << data.size() << " 字节)" << std::endl;
+    } else {
+        std::cerr << "错误: 无法写入输出文件: " << output_file << std::endl;
+    }
+}
+
+// signd 返回 JSON 签名，按系统配置的曲线解析后重新编码为二进制格式
+std::string json_signature_to_binary(const json& signature_json, const std::string& digest_algorithm, bool checksum) {
+    json system_config = ConfigManager::LoadJson("config/system_config.json");
+    EcGroupPtr group(EC_GROUP_new_by_curve_name(system_config.value("curve_nid", NID_secp256k1)));
+    if (!group) {
+        throw std::runtime_error("Failed to create EC group");
+    }
+    std::vector<EcPointPtr> A;
+    for (const auto& a_hex : signature_json["A"]) {
+        A.push_back(PointFromHex(group.get(), a_hex.get<std::string>()));
+    }
+    BnPtr phi = BnFromHex(signature_json["phi"].get<std::string>());
+    BnPtr psi = BnFromHex(signature_json["psi"].get<std::string>());
+    EcPointPtr T = PointFromHex(group.get(), signature_json["T"].get<std::string>());
+
+    // Signature 只借用这些对象，由上面的句柄负责释放
+    std::vector<EC_POINT*> A_view;
+    for (const auto& point : A) A_view.push_back(point.get());
+    Signature signature(std::move(A_view), phi.get(), psi.get(), T.get(),
+                        signature_json.value("transcript_version", TRANSCRIPT_VERSION_1));
+    return EncodeSignature(group.get(), signature, digest_algorithm, checksum);
+}
+
 // 打印签名结果到屏幕
-void print_signature(const std::vector<EC_POINT*>& A,
-                    BIGNUM* phi, BIGNUM* psi, EC_POINT* T,
-                    EC_GROUP* group) {
+void print_signature(const json& signature_json) {
     std::cout << "\n=== 环签名结果 ===" << std::endl;
+    std::cout << "transcript_version: " << signature_json["transcript_version"].get<int>() << std::endl;
+    std::cout << "message_mode: " << signature_json["message_mode"].get<std::string>() << std::endl;
+    if (signature_json.contains("message_digest")) {
+        std::cout << "message_digest: " << signature_json["message_digest"].get<std::string>() << std::endl;
+    }
     
     // 打印A数组
+    const json& A = signature_json["A"];
     for (size_t i = 0; i < A.size(); ++i) {
-        char* point_str = EC_POINT_point2hex(group, A[i], POINT_CONVERSION_UNCOMPRESSED, nullptr);
-        std::cout << "A[" << i << "]: " << point_str << std::endl;
-        OPENSSL_free(point_str);
+        std::cout << "A[" << i << "]: " << A[i].get<std::string>() << std::endl;
     }
     
     // 打印phi和psi
-    char* phi_str = BN_bn2hex(phi);
-    char* psi_str = BN_bn2hex(psi);
-    std::cout << "phi: " << phi_str << std::endl;
-    std::cout << "psi: " << psi_str << std::endl;
-    OPENSSL_free(phi_str);
-    OPENSSL_free(psi_str);
+    std::cout << "phi: " << signature_json["phi"].get<std::string>() << std::endl;
+    std::cout << "psi: " << signature_json["psi"].get<std::string>() << std::endl;
     
     // 打印T
-    char* t_str = EC_POINT_point2hex(group, T, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    std::cout << "T: " << t_str << std::endl;
-    OPENSSL_free(t_str);
+    std::cout << "T: " << signature_json["T"].get<std::string>() << std::endl;
+}
+
+// 作为 signd 的客户端：发送请求头与消息，返回守护进程生成的签名
+json sign_with_daemon(const std::string& socket_path, const std::vector<std::string>& ring_members,
+                      std::string_view message, const std::string& digest_algorithm) {
+#ifdef _WIN32
+    throw std::runtime_error("signd is not supported on this platform");
+#else
+    json request = {{"op", "sign"}, {"ring", ring_members}, {"event", "ring_signature_event"}};
+    if (!digest_algorithm.empty()) {
+        request["message_digest"] = digest_algorithm;
+    }
+    UnixSocketClient client(socket_path);
+    client.Connect();
+    SendFrame(client.Fd(), request.dump());
+    SendFrame(client.Fd(), message);
+    std::string response_str;
+    if (!RecvFrame(client.Fd(), response_str)) {
+        throw std::runtime_error("signd closed the connection");
+    }
+    json response = json::parse(response_str);
+    if (response.value("status", "") != "ok") {
+        throw std::runtime_error("signd: " + response.value("error", std::string("unknown error")));
+    }
+    std::cout << "签名者ID (signd): " << response["signer_id"].get<std::string>() << std::endl;
+    return response["signature"];
+#endif
 }
 
 int main(int argc, char* argv[]) {
-    std::string msg_or_file, ring_list, key_file, output_file;
+    std::string msg_or_file, ring_list, key_file, socket_path, output_file, digest_algorithm;
+    std::string format = "json";
+    std::string keystore_path;
+    bool checksum = true;
+    size_t chunk_size = MessageDigest::kDefaultChunkSize;
     
     // 解析命令行参数
     for (int i = 1; i < argc; ++i) {
@@ -111,20 +151,44 @@ int main(int argc, char* argv[]) {
             ring_list = argv[++i];
         } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
             key_file = argv[++i];
+        } else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
         } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
             output_file = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            digest_algorithm = argv[++i];
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            chunk_size = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-K") == 0 && i + 1 < argc) {
+            keystore_path = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "-no-checksum") == 0) {
+            checksum = false;
         }
     }
     
     // 检查必需参数
-    if (msg_or_file.empty() || ring_list.empty() || key_file.empty()) {
+    if (msg_or_file.empty() || ring_list.empty() || (key_file.empty() && socket_path.empty())) {
         print_usage();
         return 1;
     }
+    if (format != "json" && format != "bin") {
+        std::cerr << "错误: 不支持的签名格式: " << format << std::endl;
+        return 1;
+    }
+    if (format == "bin" && output_file.empty()) {
+        std::cerr << "错误: 二进制格式须用 -o 指定输出文件" << std::endl;
+        return 1;
+    }
     
     std::cout << "消息/文件: " << msg_or_file << std::endl;
     std::cout << "环列表: " << ring_list << std::endl;
-    std::cout << "密钥文件: " << key_file << std::endl;
+    if (!socket_path.empty()) {
+        std::cout << "signd 套接字: " << socket_path << std::endl;
+    } else {
+        std::cout << "密钥文件: " << key_file << std::endl;
+    }
     if (!output_file.empty()) {
         std::cout << "输出文件: " << output_file << std::endl;
     } else {
@@ -157,90 +221,135 @@ int main(int argc, char* argv[]) {
         }
         std::cout << std::endl;
         
-        // 读取消息内容
-        std::string message;
-        if (std::filesystem::exists(msg_or_file)) {
-            message = read_file_content(msg_or_file);
-            std::cout << "从文件读取消息，长度: " << message.length() << " 字符" << std::endl;
+        // 读取消息内容；摘要模式下分块流式读取文件，只把摘要交给签名方案
+        // 原文模式下的文件以只读方式映射，消息视图直接引用页缓存，不复制文件内容
+        std::string digest_message;
+        std::optional<MappedFile> mapped_message;
+        std::string_view message;
+        if (!digest_algorithm.empty()) {
+            if (std::filesystem::exists(msg_or_file)) {
+                digest_message = MessageDigest::DigestFile(msg_or_file, digest_algorithm, chunk_size);
+                std::cout << "从文件流式计算 " << digest_algorithm << " 摘要，文件长度: "
+                          << std::filesystem::file_size(msg_or_file) << " 字节" << std::endl;
+            } else {
+                digest_message = MessageDigest::DigestString(msg_or_file, digest_algorithm);
+                std::cout << "对直接输入的消息计算 " << digest_algorithm << " 摘要" << std::endl;
+            }
+            message = digest_message;
+        } else if (std::filesystem::exists(msg_or_file)) {
+            mapped_message.emplace(msg_or_file);
+            message = mapped_message->View();
+            std::cout << "从文件映射消息，长度: " << message.length() << " 字节" << std::endl;
         } else {
             message = msg_or_file;
             std::cout << "使用直接输入的消息，长度: " << message.length() << " 字符" << std::endl;
         }
         
-        // 从密钥文件确定当前签名者ID
-        json key_config = ConfigManager::LoadJson(key_file);
-        std::string current_signer_id = key_config["id"];
-        std::cout << "当前签名者ID: " << current_signer_id << std::endl;
-        
-        // 初始化签名者
-        Signer signer;
-        signer.LoadConfig("config/system_config.json", key_file);
-        std::cout << "签名者初始化完成" << std::endl;
-        
-        // 验证密钥
-        if (!signer.VerifyKey()) {
-            std::cerr << "错误: 密钥验证失败" << std::endl;
-            return 1;
-        }
-        std::cout << "密钥验证通过" << std::endl;
-        
-        // 加载环成员的公钥（跳过自己）
-        std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> other_signer_pkc;
-        EC_GROUP* group = signer.GetGroup();
-        for (const auto& member_id : ring_members) {
-            if (member_id == current_signer_id) continue;
-            std::string config_path = "config/" + member_id + "_config.json";
-            try {
-                json member_config = ConfigManager::LoadJson(config_path);
-                std::string pub_key_0_hex = member_config["full_public_key_0"];
-                std::string pub_key_1_hex = member_config["full_public_key_1"];
-                EC_POINT* pub_key_0 = EC_POINT_new(group);
-                EC_POINT* pub_key_1 = EC_POINT_new(group);
-                if (EC_POINT_hex2point(group, pub_key_0_hex.c_str(), pub_key_0, nullptr) &&
-                    EC_POINT_hex2point(group, pub_key_1_hex.c_str(), pub_key_1, nullptr)) {
-                    other_signer_pkc.emplace_back(member_id, std::make_pair(pub_key_0, pub_key_1));
-                    std::cout << "已加载 " << member_id << " 的公钥" << std::endl;
-                } else {
-                    std::cerr << "警告: 无法解析 " << member_id << " 的公钥" << std::endl;
-                    EC_POINT_free(pub_key_0);
-                    EC_POINT_free(pub_key_1);
+        json signature_json;
+        std::string binary_signature;
+        if (!socket_path.empty()) {
+            // 由常驻的 signd 签名：密钥、系统参数与环成员公钥已在守护进程中加载
+            std::cout << "开始生成环签名 (signd)..." << std::endl;
+            signature_json = sign_with_daemon(socket_path, ring_members, message, digest_algorithm);
+            if (format == "bin") {
+                binary_signature = json_signature_to_binary(signature_json, digest_algorithm, checksum);
+            }
+        } else {
+            // 从密钥文件确定当前签名者ID
+            json key_config = ConfigManager::LoadJson(key_file);
+            std::string current_signer_id = key_config["id"];
+            std::cout << "当前签名者ID: " << current_signer_id << std::endl;
+            
+            // 初始化签名者
+            Signer signer;
+            signer.LoadConfig("config/system_config.json", key_file);
+            std::cout << "签名者初始化完成" << std::endl;
+            
+            // 验证密钥
+            if (!signer.VerifyKey()) {
+                std::cerr << "错误: 密钥验证失败" << std::endl;
+                return 1;
+            }
+            std::cout << "密钥验证通过" << std::endl;
+            
+            // 加载环成员的公钥：指定公钥目录时按 ID 查找并直接采用预计算的 h_i 与 K_i，
+            // 否则逐个读取成员配置文件（跳过自己）
+            std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> other_signer_pkc;
+            std::optional<Keystore> keystore;
+            if (!keystore_path.empty()) {
+                keystore.emplace(keystore_path);
+                if (std::find(ring_members.begin(), ring_members.end(), current_signer_id) == ring_members.end()) {
+                    ring_members.push_back(current_signer_id);
+                }
+                std::cout << "已打开公钥目录: " << keystore_path << " (" << keystore->Size() << " 个成员)" << std::endl;
+            } else {
+                EC_GROUP* group = signer.GetGroup();
+                for (const auto& member_id : ring_members) {
+                    if (member_id == current_signer_id) continue;
+                    std::string config_path = "config/" + member_id + "_config.json";
+                    try {
+                        json member_config = ConfigManager::LoadJson(config_path);
+                        std::string pub_key_0_hex = member_config["full_public_key_0"];
+                        std::string pub_key_1_hex = member_config["full_public_key_1"];
+                        EC_POINT* pub_key_0 = EC_POINT_new(group);
+                        EC_POINT* pub_key_1 = EC_POINT_new(group);
+                        if (EC_POINT_hex2point(group, pub_key_0_hex.c_str(), pub_key_0, nullptr) &&
+                            EC_POINT_hex2point(group, pub_key_1_hex.c_str(), pub_key_1, nullptr)) {
+                            other_signer_pkc.emplace_back(member_id, std::make_pair(pub_key_0, pub_key_1));
+                            std::cout << "已加载 " << member_id << " 的公钥" << std::endl;
+                        } else {
+                            std::cerr << "警告: 无法解析 " << member_id << " 的公钥" << std::endl;
+                            EC_POINT_free(pub_key_0);
+                            EC_POINT_free(pub_key_1);
+                        }
+                    } catch (const std::exception& e) {
+                        std::cerr << "警告: 无法读取 " << member_id << " 的配置: " << e.what() << std::endl;
+                    }
                 }
-            } catch (const std::exception& e) {
-                std::cerr << "警告: 无法读取 " << member_id << " 的配置: " << e.what() << std::endl;
+            
+                if (other_signer_pkc.empty()) {
+                    std::cerr << "错误: 没有找到其他签名者的公钥" << std::endl;
+                    return 1;
+                }
+            
+                std::cout << "已加载 " << other_signer_pkc.size() << " 个其他签名者的公钥" << std::endl;
+            
+            }
+            
+            // 生成环签名
+            std::cout << "开始生成环签名..." << std::endl;
+            Signature signature = keystore
+                ? signer.Sign(message, "ring_signature_event", signer.CreateRingContext(*keystore, ring_members))
+                : signer.Sign(message, "ring_signature_event", other_signer_pkc);
+            if (format == "bin") {
+                binary_signature = EncodeSignature(signer.GetGroup(), signature, digest_algorithm, checksum);
+            } else {
+                signature_json = SignatureToJson(signer.GetGroup(), signature, digest_algorithm);
+            }
+            
+            // 清理内存
+            for (auto& point : signature.A) {
+                EC_POINT_free(point);
+            }
+            BN_free(signature.phi);
+            BN_free(signature.psi);
+            EC_POINT_free(signature.T);
+            
+            for (auto& [id, pub_key_pair] : other_signer_pkc) {
+                EC_POINT_free(pub_key_pair.first);
+                EC_POINT_free(pub_key_pair.second);
             }
         }
         
-        if (other_signer_pkc.empty()) {
-            std::cerr << "错误: 没有找到其他签名者的公钥" << std::endl;
-            return 1;
-        }
-        
-        std::cout << "已加载 " << other_signer_pkc.size() << " 个其他签名者的公钥" << std::endl;
-        
-        // 生成环签名
-        std::cout << "开始生成环签名..." << std::endl;
-        auto [A, phi, psi, T] = signer.Sign(message, "ring_signature_event", other_signer_pkc);
-        
         std::cout << "环签名生成完成!" << std::endl;
         
         // 输出签名结果
-        if (!output_file.empty()) {
-            save_signature_to_file(output_file, A, phi, psi, T, signer.GetGroup());
+        if (format == "bin") {
+            save_binary_signature_to_file(output_file, binary_signature);
+        } else if (!output_file.empty()) {
+            save_signature_to_file(output_file, signature_json);
         } else {
-            print_signature(A, phi, psi, T, signer.GetGroup());
-        }
-        
-        // 清理内存
-        for (auto& point : A) {
-            EC_POINT_free(point);
-        }
-        BN_free(phi);
-        BN_free(psi);
-        EC_POINT_free(T);
-        
-        for (auto& [id, pub_key_pair] : other_signer_pkc) {
-            EC_POINT_free(pub_key_pair.first);
-            EC_POINT_free(pub_key_pair.second);
+            print_signature(signature_json);
         }
         
     } catch (const std::exception& e) {
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "libringsign/config_manager.h"
+#include "libringsign/network_utils.h"
+#include "libringsign/sign_service.h"
+#include "libringsign/thread_pool.h"
+
+using namespace ring_signature_lib;
+
+void print_usage() {
+    std::cout << "用法: ./signd [-k <key文件>] [-S <套接字路径>] [-w <工作线程数>] [-t <每次签名的线程数>] [-r <环缓存数>] [-M <消息最大字节数>]\n";
+    std::cout << "参数说明:\n";
+    std::cout << "  -k: 签名者的密钥文件路径 (默认 " << DEFAULT_SIGN_KEY_PATH << ")\n";
+    std::cout << "  -S: 监听的 Unix 域套接字路径 (默认 " << DEFAULT_SIGND_SOCKET_PATH << ")\n";
+    std::cout << "  -w: 并发处理连接的工作线程数 (默认为硬件并发数)\n";
+    std::cout << "  -t: 单次签名内部并行处理环成员的线程数 (默认 1)\n";
+    std::cout << "  -r: 缓存的环上下文数量 (默认 64)\n";
+    std::cout << "  -M: 单条消息的最大字节数 (默认 " << kMaxFrameSize << ")\n";
+    std::cout << "客户端: ./sign -S <套接字路径> -m <消息或文件> -L <环列表> [-o <输出文件>] [-d <摘要算法>]\n";
+}
+
+// 收到 SIGINT/SIGTERM 时删除套接字文件后退出（unlink 与 _exit 可在信号处理函数中调用）
+static char g_socket_path[108];
+extern "C" void handle_signal(int) {
+    unlink(g_socket_path);
+    _exit(0);
+}
+
+// 已接受连接的队列，由工作线程取出处理；每个连接上可顺序发送多条请求，直到客户端关闭
+class ConnectionQueue {
+public:
+    void Push(int fd) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fds_.push_back(fd);
+        }
+        cv_.notify_one();
+    }
+    int Pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !fds_.empty(); });
+        int fd = fds_.front();
+        fds_.pop_front();
+        return fd;
+    }
+private:
+    std::deque<int> fds_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+int main(int argc, char* argv[]) {
+    std::string key_file = DEFAULT_SIGN_KEY_PATH;
+    std::string socket_path = DEFAULT_SIGND_SOCKET_PATH;
+    size_t workers = ThreadPool::DefaultThreadCount();
+    size_t sign_threads = 1;
+    size_t ring_cache = 64;
+    size_t max_message_size = kMaxFrameSize;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            key_file = argv[++i];
+        } else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            workers = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            sign_threads = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            ring_cache = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-M") == 0 && i + 1 < argc) {
+            max_message_size = std::stoul(argv[++i]);
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (workers == 0) workers = 1;
+    if (socket_path.size() >= sizeof(g_socket_path)) {
+        std::cerr << "错误: 套接字路径过长: " << socket_path << std::endl;
+        return 1;
+    }
+
+    try {
+        // 系统参数与签名者密钥只加载、校验一次
+        SignService service(DEFAULT_CONFIG_PATH, key_file, "config", ring_cache);
+        service.GetSigner().SetThreadCount(sign_threads);
+        std::cout << "[signd] 签名者 " << service.SignerId() << " 密钥加载并验证通过" << std::endl;
+
+        UnixSocketServer server(socket_path);
+        strcpy(g_socket_path, socket_path.c_str());
+        std::signal(SIGINT, handle_signal);
+        std::signal(SIGTERM, handle_signal);
+        std::signal(SIGPIPE, SIG_IGN);
+        std::cout << "[signd] 监听 " << socket_path << "，工作线程: " << workers
+                  << "，每次签名线程: " << sign_threads << std::endl;
+
+        ConnectionQueue queue;
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&] {
+                while (true) {
+                    int fd = queue.Pop();
+                    try {
+                        service.ServeConnection(fd, max_message_size);
+                    } catch (const std::exception& e) {
+                        std::cerr << "[signd] 连接处理失败: " << e.what() << std::endl;
+                    }
+                    server.Close(fd);
+                }
+            });
+        }
+        while (true) {
+            try {
+                queue.Push(server.Accept());
+            } catch (const std::exception& e) {
+                // 文件描述符耗尽等暂时性错误不终止服务
+                std::cerr << "[signd] " << e.what() << std::endl;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
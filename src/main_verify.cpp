@@ -4,37 +4,41 @@
 #include <vector>
 #include <fstream>
 #include <filesystem>
+#include <optional>
+#include <string_view>
 #include <nlohmann/json.hpp>
 #include <openssl/ec.h>
 #include <openssl/bn.h>
 #include "libringsign/signer.h"
 #include "libringsign/config_manager.h"
+#include "libringsign/mapped_file.h"
+#include "libringsign/keystore.h"
+#include "libringsign/message_digest.h"
+#include "libringsign/signature_codec.h"
+#include "libringsign/thread_pool.h"
 
 using namespace ring_signature_lib;
 using json = nlohmann::json;
 
+// 环成员数达到该值时并行解压缩二进制签名中的点
+const size_t kParallelDecodeRingSize = 1024;
+
 void print_usage() {
-    std::cout << "用法: ./verify -m <消息或文件> -L <环列表> -s <签名文件>\n";
+    std::cout << "用法: ./verify -m <消息或文件> -L <环列表> -s <签名文件> [-c <分块字节数>] [-K <公钥目录>] [-f auto|json|bin]\n";
     std::cout << "参数说明:\n";
     std::cout << "  -m: 要验证的消息或文件路径\n";
     std::cout << "  -L: 环成员列表，用逗号分隔的签名者ID (如: signer1,signer2,signer3)\n";
-    std::cout << "  -s: 签名文件 (JSON)\n";
-}
-
-// 读取文件内容
-std::string read_file_content(const std::string& file_path) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
-        throw std::runtime_error("无法打开文件: " + file_path);
-    }
-    std::string content((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
-    file.close();
-    return content;
+    std::cout << "  -s: 签名文件 (JSON 或二进制)\n";
+    std::cout << "  -c: 签名为摘要模式时读取文件的分块字节数 (可选，默认 " << MessageDigest::kDefaultChunkSize << ")\n";
+    std::cout << "  -K: 公钥目录文件 (可选，由 keygen -keystore 编译)，按 ID 查找环成员，不再逐个读取 config/<ID>_config.json\n";
+    std::cout << "  -f: 签名文件格式 (可选，默认 auto，按文件开头的 magic 识别二进制格式)\n";
 }
 
 int main(int argc, char* argv[]) {
     std::string msg_or_file, ring_list, sig_file;
+    std::string format = "auto";
+    std::string keystore_path;
+    size_t chunk_size = MessageDigest::kDefaultChunkSize;
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
             msg_or_file = argv[++i];
@@ -42,12 +46,22 @@ int main(int argc, char* argv[]) {
             ring_list = argv[++i];
         } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
             sig_file = argv[++i];
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            chunk_size = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-K") == 0 && i + 1 < argc) {
+            keystore_path = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            format = argv[++i];
         }
     }
     if (msg_or_file.empty() || ring_list.empty() || sig_file.empty()) {
         print_usage();
         return 1;
     }
+    if (format != "auto" && format != "json" && format != "bin") {
+        std::cerr << "错误: 不支持的签名格式: " << format << std::endl;
+        return 1;
+    }
     std::cout << "消息/文件: " << msg_or_file << std::endl;
     std::cout << "环列表: " << ring_list << std::endl;
     std::cout << "签名文件: " << sig_file << std::endl;
@@ -75,84 +89,149 @@ int main(int argc, char* argv[]) {
         }
         std::cout << std::endl;
 
-        // 读取消息内容
-        std::string message;
-        if (std::filesystem::exists(msg_or_file)) {
-            message = read_file_content(msg_or_file);
-            std::cout << "从文件读取消息，长度: " << message.length() << " 字符" << std::endl;
+        // 读取签名文件；二进制签名以视图直接引用映射的文件内容，此时只解析头部并检查校验和
+        // 缺少 "message_mode" 的旧 JSON 签名按原文模式验证
+        MappedFile sig_mapped(sig_file);
+        bool binary = format == "bin" || (format == "auto" && IsBinarySignature(sig_mapped.View()));
+        std::optional<SignatureView> sig_view;
+        json sig_json;
+        std::string message_mode;
+        std::string digest_algorithm;
+        if (binary) {
+            sig_view.emplace(sig_mapped.View());
+            digest_algorithm = std::string(sig_view->MessageDigest());
+            message_mode = digest_algorithm.empty() ? MESSAGE_MODE_RAW : MESSAGE_MODE_DIGEST;
+            std::cout << "二进制签名，环大小: " << sig_view->RingSize() << "，长度: " << sig_mapped.Size() << " 字节" << std::endl;
+        } else {
+            sig_json = json::parse(sig_mapped.View().begin(), sig_mapped.View().end());
+            message_mode = sig_json.value("message_mode", MESSAGE_MODE_RAW);
+            digest_algorithm = sig_json.value("message_digest", MessageDigest::kDefaultAlgorithm);
+        }
+        if (message_mode != MESSAGE_MODE_RAW && message_mode != MESSAGE_MODE_DIGEST) {
+            std::cerr << "错误: 不支持的消息模式: " << message_mode << std::endl;
+            return 1;
+        }
+
+        // 读取消息内容；摘要模式下按签名记录的算法分块流式计算摘要，与签名时一致
+        // 原文模式下的文件以只读方式映射，消息视图直接引用页缓存，不复制文件内容
+        std::string digest_message;
+        std::optional<MappedFile> mapped_message;
+        std::string_view message;
+        if (message_mode == MESSAGE_MODE_DIGEST) {
+            if (std::filesystem::exists(msg_or_file)) {
+                digest_message = MessageDigest::DigestFile(msg_or_file, digest_algorithm, chunk_size);
+                std::cout << "从文件流式计算 " << digest_algorithm << " 摘要，文件长度: "
+                          << std::filesystem::file_size(msg_or_file) << " 字节" << std::endl;
+            } else {
+                digest_message = MessageDigest::DigestString(msg_or_file, digest_algorithm);
+                std::cout << "对直接输入的消息计算 " << digest_algorithm << " 摘要" << std::endl;
+            }
+            message = digest_message;
+        } else if (std::filesystem::exists(msg_or_file)) {
+            mapped_message.emplace(msg_or_file);
+            message = mapped_message->View();
+            std::cout << "从文件映射消息，长度: " << message.length() << " 字节" << std::endl;
         } else {
             message = msg_or_file;
             std::cout << "使用直接输入的消息，长度: " << message.length() << " 字符" << std::endl;
         }
 
-        // 加载环成员公钥
+        // 加载环成员公钥：指定公钥目录时按 ID 查找并直接采用预计算的 h_i 与 K_i，
+        // 否则逐个读取成员配置文件
         std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> ring_pubkeys;
         EC_GROUP* group = nullptr;
-        for (const auto& member_id : ring_members) {
-            std::string config_path = "config/" + member_id + "_config.json";
-            try {
-                json member_config = ConfigManager::LoadJson(config_path);
-                std::string pub_key_0_hex = member_config["full_public_key_0"];
-                std::string pub_key_1_hex = member_config["full_public_key_1"];
-                if (!group) {
-                    // 初始化椭圆曲线群
-                    int curve_nid = member_config.value("curve_nid", NID_secp256k1);
-                    group = EC_GROUP_new_by_curve_name(curve_nid);
-                }
-                EC_POINT* pub_key_0 = EC_POINT_new(group);
-                EC_POINT* pub_key_1 = EC_POINT_new(group);
-                if (EC_POINT_hex2point(group, pub_key_0_hex.c_str(), pub_key_0, nullptr) &&
-                    EC_POINT_hex2point(group, pub_key_1_hex.c_str(), pub_key_1, nullptr)) {
-                    ring_pubkeys.emplace_back(member_id, std::make_pair(pub_key_0, pub_key_1));
-                    std::cout << "已加载 " << member_id << " 的公钥" << std::endl;
-                } else {
-                    std::cerr << "警告: 无法解析 " << member_id << " 的公钥" << std::endl;
-                    EC_POINT_free(pub_key_0);
-                    EC_POINT_free(pub_key_1);
+        std::optional<Keystore> keystore;
+        if (!keystore_path.empty()) {
+            keystore.emplace(keystore_path);
+            group = EC_GROUP_new_by_curve_name(keystore->CurveNid());
+            std::cout << "已打开公钥目录: " << keystore_path << " (" << keystore->Size() << " 个成员)" << std::endl;
+        } else {
+            for (const auto& member_id : ring_members) {
+                std::string config_path = "config/" + member_id + "_config.json";
+                try {
+                    json member_config = ConfigManager::LoadJson(config_path);
+                    std::string pub_key_0_hex = member_config["full_public_key_0"];
+                    std::string pub_key_1_hex = member_config["full_public_key_1"];
+                    if (!group) {
+                        // 初始化椭圆曲线群
+                        int curve_nid = member_config.value("curve_nid", NID_secp256k1);
+                        group = EC_GROUP_new_by_curve_name(curve_nid);
+                    }
+                    EC_POINT* pub_key_0 = EC_POINT_new(group);
+                    EC_POINT* pub_key_1 = EC_POINT_new(group);
+                    if (EC_POINT_hex2point(group, pub_key_0_hex.c_str(), pub_key_0, nullptr) &&
+                        EC_POINT_hex2point(group, pub_key_1_hex.c_str(), pub_key_1, nullptr)) {
+                        ring_pubkeys.emplace_back(member_id, std::make_pair(pub_key_0, pub_key_1));
+                        std::cout << "已加载 " << member_id << " 的公钥" << std::endl;
+                    } else {
+                        std::cerr << "警告: 无法解析 " << member_id << " 的公钥" << std::endl;
+                        EC_POINT_free(pub_key_0);
+                        EC_POINT_free(pub_key_1);
+                    }
+                } catch (const std::exception& e) {
+                    std::cerr << "警告: 无法读取 " << member_id << " 的配置: " << e.what() << std::endl;
                 }
-            } catch (const std::exception& e) {
-                std::cerr << "警告: 无法读取 " << member_id << " 的配置: " << e.what() << std::endl;
             }
         }
         if (!group) {
             std::cerr << "错误: 无法初始化椭圆曲线群" << std::endl;
             return 1;
         }
-        if (ring_pubkeys.size() < 2) {
+        if (!keystore && ring_pubkeys.size() < 2) {
             std::cerr << "错误: 有效环成员公钥数量不足2" << std::endl;
             EC_GROUP_free(group);
             return 1;
         }
 
-        // 读取签名文件
-        json sig_json = ConfigManager::LoadJson(sig_file);
+        // 解析签名
         std::vector<EC_POINT*> A;
-        for (const auto& a_hex : sig_json["A"]) {
-            EC_POINT* a_pt = EC_POINT_new(group);
-            if (!EC_POINT_hex2point(group, a_hex.get<std::string>().c_str(), a_pt, nullptr)) {
-                std::cerr << "警告: 无法解析A中的点: " << a_hex << std::endl;
-                EC_POINT_free(a_pt);
-                continue;
-            }
-            A.push_back(a_pt);
-        }
         BIGNUM* phi = nullptr;
         BIGNUM* psi = nullptr;
         EC_POINT* T = nullptr;
-        BN_hex2bn(&phi, sig_json["phi"].get<std::string>().c_str());
-        BN_hex2bn(&psi, sig_json["psi"].get<std::string>().c_str());
-        T = EC_POINT_new(group);
-        if (!EC_POINT_hex2point(group, sig_json["T"].get<std::string>().c_str(), T, nullptr)) {
-            std::cerr << "错误: 无法解析签名T点" << std::endl;
-            EC_POINT_free(T);
-            T = nullptr;
+        int transcript_version = TRANSCRIPT_VERSION_1;
+        if (binary) {
+            // 一次解码全部点与标量，任一字段无效时抛出异常；大环上并行解压缩
+            std::optional<ThreadPool> pool;
+            if (sig_view->RingSize() >= kParallelDecodeRingSize && ThreadPool::DefaultThreadCount() > 1) {
+                pool.emplace(ThreadPool::DefaultThreadCount());
+            }
+            Signature signature = sig_view->Decode(group, pool ? &*pool : nullptr);
+            A = std::move(signature.A);
+            phi = signature.phi;
+            psi = signature.psi;
+            T = signature.T;
+            transcript_version = signature.transcript_version;
+        } else {
+            for (const auto& a_hex : sig_json["A"]) {
+                EC_POINT* a_pt = EC_POINT_new(group);
+                if (!EC_POINT_hex2point(group, a_hex.get<std::string>().c_str(), a_pt, nullptr)) {
+                    std::cerr << "警告: 无法解析A中的点: " << a_hex << std::endl;
+                    EC_POINT_free(a_pt);
+                    continue;
+                }
+                A.push_back(a_pt);
+            }
+            BN_hex2bn(&phi, sig_json["phi"].get<std::string>().c_str());
+            BN_hex2bn(&psi, sig_json["psi"].get<std::string>().c_str());
+            T = EC_POINT_new(group);
+            if (!EC_POINT_hex2point(group, sig_json["T"].get<std::string>().c_str(), T, nullptr)) {
+                std::cerr << "错误: 无法解析签名T点" << std::endl;
+                EC_POINT_free(T);
+                T = nullptr;
+            }
+
+            // 缺少版本字段的旧签名按 v1 transcript 验证
+            transcript_version = sig_json.value("transcript_version", TRANSCRIPT_VERSION_1);
         }
 
         // 验证签名
         Signer verifier;
         // 需要初始化系统配置以获取群参数和哈希函数
         verifier.LoadConfig("config/system_config.json");
-        bool valid = verifier.Verify(A, phi, psi, T, message, "ring_signature_event", ring_pubkeys);
+        bool valid = keystore
+            ? verifier.Verify(A, phi, psi, T, message, "ring_signature_event",
+                              verifier.CreateRingContext(*keystore, ring_members), transcript_version)
+            : verifier.Verify(A, phi, psi, T, message, "ring_signature_event", ring_pubkeys, transcript_version);
         if (valid) {
             std::cout << "\n签名验证通过！" << std::endl;
         } else {
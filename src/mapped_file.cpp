@@ -0,0 +1,96 @@
+#include "libringsign/mapped_file.h"
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ring_signature_lib {
+
+#ifdef _WIN32
+// Windows 下没有 mmap，退化为一次性读入堆内存
+MappedFile::MappedFile(const std::string& path, Access) : data_(nullptr), size_(0) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file " + path);
+    }
+    size_ = static_cast<size_t>(file.tellg());
+    if (size_ > 0) {
+        char* data = new char[size_];
+        file.seekg(0);
+        if (!file.read(data, static_cast<std::streamsize>(size_))) {
+            delete[] data;
+            throw std::runtime_error("Failed to read file " + path);
+        }
+        data_ = data;
+    }
+}
+#else
+MappedFile::MappedFile(const std::string& path, Access access) : data_(nullptr), size_(0) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        throw std::runtime_error("Not a regular file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (size_ > 0) {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            throw std::runtime_error("Failed to map file " + path + ": " + std::strerror(err));
+        }
+        data_ = data;
+        // 仅为性能提示，失败不影响读取
+        madvise(data_, size_, access == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+    }
+    // 映射建立后即可关闭文件描述符
+    close(fd);
+}
+#endif
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+    if (data_) {
+#ifdef _WIN32
+        delete[] static_cast<char*>(data_);
+#else
+        munmap(data_, size_);
+#endif
+        data_ = nullptr;
+    }
+    size_ = 0;
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,67 @@
+#include "libringsign/message_digest.h"
+#include "libringsign/mapped_file.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+const std::string MessageDigest::kDefaultAlgorithm = "SHA256";
+
+MessageDigest::MessageDigest(const std::string& algorithm) : algorithm_(algorithm), ctx_(nullptr) {
+    const EVP_MD* md = EVP_get_digestbyname(algorithm.c_str());
+    if (!md) {
+        throw std::invalid_argument("Unsupported message digest: " + algorithm);
+    }
+    ctx_ = EVP_MD_CTX_new();
+    if (!ctx_ || !EVP_DigestInit_ex(ctx_, md, nullptr)) {
+        EVP_MD_CTX_free(ctx_);
+        throw std::runtime_error("Failed to initialize message digest");
+    }
+}
+
+MessageDigest::~MessageDigest() {
+    EVP_MD_CTX_free(ctx_);
+}
+
+void MessageDigest::Update(const void* data, size_t len) {
+    if (!EVP_DigestUpdate(ctx_, data, len)) {
+        throw std::runtime_error("Failed to update message digest");
+    }
+}
+
+std::string MessageDigest::FinalToMessage() {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int len = 0;
+    if (!EVP_DigestFinal_ex(ctx_, digest, &len)) {
+        throw std::runtime_error("Failed to finalize message digest");
+    }
+    return ToMessage(algorithm_, digest, len);
+}
+
+std::string MessageDigest::ToMessage(const std::string& algorithm, const unsigned char* digest, size_t len) {
+    std::string message = "libringsign-digest:" + algorithm + ":";
+    message.append(reinterpret_cast<const char*>(digest), len);
+    return message;
+}
+
+std::string MessageDigest::DigestFile(const std::string& path, const std::string& algorithm, size_t chunk_size) {
+    if (chunk_size == 0) {
+        throw std::invalid_argument("Chunk size must be positive");
+    }
+    // 文件内容直接来自页缓存，无需复制到读缓冲区；按顺序访问的提示使内核提前预读
+    MappedFile file(path);
+    std::string_view content = file.View();
+    MessageDigest digest(algorithm);
+    for (size_t offset = 0; offset < content.size(); offset += chunk_size) {
+        digest.Update(content.substr(offset, std::min(chunk_size, content.size() - offset)));
+    }
+    return digest.FinalToMessage();
+}
+
+std::string MessageDigest::DigestString(std::string_view data, const std::string& algorithm) {
+    MessageDigest digest(algorithm);
+    digest.Update(data);
+    return digest.FinalToMessage();
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,203 @@
+#include "libringsign/multi_scalar_mul.h"
+#include "libringsign/crypto_pool.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+namespace {
+
+// 局部使用的点数组，从 ScopedArena 借出，作用域结束时统一归还
+struct PointArray {
+    std::vector<EC_POINT*>& points;
+
+    PointArray(ScopedArena& arena, size_t count) : points(arena.List<EC_POINT*>()) {
+        points.reserve(count);
+        for (size_t i = 0; i < count; ++i) points.push_back(arena.Point());
+    }
+
+    EC_POINT* operator[](size_t i) const { return points[i]; }
+};
+
+// 从小端字节序标量中取出从 offset 位开始的 width 位
+inline unsigned int get_window(const unsigned char* k, size_t len, int offset, int width) {
+    unsigned int value = 0;
+    for (int b = 0; b < width; ++b) {
+        int bit = offset + b;
+        size_t byte = static_cast<size_t>(bit >> 3);
+        if (byte >= len) break;
+        value |= static_cast<unsigned int>((k[byte] >> (bit & 7)) & 1) << b;
+    }
+    return value;
+}
+
+inline void check(int ok, const char* what) {
+    if (!ok) {
+        throw std::runtime_error(what);
+    }
+}
+
+} // namespace
+
+// Pippenger 代价估计：ceil(bits / c) 个窗口，每个窗口 n 次入桶加法 + 2^(c+1) 次桶汇总加法
+static double pippenger_cost(size_t n, int bits, int c) {
+    double windows = static_cast<double>((bits + c - 1) / c);
+    return windows * (static_cast<double>(n) + static_cast<double>(1u << (c + 1)));
+}
+
+int MultiScalarMul::PippengerWindow(size_t n, int bits) {
+    int best_c = 1;
+    for (int c = 2; c <= 16; ++c) {
+        if (pippenger_cost(n, bits, c) < pippenger_cost(n, bits, best_c)) {
+            best_c = c;
+        }
+    }
+    return best_c;
+}
+
+
+void MultiScalarMul::Compute(const EC_GROUP* group, EC_POINT* r,
+                             const std::vector<const EC_POINT*>& points,
+                             const std::vector<const BIGNUM*>& scalars,
+                             BN_CTX* ctx) {
+    if (points.size() != scalars.size()) {
+        throw std::invalid_argument("Point and scalar counts differ");
+    }
+
+    const BIGNUM* order = EC_GROUP_get0_order(group);
+    int bits = BN_num_bits(order);
+    int len = BN_num_bytes(order);
+
+    // 将标量模群阶约化后转为小端字节串，跳过零标量；临时数组与点均从线程局部的分配器借出
+    ScopedArena arena(group);
+    std::vector<const EC_POINT*>& active_points = arena.List<const EC_POINT*>();
+    std::vector<unsigned char>& digits = arena.List<unsigned char>();
+    active_points.reserve(points.size());
+    digits.resize(points.size() * len);
+
+    BN_CTX_start(ctx);
+    BIGNUM* k = BN_CTX_get(ctx);
+    if (!k) {
+        BN_CTX_end(ctx);
+        throw std::runtime_error("Failed to allocate BIGNUM");
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (!BN_nnmod(k, scalars[i], order, ctx)) {
+            BN_CTX_end(ctx);
+            throw std::runtime_error("Failed to reduce scalar");
+        }
+        if (BN_is_zero(k) || EC_POINT_is_at_infinity(group, points[i])) continue;
+        BN_bn2lebinpad(k, digits.data() + active_points.size() * len, len);
+        active_points.push_back(points[i]);
+    }
+    BN_CTX_end(ctx);
+
+    if (active_points.empty()) {
+        check(EC_POINT_set_to_infinity(group, r), "Failed to set point to infinity");
+        return;
+    }
+
+    if (active_points.size() <= kStrausThreshold) {
+        straus(group, r, active_points, digits.data(), len, bits, ctx);
+    } else {
+        pippenger(group, r, active_points, digits.data(), len, bits, ctx);
+    }
+}
+
+void MultiScalarMul::straus(const EC_GROUP* group, EC_POINT* r,
+                            const std::vector<const EC_POINT*>& points,
+                            const unsigned char* digits, size_t len,
+                            int bits, BN_CTX* ctx) {
+    const int w = kStrausWindow;
+    const size_t table_size = (1u << w) - 1;  // 存储 1P .. 15P
+    size_t n = points.size();
+
+    // 预计算每个点的 j * P_i，j = 1 .. 2^w - 1
+    ScopedArena arena(group);
+    PointArray table(arena, n * table_size);
+    for (size_t i = 0; i < n; ++i) {
+        EC_POINT* row = table[i * table_size];
+        check(EC_POINT_copy(row, points[i]), "Failed to copy point");
+        for (size_t j = 1; j < table_size; ++j) {
+            check(EC_POINT_add(group, table[i * table_size + j], table[i * table_size + j - 1], points[i], ctx),
+                  "Failed to build Straus table");
+        }
+    }
+
+    // 交错处理所有标量：每个窗口共享 w 次倍点
+    EC_POINT* acc = arena.Point();
+    int windows = (bits + w - 1) / w;
+    for (int win = windows - 1; win >= 0; --win) {
+        if (win != windows - 1) {
+            for (int d = 0; d < w; ++d) {
+                check(EC_POINT_dbl(group, acc, acc, ctx), "Failed to double point");
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            unsigned int digit = get_window(digits + i * len, len, win * w, w);
+            if (digit == 0) continue;
+            check(EC_POINT_add(group, acc, acc, table[i * table_size + digit - 1], ctx),
+                  "Failed to add point");
+        }
+    }
+    check(EC_POINT_copy(r, acc), "Failed to copy point");
+}
+
+void MultiScalarMul::pippenger(const EC_GROUP* group, EC_POINT* r,
+                               const std::vector<const EC_POINT*>& points,
+                               const unsigned char* digits, size_t len,
+                               int bits, BN_CTX* ctx) {
+    const int c = PippengerWindow(points.size(), bits);
+    const size_t bucket_count = (1u << c) - 1;  // 桶 j 存放数字为 j + 1 的点之和
+    size_t n = points.size();
+
+    ScopedArena arena(group);
+    PointArray buckets(arena, bucket_count);
+    EC_POINT* acc = arena.Point();
+    EC_POINT* running = arena.Point();
+    EC_POINT* window_sum = arena.Point();
+    std::vector<unsigned char>& used = arena.List<unsigned char>();
+    used.resize(bucket_count);
+
+    check(EC_POINT_set_to_infinity(group, acc), "Failed to set point to infinity");
+    int windows = (bits + c - 1) / c;
+    for (int win = windows - 1; win >= 0; --win) {
+        if (win != windows - 1) {
+            for (int d = 0; d < c; ++d) {
+                check(EC_POINT_dbl(group, acc, acc, ctx), "Failed to double point");
+            }
+        }
+
+        // 按当前窗口的数字将点放入桶中
+        std::fill(used.begin(), used.end(), 0);
+        for (size_t i = 0; i < n; ++i) {
+            unsigned int digit = get_window(digits + i * len, len, win * c, c);
+            if (digit == 0) continue;
+            EC_POINT* bucket = buckets[digit - 1];
+            if (!used[digit - 1]) {
+                check(EC_POINT_copy(bucket, points[i]), "Failed to copy point");
+                used[digit - 1] = 1;
+            } else {
+                check(EC_POINT_add(group, bucket, bucket, points[i], ctx), "Failed to add point");
+            }
+        }
+
+        // 汇总：Σ j * B_j = Σ_{j} (B_top + ... + B_j)
+        check(EC_POINT_set_to_infinity(group, running), "Failed to set point to infinity");
+        check(EC_POINT_set_to_infinity(group, window_sum), "Failed to set point to infinity");
+        bool any = false;
+        for (size_t j = bucket_count; j-- > 0;) {
+            if (used[j]) {
+                check(EC_POINT_add(group, running, running, buckets[j], ctx), "Failed to add point");
+                any = true;
+            }
+            if (any) {
+                check(EC_POINT_add(group, window_sum, window_sum, running, ctx), "Failed to add point");
+            }
+        }
+        check(EC_POINT_add(group, acc, acc, window_sum, ctx), "Failed to add point");
+    }
+    check(EC_POINT_copy(r, acc), "Failed to copy point");
+}
+
+} // namespace ring_signature_lib
@@ -1,18 +1,26 @@
 #include "libringsign/network_utils.h"
 #include <stdexcept>
 #include <cstring>
+#include <cerrno>
+#include <cstdint>
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #pragma comment(lib, "ws2_32.lib")
 #else
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <unistd.h>
 #endif
 
-TCPServer::TCPServer(const std::string& ip, int port) {
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+TCPServer::TCPServer(const std::string& ip, int port, int backlog) {
 #ifdef _WIN32
     WSADATA wsaData;
     WSAStartup(MAKEWORD(2,2), &wsaData);
@@ -43,10 +51,17 @@ TCPServer::TCPServer(const std::string& ip, int port) {
     addr.sin_port = htons(port);
     if (bind(server_fd_, (sockaddr*)&addr, sizeof(addr)) < 0)
         throw std::runtime_error("bind() failed");
-    if (listen(server_fd_, 5) < 0)
+    if (listen(server_fd_, backlog) < 0)
         throw std::runtime_error("listen() failed");
 }
 TCPServer::~TCPServer() { CloseServer(); }
+int TCPServer::Port() const {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (getsockname(server_fd_, (sockaddr*)&addr, &len) < 0)
+        throw std::runtime_error("getsockname() failed");
+    return ntohs(addr.sin_port);
+}
 int TCPServer::Accept() {
     sockaddr_in client_addr{};
     socklen_t len = sizeof(client_addr);
@@ -121,10 +136,141 @@ std::string TCPClient::Recv() {
     return std::string(buf, n);
 }
 void TCPClient::Close() {
+    if (sock_fd_ < 0) return;
 #ifdef _WIN32
     closesocket(sock_fd_);
     WSACleanup();
 #else
     close(sock_fd_);
 #endif
-} 
\ No newline at end of file
+    sock_fd_ = -1;
+}
+
+namespace {
+
+// 循环写入直到全部发送；对端已关闭时抛出异常而不是触发 SIGPIPE
+void send_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        int n = send(fd, data, (int)len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error("send() failed");
+        data += n;
+        len -= n;
+    }
+}
+
+// 循环读取 len 字节；一个字节都未读到时对端关闭返回 false，读到一部分后关闭抛出异常
+bool recv_all(int fd, char* data, size_t len) {
+    size_t received = 0;
+    while (received < len) {
+        int n = recv(fd, data + received, (int)(len - received), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) throw std::runtime_error("recv() failed");
+        if (n == 0) {
+            if (received == 0) return false;
+            throw std::runtime_error("Connection closed in the middle of a frame");
+        }
+        received += n;
+    }
+    return true;
+}
+
+} // namespace
+
+void SendFrame(int fd, std::string_view payload) {
+    if (payload.size() > UINT32_MAX) throw std::runtime_error("Frame too large");
+    uint32_t len = (uint32_t)payload.size();
+    unsigned char header[4] = {(unsigned char)(len >> 24), (unsigned char)(len >> 16),
+                               (unsigned char)(len >> 8), (unsigned char)len};
+    send_all(fd, (const char*)header, sizeof(header));
+    send_all(fd, payload.data(), payload.size());
+}
+
+bool RecvFrame(int fd, std::string& payload, size_t max_size) {
+    unsigned char header[4];
+    if (!recv_all(fd, (char*)header, sizeof(header))) return false;
+    size_t len = ((size_t)header[0] << 24) | ((size_t)header[1] << 16) | ((size_t)header[2] << 8) | header[3];
+    if (len > max_size) throw std::runtime_error("Frame exceeds size limit");
+    payload.resize(len);
+    if (len > 0 && !recv_all(fd, &payload[0], len)) {
+        throw std::runtime_error("Connection closed in the middle of a frame");
+    }
+    return true;
+}
+
+#ifndef _WIN32
+namespace {
+
+sockaddr_un unix_address(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error("Invalid Unix socket path: " + path);
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+} // namespace
+
+UnixSocketServer::UnixSocketServer(const std::string& path, int backlog) : server_fd_(-1), path_(path) {
+    sockaddr_un addr = unix_address(path);
+    // 已有文件时：仍有服务在监听则拒绝启动，不是套接字则不删除；否则为上次异常退出的残留
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) throw std::runtime_error("Path exists and is not a socket: " + path);
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe < 0) throw std::runtime_error("socket() failed");
+        bool live = connect(probe, (sockaddr*)&addr, sizeof(addr)) == 0;
+        close(probe);
+        if (live) throw std::runtime_error("Socket already in use: " + path);
+        unlink(path.c_str());
+    }
+    server_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_fd_ < 0) throw std::runtime_error("socket() failed");
+    if (bind(server_fd_, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(server_fd_);
+        throw std::runtime_error("bind() failed: " + path);
+    }
+    // 套接字文件的权限受 umask 影响，listen 之前收紧为仅属主可连接
+    if (chmod(path.c_str(), 0600) < 0) {
+        CloseServer();
+        throw std::runtime_error("chmod() failed: " + path);
+    }
+    if (listen(server_fd_, backlog) < 0) {
+        CloseServer();
+        throw std::runtime_error("listen() failed");
+    }
+}
+UnixSocketServer::~UnixSocketServer() { CloseServer(); }
+int UnixSocketServer::Accept() {
+    int client_fd;
+    do {
+        client_fd = accept(server_fd_, nullptr, nullptr);
+    } while (client_fd < 0 && errno == EINTR);
+    if (client_fd < 0) throw std::runtime_error("accept() failed");
+    return client_fd;
+}
+void UnixSocketServer::Close(int client_fd) { close(client_fd); }
+void UnixSocketServer::CloseServer() {
+    if (server_fd_ < 0) return;
+    close(server_fd_);
+    unlink(path_.c_str());
+    server_fd_ = -1;
+}
+
+UnixSocketClient::UnixSocketClient(const std::string& path) : path_(path) {
+    sock_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock_fd_ < 0) throw std::runtime_error("socket() failed");
+}
+UnixSocketClient::~UnixSocketClient() { Close(); }
+void UnixSocketClient::Connect() {
+    sockaddr_un addr = unix_address(path_);
+    if (connect(sock_fd_, (sockaddr*)&addr, sizeof(addr)) < 0)
+        throw std::runtime_error("connect() failed: " + path_);
+}
+void UnixSocketClient::Close() {
+    if (sock_fd_ < 0) return;
+    close(sock_fd_);
+    sock_fd_ = -1;
+}
+#endif
@@ -0,0 +1,197 @@
+// EC_POINTs_make_affine 在 OpenSSL 3.0 中标记为弃用，但仍是批量仿射化的唯一公开接口
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include "libringsign/precompute.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+FixedBaseTable::FixedBaseTable(const EC_GROUP* group, const EC_POINT* base, int teeth)
+    : group_(group), base_(nullptr), teeth_(teeth), spacing_(0) {
+    if (teeth < 1 || teeth > 12) {
+        throw std::invalid_argument("Unsupported comb teeth count");
+    }
+    int bits = BN_num_bits(EC_GROUP_get0_order(group_));
+    spacing_ = (bits + teeth_ - 1) / teeth_;
+
+    base_ = EC_POINT_dup(base, group_);
+    BN_CTX* ctx = BN_CTX_new();
+    if (!base_ || !ctx) {
+        EC_POINT_free(base_);
+        BN_CTX_free(ctx);
+        throw std::runtime_error("Failed to allocate fixed-base table");
+    }
+
+    // teeth[k] = 2^(k*d) * base
+    std::vector<EC_POINT*> tooth(teeth_, nullptr);
+    table_.assign((1u << teeth_) - 1, nullptr);
+    bool ok = true;
+    for (int k = 0; k < teeth_ && ok; ++k) {
+        tooth[k] = EC_POINT_new(group_);
+        ok = tooth[k] && EC_POINT_copy(tooth[k], k == 0 ? base_ : tooth[k - 1]);
+        for (int i = 0; k > 0 && i < spacing_ && ok; ++i) {
+            ok = EC_POINT_dbl(group_, tooth[k], tooth[k], ctx);
+        }
+    }
+
+    // table[j - 1] = Σ_{bit k of j} teeth[k]，按最高位递推：table[j] = table[j - 2^k] + teeth[k]
+    for (size_t j = 1; j < (1u << teeth_) && ok; ++j) {
+        EC_POINT* entry = EC_POINT_new(group_);
+        table_[j - 1] = entry;
+        int top = 0;
+        while ((j >> (top + 1)) != 0) ++top;
+        size_t rest = j & ~(static_cast<size_t>(1) << top);
+        ok = entry && (rest == 0 ? EC_POINT_copy(entry, tooth[top])
+                                 : EC_POINT_add(group_, entry, table_[rest - 1], tooth[top], ctx));
+    }
+
+    // 统一转为仿射坐标，使查表后的加法为混合加法
+    ok = ok && EC_POINTs_make_affine(group_, table_.size(), table_.data(), ctx);
+
+    for (auto* p : tooth) EC_POINT_free(p);
+    BN_CTX_free(ctx);
+    if (!ok) {
+        for (auto* p : table_) EC_POINT_free(p);
+        EC_POINT_free(base_);
+        throw std::runtime_error("Failed to build fixed-base table");
+    }
+}
+
+FixedBaseTable::~FixedBaseTable() {
+    for (auto* p : table_) EC_POINT_free(p);
+    EC_POINT_free(base_);
+}
+
+void FixedBaseTable::Mul(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const {
+    if (!ctx) {
+        ScopedBnCtx local_ctx;
+        Mul(r, k, local_ctx.get());
+        return;
+    }
+
+    const BIGNUM* order = EC_GROUP_get0_order(group_);
+    int len = BN_num_bytes(order);
+    unsigned char bytes[kMaxScalarBytes];
+    if (len > kMaxScalarBytes) {
+        throw std::runtime_error("Group order too large for fixed-base multiplication");
+    }
+
+    BN_CTX_start(ctx);
+    BIGNUM* reduced = BN_CTX_get(ctx);
+    bool ok = reduced && BN_nnmod(reduced, k, order, ctx) &&
+              BN_bn2lebinpad(reduced, bytes, len) == len;
+    BN_CTX_end(ctx);
+    if (!ok) {
+        throw std::runtime_error("Failed to prepare scalar for fixed-base multiplication");
+    }
+
+    auto bit = [&bytes, len](int i) -> unsigned int {
+        int byte = i >> 3;
+        return byte < len ? (bytes[byte] >> (i & 7)) & 1 : 0;
+    };
+
+    // 从高到低处理 d 列，每列取出 t 个齿对应的位组成表索引
+    ok = EC_POINT_set_to_infinity(group_, r);
+    for (int i = spacing_ - 1; i >= 0 && ok; --i) {
+        if (!EC_POINT_is_at_infinity(group_, r)) {
+            ok = EC_POINT_dbl(group_, r, r, ctx);
+        }
+        unsigned int index = 0;
+        for (int t = 0; t < teeth_; ++t) {
+            index |= bit(t * spacing_ + i) << t;
+        }
+        if (index != 0 && ok) {
+            ok = EC_POINT_add(group_, r, r, table_[index - 1], ctx);
+        }
+    }
+    if (!ok) {
+        throw std::runtime_error("Fixed-base multiplication failed");
+    }
+}
+
+void FixedBaseTable::MulSecret(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const {
+    if (!ctx) {
+        ScopedBnCtx local_ctx;
+        MulSecret(r, k, local_ctx.get());
+        return;
+    }
+    if (!EC_POINT_mul(group_, r, nullptr, base_, k, ctx)) {
+        throw std::runtime_error("Fixed-base multiplication failed");
+    }
+}
+
+PrecomputeCache::PrecomputeCache(const EC_GROUP* group, const EC_POINT* system_public_key,
+                                 const HashUtils& event_hash, size_t event_capacity, const EcBackend* backend)
+    : group_(EC_GROUP_dup(group)),
+      event_hash_(event_hash),
+      backend_(backend),
+      event_capacity_(event_capacity == 0 ? 1 : event_capacity) {
+    if (!group_) {
+        throw std::runtime_error("Failed to copy EC group");
+    }
+    generator_ = new_table(EC_GROUP_get0_generator(group_.get()));
+    system_public_key_ = new_table(system_public_key);
+}
+
+std::unique_ptr<EcBackend::FixedBase> PrecomputeCache::new_table(const EC_POINT* base) const {
+    if (backend_) {
+        return backend_->NewFixedBase(group_.get(), base, FixedBaseTable::kDefaultTeeth);
+    }
+    return std::unique_ptr<EcBackend::FixedBase>(new FixedBaseTable(group_.get(), base));
+}
+
+std::shared_ptr<const EcBackend::FixedBase> PrecomputeCache::EventTable(const std::string& event) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = events_.find(event);
+        if (it != events_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);  // 移到表头
+            ++hits_;
+            return it->second->second;
+        }
+    }
+    ++misses_;
+
+    // 在锁外构建新表：E = H_0(event) * G
+    BnPtr event_scalar(event_hash_.hashToBn(event));
+    EcPointPtr E(EC_POINT_new(group_.get()));
+    if (!E) {
+        throw std::runtime_error("Failed to allocate event point");
+    }
+    generator_->Mul(E.get(), event_scalar.get(), nullptr);
+    std::shared_ptr<const EcBackend::FixedBase> table = new_table(E.get());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = events_.find(event);
+    if (it != events_.end()) {
+        // 其他线程已插入同一事件
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+    }
+    lru_.emplace_front(event, table);
+    events_[event] = lru_.begin();
+    evict_locked();
+    return table;
+}
+
+void PrecomputeCache::SetEventCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    event_capacity_ = capacity == 0 ? 1 : capacity;
+    evict_locked();
+}
+
+PrecomputeCache::Stats PrecomputeCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {hits_.load(), misses_.load(), evictions_.load(), lru_.size(), event_capacity_};
+}
+
+void PrecomputeCache::evict_locked() {
+    while (lru_.size() > event_capacity_) {
+        events_.erase(lru_.back().first);
+        lru_.pop_back();
+        ++evictions_;
+    }
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,222 @@
+#include "libringsign/ring_context.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/keystore.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+RingContext::RingContext(const EC_GROUP* group, const EC_POINT* system_public_key, const HashUtils& id_hash,
+                         int transcript_version, const std::vector<Member>& members,
+                         const EcBackend::FixedBase* system_public_key_table, bool combine, ThreadPool* pool)
+    : group_(group), combined_(combine) {
+    // 按 ID 字符串字典序排序，并检查重复 ID
+    std::vector<const Member*> sorted;
+    sorted.reserve(members.size());
+    for (const auto& member : members) sorted.push_back(&member);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Member* lhs, const Member* rhs) { return lhs->first < rhs->first; });
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i]->first == sorted[i - 1]->first) {
+            throw std::invalid_argument("Duplicate ID found in ring members.");
+        }
+    }
+
+    // 成员之间相互独立，可按分块并行计算，每个分块使用独立的 BN_CTX 与临时点
+    entries_.resize(sorted.size());
+    auto build_chunk = [&](size_t, size_t begin, size_t end) {
+        ScopedBnCtx scoped_ctx;
+        BN_CTX* ctx = scoped_ctx.get();
+        EC_POINT* temp_point = EC_POINT_new(group_);
+        try {
+            if (!temp_point) {
+                throw std::runtime_error("Failed to allocate ring context");
+            }
+            PointEncoding ppub_enc = PointEncoding::Encode(group_, system_public_key, ctx);
+            // 调用方的公钥可能是射影坐标，编码前整块一次仿射化，代替每个点各一次域求逆
+            std::vector<EC_POINT*> keys;
+            keys.reserve(2 * (end - begin));
+            for (size_t i = begin; i < end; ++i) {
+                entries_[i].id = sorted[i]->first;
+                entries_[i].X = EC_POINT_dup(sorted[i]->second.first, group_);
+                entries_[i].Y = EC_POINT_dup(sorted[i]->second.second, group_);
+                if (!entries_[i].X || !entries_[i].Y) {
+                    throw std::runtime_error("Failed to copy ring member keys");
+                }
+                keys.push_back(entries_[i].X);
+                keys.push_back(entries_[i].Y);
+            }
+            MakeAffine(group_, keys.data(), keys.size(), ctx);
+            for (size_t i = begin; i < end; ++i) {
+                build_entry(entries_[i], system_public_key, ppub_enc, id_hash, transcript_version,
+                            system_public_key_table, temp_point, ctx);
+            }
+            normalize_points(begin, end, ctx);
+        } catch (...) {
+            EC_POINT_free(temp_point);
+            throw;
+        }
+        EC_POINT_free(temp_point);
+    };
+
+    try {
+        if (pool) {
+            pool->ParallelFor(sorted.size(), build_chunk, kMinMembersPerChunk);
+        } else {
+            build_chunk(0, 0, sorted.size());
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+RingContext::RingContext(const EC_GROUP* group, const Keystore& keystore, const std::vector<size_t>& indices,
+                         bool combine, ThreadPool* pool)
+    : group_(group), combined_(combine) {
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (indices[i] >= keystore.Size() || (i > 0 && indices[i] <= indices[i - 1])) {
+            throw std::invalid_argument("Keystore indices must be unique and sorted.");
+        }
+    }
+    size_t point_size = 1 + (static_cast<size_t>(EC_GROUP_get_degree(group)) + 7) / 8;
+    size_t scalar_size = static_cast<size_t>(BN_num_bytes(EC_GROUP_get0_order(group)));
+    if (keystore.PointSize() != point_size || keystore.ScalarSize() != scalar_size) {
+        throw std::invalid_argument("Keystore does not match the curve.");
+    }
+
+    entries_.resize(indices.size());
+    auto load_chunk = [&](size_t, size_t begin, size_t end) {
+        ScopedBnCtx scoped_ctx;
+        for (size_t i = begin; i < end; ++i) {
+            load_entry(entries_[i], keystore, indices[i], scoped_ctx.get());
+        }
+        normalize_points(begin, end, scoped_ctx.get());
+    };
+    try {
+        if (pool) {
+            pool->ParallelFor(indices.size(), load_chunk, kMinMembersPerChunk);
+        } else {
+            load_chunk(0, 0, indices.size());
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+void RingContext::load_entry(Entry& entry, const Keystore& keystore, size_t index, BN_CTX* ctx) {
+    auto decode_point = [&](std::string_view bytes) {
+        EC_POINT* point = EC_POINT_new(group_);
+        if (!point || !EC_POINT_oct2point(group_, point, reinterpret_cast<const unsigned char*>(bytes.data()),
+                                          bytes.size(), ctx)) {
+            EC_POINT_free(point);
+            throw std::runtime_error("Invalid point in keystore");
+        }
+        return point;
+    };
+    entry.id = std::string(keystore.Id(index));
+    entry.X = decode_point(keystore.X(index));
+    entry.Y = decode_point(keystore.Y(index));
+    entry.XY = EC_POINT_new(group_);
+    if (!entry.XY || !EC_POINT_add(group_, entry.XY, entry.X, entry.Y, ctx)) {
+        throw std::runtime_error("Failed to copy ring member keys");
+    }
+    entry.X_enc = PointEncoding::Encode(group_, entry.X, ctx);
+    entry.Y_enc = PointEncoding::Encode(group_, entry.Y, ctx);
+    std::string_view h = keystore.H(index);
+    entry.h = BN_bin2bn(reinterpret_cast<const unsigned char*>(h.data()), static_cast<int>(h.size()), nullptr);
+    if (!entry.h) {
+        throw std::runtime_error("Failed to decode keystore scalar");
+    }
+    if (combined_) {
+        entry.K = decode_point(keystore.K(index));
+    }
+}
+
+void RingContext::normalize_points(size_t begin, size_t end, BN_CTX* ctx) {
+    // 多标量乘法中可使用混合加法；各分块在自己的线程上仿射化
+    std::vector<EC_POINT*> bases;
+    bases.reserve((end - begin) * 2);
+    for (size_t i = begin; i < end; ++i) {
+        bases.push_back(entries_[i].XY);
+        if (entries_[i].K) bases.push_back(entries_[i].K);
+    }
+    MakeAffine(group_, bases.data(), bases.size(), ctx);
+}
+
+void RingContext::build_entry(Entry& entry, const EC_POINT* system_public_key, const PointEncoding& ppub_enc,
+                              const HashUtils& id_hash, int transcript_version,
+                              const EcBackend::FixedBase* system_public_key_table, EC_POINT* temp_point, BN_CTX* ctx) {
+    entry.XY = EC_POINT_new(group_);
+    if (!entry.XY || !EC_POINT_add(group_, entry.XY, entry.X, entry.Y, ctx)) {
+        throw std::runtime_error("Failed to copy ring member keys");
+    }
+    entry.X_enc = PointEncoding::Encode(group_, entry.X, ctx);
+    entry.Y_enc = PointEncoding::Encode(group_, entry.Y, ctx);
+
+    // h_i = H_1(ID_i || X_i || P_pub)
+    Transcript transcript(id_hash, transcript_version);
+    transcript.AppendString(entry.id);
+    transcript.AppendPoint(entry.X_enc);
+    transcript.AppendPoint(ppub_enc);
+    entry.h = transcript.FinalToBn();
+
+    if (!combined_) return;
+
+    // K_i = X_i + Y_i + h_i * P_pub
+    entry.K = EC_POINT_new(group_);
+    if (!entry.K) {
+        throw std::runtime_error("Failed to allocate combined ring point");
+    }
+    if (system_public_key_table) {
+        system_public_key_table->Mul(temp_point, entry.h, ctx);
+    } else if (!EC_POINT_mul(group_, temp_point, nullptr, system_public_key, entry.h, ctx)) {
+        throw std::runtime_error("Failed to compute h_i * P_pub");
+    }
+    if (!EC_POINT_add(group_, entry.K, entry.XY, temp_point, ctx)) {
+        throw std::runtime_error("Failed to compute combined ring point");
+    }
+}
+
+RingContext::~RingContext() {
+    release();
+}
+
+RingContext::RingContext(RingContext&& other) noexcept
+    : group_(other.group_), entries_(std::move(other.entries_)), combined_(other.combined_) {
+    other.entries_.clear();
+}
+
+RingContext& RingContext::operator=(RingContext&& other) noexcept {
+    if (this != &other) {
+        release();
+        group_ = other.group_;
+        entries_ = std::move(other.entries_);
+        combined_ = other.combined_;
+        other.entries_.clear();
+    }
+    return *this;
+}
+
+int RingContext::IndexOf(const std::string& id) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), id,
+                               [](const Entry& entry, const std::string& key) { return entry.id < key; });
+    if (it == entries_.end() || it->id != id) {
+        return -1;
+    }
+    return static_cast<int>(it - entries_.begin());
+}
+
+void RingContext::release() {
+    for (auto& entry : entries_) {
+        EC_POINT_free(entry.X);
+        EC_POINT_free(entry.Y);
+        EC_POINT_free(entry.XY);
+        EC_POINT_free(entry.K);
+        BN_free(entry.h);
+    }
+    entries_.clear();
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,1054 @@
+// EC_POINT_get/set_Jprojective_coordinates_GFp 在 OpenSSL 3.0 中标记为弃用，但仍是不经求逆读写射影坐标的唯一公开接口
+#define OPENSSL_SUPPRESS_DEPRECATED
+#include "libringsign/secp256k1_backend.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include <openssl/obj_mac.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace ring_signature_lib {
+
+namespace {
+
+using u64 = uint64_t;
+using u128 = unsigned __int128;
+
+// ---------------------------------------------------------------------------
+// 域 F_p，p = 2^256 - 2^32 - 977。元素为小端的 4 个 64 位字，始终保持规范表示 [0, p)
+// ---------------------------------------------------------------------------
+
+struct Fe {
+    u64 n[4];
+};
+
+const u64 kP[4] = {0xFFFFFFFEFFFFFC2FULL, ~0ULL, ~0ULL, ~0ULL};
+const u64 kC = 0x1000003D1ULL;  // 2^256 - p，即 2^256 ≡ kC (mod p)
+
+inline Fe fe_zero() { return Fe{{0, 0, 0, 0}}; }
+inline Fe fe_one() { return Fe{{1, 0, 0, 0}}; }
+
+inline bool fe_is_zero(const Fe& a) { return (a.n[0] | a.n[1] | a.n[2] | a.n[3]) == 0; }
+
+inline bool fe_is_one(const Fe& a) { return a.n[0] == 1 && (a.n[1] | a.n[2] | a.n[3]) == 0; }
+
+inline bool fe_equal(const Fe& a, const Fe& b) {
+    return ((a.n[0] ^ b.n[0]) | (a.n[1] ^ b.n[1]) | (a.n[2] ^ b.n[2]) | (a.n[3] ^ b.n[3])) == 0;
+}
+
+// 把 s + carry * 2^256（值小于 2p）约化到 [0, p)：
+// carry = 1 时结果为 s + kC；否则 s ≥ p 当且仅当 s + kC 溢出，此时结果为 s + kC 的低 256 位
+inline void fe_fold(Fe& r, const u64 s[4], u64 carry) {
+    u64 t[4];
+    u128 acc = static_cast<u128>(s[0]) + kC;
+    t[0] = static_cast<u64>(acc);
+    acc >>= 64;
+    for (int i = 1; i < 4; ++i) {
+        acc += s[i];
+        t[i] = static_cast<u64>(acc);
+        acc >>= 64;
+    }
+    // 按掩码选择，避免不可预测的分支
+    const u64 mask = 0 - ((carry | static_cast<u64>(acc)) & 1);
+    for (int i = 0; i < 4; ++i) r.n[i] = (t[i] & mask) | (s[i] & ~mask);
+}
+
+inline void fe_add(Fe& r, const Fe& a, const Fe& b) {
+    u64 s[4];
+    u128 acc = 0;
+    for (int i = 0; i < 4; ++i) {
+        acc += static_cast<u128>(a.n[i]) + b.n[i];
+        s[i] = static_cast<u64>(acc);
+        acc >>= 64;
+    }
+    fe_fold(r, s, static_cast<u64>(acc));
+}
+
+// a - b；借位时回绕值 a - b + 2^256 不小于 kC + 1，减去 kC 即得 a - b + p
+inline void fe_sub(Fe& r, const Fe& a, const Fe& b) {
+    u64 d[4];
+    u64 borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        u128 diff = static_cast<u128>(a.n[i]) - b.n[i] - borrow;
+        d[i] = static_cast<u64>(diff);
+        borrow = static_cast<u64>(diff >> 64) & 1;
+    }
+    if (borrow) {
+        u64 sub = kC;
+        for (int i = 0; i < 4; ++i) {
+            u128 diff = static_cast<u128>(d[i]) - sub;
+            d[i] = static_cast<u64>(diff);
+            sub = static_cast<u64>(diff >> 64) & 1;
+        }
+    }
+    for (int i = 0; i < 4; ++i) r.n[i] = d[i];
+}
+
+inline void fe_neg(Fe& r, const Fe& a) {
+    if (fe_is_zero(a)) {
+        r = a;
+        return;
+    }
+    Fe p{{kP[0], kP[1], kP[2], kP[3]}};
+    fe_sub(r, p, a);
+}
+
+// 三字累加器 (c0, c1, c2) += a * b
+inline void muladd(u64& c0, u64& c1, u64& c2, u64 a, u64 b) {
+    u128 x = static_cast<u128>(a) * b;
+    u64 lo = static_cast<u64>(x);
+    u64 hi = static_cast<u64>(x >> 64);
+    c0 += lo;
+    hi += (c0 < lo);
+    c1 += hi;
+    c2 += (c1 < hi);
+}
+
+// 三字累加器 (c0, c1, c2) += 2 * a * b
+inline void muladd2(u64& c0, u64& c1, u64& c2, u64 a, u64 b) {
+    muladd(c0, c1, c2, a, b);
+    muladd(c0, c1, c2, a, b);
+}
+
+// 累加器输出最低字并右移一个字
+inline u64 extract(u64& c0, u64& c1, u64& c2) {
+    u64 out = c0;
+    c0 = c1;
+    c1 = c2;
+    c2 = 0;
+    return out;
+}
+
+// 4 × 4 字的乘积，8 个字；按列累加（product scanning），每列只做一次进位传播
+inline void mul_4x4(u64 t[8], const u64 a[4], const u64 b[4]) {
+    u64 c0 = 0, c1 = 0, c2 = 0;
+    muladd(c0, c1, c2, a[0], b[0]);
+    t[0] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[0], b[1]);
+    muladd(c0, c1, c2, a[1], b[0]);
+    t[1] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[0], b[2]);
+    muladd(c0, c1, c2, a[1], b[1]);
+    muladd(c0, c1, c2, a[2], b[0]);
+    t[2] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[0], b[3]);
+    muladd(c0, c1, c2, a[1], b[2]);
+    muladd(c0, c1, c2, a[2], b[1]);
+    muladd(c0, c1, c2, a[3], b[0]);
+    t[3] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[1], b[3]);
+    muladd(c0, c1, c2, a[2], b[2]);
+    muladd(c0, c1, c2, a[3], b[1]);
+    t[4] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[2], b[3]);
+    muladd(c0, c1, c2, a[3], b[2]);
+    t[5] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[3], b[3]);
+    t[6] = c0;
+    t[7] = c1;
+}
+
+// 512 位乘积按 2^256 ≡ kC 折叠两次，再做一次条件减法
+inline void fe_reduce(Fe& r, const u64 t[8]) {
+    u64 s[4];
+    u128 acc = 0;
+    for (int i = 0; i < 4; ++i) {
+        acc += static_cast<u128>(t[i + 4]) * kC + t[i];
+        s[i] = static_cast<u64>(acc);
+        acc >>= 64;
+    }
+    // 第一次折叠后的高位不超过 2^34，乘以 kC 后不超过 2^67
+    acc = static_cast<u128>(static_cast<u64>(acc)) * kC;
+    for (int i = 0; i < 4; ++i) {
+        acc += s[i];
+        s[i] = static_cast<u64>(acc);
+        acc >>= 64;
+    }
+    fe_fold(r, s, static_cast<u64>(acc));
+}
+
+inline void fe_mul(Fe& r, const Fe& a, const Fe& b) {
+    u64 t[8];
+    mul_4x4(t, a.n, b.n);
+    fe_reduce(r, t);
+}
+
+// 平方：交叉项只算一次乘法再加倍
+inline void fe_sqr(Fe& r, const Fe& x) {
+    const u64* a = x.n;
+    u64 t[8];
+    u64 c0 = 0, c1 = 0, c2 = 0;
+    muladd(c0, c1, c2, a[0], a[0]);
+    t[0] = extract(c0, c1, c2);
+    muladd2(c0, c1, c2, a[0], a[1]);
+    t[1] = extract(c0, c1, c2);
+    muladd2(c0, c1, c2, a[0], a[2]);
+    muladd(c0, c1, c2, a[1], a[1]);
+    t[2] = extract(c0, c1, c2);
+    muladd2(c0, c1, c2, a[0], a[3]);
+    muladd2(c0, c1, c2, a[1], a[2]);
+    t[3] = extract(c0, c1, c2);
+    muladd2(c0, c1, c2, a[1], a[3]);
+    muladd(c0, c1, c2, a[2], a[2]);
+    t[4] = extract(c0, c1, c2);
+    muladd2(c0, c1, c2, a[2], a[3]);
+    t[5] = extract(c0, c1, c2);
+    muladd(c0, c1, c2, a[3], a[3]);
+    t[6] = c0;
+    t[7] = c1;
+    fe_reduce(r, t);
+}
+
+inline void fe_sqr_n(Fe& r, const Fe& a, int n) {
+    r = a;
+    for (int i = 0; i < n; ++i) fe_sqr(r, r);
+}
+
+// a^(p - 2)。p - 2 的二进制由长度为 223、22、1、2、1 的全 1 段组成，
+// 先用加法链求出 a^(2^k - 1)（k = 2, 3, 6, 9, 11, 22, 44, 88, 176, 220, 223），再按段拼接
+void fe_inv(Fe& r, const Fe& a) {
+    Fe x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+    fe_sqr(x2, a);
+    fe_mul(x2, x2, a);
+    fe_sqr(x3, x2);
+    fe_mul(x3, x3, a);
+    fe_sqr_n(x6, x3, 3);
+    fe_mul(x6, x6, x3);
+    fe_sqr_n(x9, x6, 3);
+    fe_mul(x9, x9, x3);
+    fe_sqr_n(x11, x9, 2);
+    fe_mul(x11, x11, x2);
+    fe_sqr_n(x22, x11, 11);
+    fe_mul(x22, x22, x11);
+    fe_sqr_n(x44, x22, 22);
+    fe_mul(x44, x44, x22);
+    fe_sqr_n(x88, x44, 44);
+    fe_mul(x88, x88, x44);
+    fe_sqr_n(x176, x88, 88);
+    fe_mul(x176, x176, x88);
+    fe_sqr_n(x220, x176, 44);
+    fe_mul(x220, x220, x44);
+    fe_sqr_n(x223, x220, 3);
+    fe_mul(x223, x223, x3);
+
+    fe_sqr_n(t, x223, 23);
+    fe_mul(t, t, x22);
+    fe_sqr_n(t, t, 5);
+    fe_mul(t, t, a);
+    fe_sqr_n(t, t, 3);
+    fe_mul(t, t, x2);
+    fe_sqr_n(t, t, 2);
+    fe_mul(r, t, a);
+}
+
+inline void load_le(u64 out[4], const unsigned char bytes[32]) {
+    for (int i = 0; i < 4; ++i) {
+        u64 limb = 0;
+        for (int b = 7; b >= 0; --b) limb = (limb << 8) | bytes[8 * i + b];
+        out[i] = limb;
+    }
+}
+
+inline void store_le(unsigned char bytes[32], const u64 in[4]) {
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 8; ++b) bytes[8 * i + b] = static_cast<unsigned char>(in[i] >> (8 * b));
+    }
+}
+
+// 读取不超过 256 位的非负整数
+bool limbs_from_bn(u64 out[4], const BIGNUM* bn) {
+    unsigned char bytes[32];
+    if (BN_is_negative(bn) || BN_bn2lebinpad(bn, bytes, 32) != 32) return false;
+    load_le(out, bytes);
+    return true;
+}
+
+bool limbs_to_bn(BIGNUM* bn, const u64 in[4]) {
+    unsigned char bytes[32];
+    store_le(bytes, in);
+    return BN_lebin2bn(bytes, 32, bn) != nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// 点：仿射坐标 Ge 与 Jacobian 坐标 Gej（x = X / Z^2，y = Y / Z^3），曲线 y^2 = x^3 + 7
+// ---------------------------------------------------------------------------
+
+struct Ge {
+    Fe x, y;
+    bool infinity;
+};
+
+struct Gej {
+    Fe x, y, z;
+    bool infinity;
+};
+
+inline void gej_set_infinity(Gej& r) {
+    r.x = fe_zero();
+    r.y = fe_zero();
+    r.z = fe_zero();
+    r.infinity = true;
+}
+
+inline void gej_set_ge(Gej& r, const Ge& a) {
+    r.x = a.x;
+    r.y = a.y;
+    r.z = fe_one();
+    r.infinity = a.infinity;
+}
+
+inline void ge_neg(Ge& r, const Ge& a) {
+    r.x = a.x;
+    fe_neg(r.y, a.y);
+    r.infinity = a.infinity;
+}
+
+// dbl-2009-l（a = 0）：A = X^2，B = Y^2，C = B^2，D = 2((X + B)^2 - A - C)，E = 3A，
+// X3 = E^2 - 2D，Y3 = E(D - X3) - 8C，Z3 = 2YZ
+void gej_double(Gej& r, const Gej& a) {
+    if (a.infinity || fe_is_zero(a.y)) {
+        gej_set_infinity(r);
+        return;
+    }
+    Fe A, B, C, D, E, t;
+    fe_sqr(A, a.x);
+    fe_sqr(B, a.y);
+    fe_sqr(C, B);
+    fe_add(t, a.x, B);
+    fe_sqr(t, t);
+    fe_sub(t, t, A);
+    fe_sub(t, t, C);
+    fe_add(D, t, t);
+    fe_add(E, A, A);
+    fe_add(E, E, A);
+    Fe z3;
+    fe_mul(z3, a.y, a.z);
+    fe_add(r.z, z3, z3);
+    fe_sqr(t, E);
+    fe_sub(t, t, D);
+    fe_sub(r.x, t, D);
+    fe_sub(t, D, r.x);
+    fe_mul(t, E, t);
+    fe_add(C, C, C);
+    fe_add(C, C, C);
+    fe_add(C, C, C);
+    fe_sub(r.y, t, C);
+    r.infinity = false;
+}
+
+// 由 U1、S1、U2、S2 与 Z1 Z2 完成加法：H = U2 - U1，R = S2 - S1，
+// X3 = R^2 - H^3 - 2 U1 H^2，Y3 = R(U1 H^2 - X3) - S1 H^3，Z3 = Z1 Z2 H
+inline void gej_add_finish(Gej& r, const Gej& a, const Fe& u1, const Fe& s1, const Fe& u2, const Fe& s2,
+                           const Fe& zz) {
+    Fe H, R;
+    fe_sub(H, u2, u1);
+    fe_sub(R, s2, s1);
+    if (fe_is_zero(H)) {
+        if (fe_is_zero(R)) {
+            gej_double(r, a);
+        } else {
+            gej_set_infinity(r);
+        }
+        return;
+    }
+    Fe HH, HHH, V, t;
+    fe_sqr(HH, H);
+    fe_mul(HHH, H, HH);
+    fe_mul(V, u1, HH);
+    fe_mul(r.z, zz, H);
+    fe_sqr(t, R);
+    fe_sub(t, t, HHH);
+    fe_sub(t, t, V);
+    fe_sub(r.x, t, V);
+    fe_sub(t, V, r.x);
+    fe_mul(t, R, t);
+    fe_mul(HHH, s1, HHH);
+    fe_sub(r.y, t, HHH);
+    r.infinity = false;
+}
+
+// 混合加法 r = a + b（b 为仿射点），r 可与 a 相同
+void gej_add_ge(Gej& r, const Gej& a, const Ge& b) {
+    if (b.infinity) {
+        r = a;
+        return;
+    }
+    if (a.infinity) {
+        gej_set_ge(r, b);
+        return;
+    }
+    Fe z2, u2, s2;
+    fe_sqr(z2, a.z);
+    fe_mul(u2, b.x, z2);
+    fe_mul(s2, b.y, z2);
+    fe_mul(s2, s2, a.z);
+    Fe u1 = a.x;
+    Fe s1 = a.y;
+    Fe zz = a.z;
+    Gej copy = a;
+    gej_add_finish(r, copy, u1, s1, u2, s2, zz);
+}
+
+// 一般加法 r = a + b，r 可与 a 或 b 相同
+void gej_add(Gej& r, const Gej& a, const Gej& b) {
+    if (b.infinity) {
+        r = a;
+        return;
+    }
+    if (a.infinity) {
+        r = b;
+        return;
+    }
+    Fe z1z1, z2z2, u1, u2, s1, s2, zz;
+    fe_sqr(z1z1, a.z);
+    fe_sqr(z2z2, b.z);
+    fe_mul(u1, a.x, z2z2);
+    fe_mul(u2, b.x, z1z1);
+    fe_mul(s1, a.y, z2z2);
+    fe_mul(s1, s1, b.z);
+    fe_mul(s2, b.y, z1z1);
+    fe_mul(s2, s2, a.z);
+    fe_mul(zz, a.z, b.z);
+    Gej copy = a;
+    gej_add_finish(r, copy, u1, s1, u2, s2, zz);
+}
+
+// 批量转为仿射坐标：Montgomery 同时求逆，prefix 为调用方提供的 n 个临时元素。
+// Z = 1 的点与无穷远点不参与求逆
+void batch_to_affine(Ge* out, const Gej* in, size_t n, Fe* prefix) {
+    Fe acc = fe_one();
+    bool any = false;
+    for (size_t i = 0; i < n; ++i) {
+        if (in[i].infinity || fe_is_one(in[i].z)) continue;
+        prefix[i] = acc;
+        fe_mul(acc, acc, in[i].z);
+        any = true;
+    }
+    Fe inv;
+    if (any) fe_inv(inv, acc);
+    for (size_t i = n; i-- > 0;) {
+        out[i].infinity = in[i].infinity;
+        if (in[i].infinity) {
+            out[i].x = fe_zero();
+            out[i].y = fe_zero();
+            continue;
+        }
+        if (fe_is_one(in[i].z)) {
+            out[i].x = in[i].x;
+            out[i].y = in[i].y;
+            continue;
+        }
+        Fe zi, zi2, zi3;
+        fe_mul(zi, inv, prefix[i]);
+        fe_mul(inv, inv, in[i].z);
+        fe_sqr(zi2, zi);
+        fe_mul(zi3, zi2, zi);
+        fe_mul(out[i].x, in[i].x, zi2);
+        fe_mul(out[i].y, in[i].y, zi3);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 曲线常数与 GLV 分解
+// ---------------------------------------------------------------------------
+
+const char* const kFieldHex = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F";
+// λ 为 F_n 中的三次单位根，β 为 F_p 中对应的三次单位根：λ(x, y) = (βx, y)
+const char* const kLambdaHex = "5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72";
+const char* const kBetaHex = "7AE96A2B657C07106E64479EAC3434E99CF0497512F58995C1396C28719501EE";
+// 格基 v1 = (a1, b1)、v2 = (a2, b2)，满足 a_i + b_i λ ≡ 0 (mod n)；b1 < 0，b2 = a1
+const char* const kA1Hex = "3086D221A7D46BCDE86C90E49284EB15";
+const char* const kMinusB1Hex = "E4437ED6010E88286F547FA90ABFE4C3";
+const char* const kA2Hex = "114CA50F7A8E2F3F657C1108D9D44CFD8";
+
+// 半长标量的位数上界（含 wNAF 进位）
+const int kHalfBits = 136;
+// 变基点表的 wNAF 窗口：奇数倍点 1P, 3P, ..., 15P
+const int kWnafWindow = 5;
+const int kWnafTableSize = 1 << (kWnafWindow - 2);
+// 定基点表：5 位有符号窗口，每个窗口存 1..16 倍，256 位标量加进位共 53 个窗口
+const int kFixedWindow = 5;
+const int kFixedEntries = 1 << (kFixedWindow - 1);
+const int kFixedWindows = (256 + kFixedWindow - 1) / kFixedWindow + 1;
+// 原始点数不超过该值时用 Straus，否则用 Pippenger
+const size_t kStrausMaxPoints = 48;
+
+struct Constants {
+    Fe beta;
+    u64 g1[4];        // round(2^384 b2 / n)
+    u64 g2[4];        // round(2^384 (-b1) / n)
+    u64 a1[4];
+    u64 minus_b1[4];
+    u64 a2[4];
+};
+
+BnPtr bn_from_hex(const char* hex) {
+    BIGNUM* bn = nullptr;
+    if (!BN_hex2bn(&bn, hex)) {
+        throw std::runtime_error("Invalid secp256k1 constant");
+    }
+    return BnPtr(bn);
+}
+
+// 用 OpenSSL 核对硬编码的常数并计算 g1、g2，任一检查失败即抛出异常
+Constants make_constants() {
+    EcGroupPtr group(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+    BnPtr p(BN_new()), a(BN_new()), b(BN_new()), t(BN_new()), u(BN_new());
+    if (!group || !p || !a || !b || !t || !u || !EC_GROUP_get_curve(group.get(), p.get(), a.get(), b.get(), ctx)) {
+        throw std::runtime_error("Failed to load secp256k1 parameters");
+    }
+    const BIGNUM* n = EC_GROUP_get0_order(group.get());
+    BnPtr field = bn_from_hex(kFieldHex);
+    BnPtr lambda = bn_from_hex(kLambdaHex);
+    BnPtr beta = bn_from_hex(kBetaHex);
+    BnPtr a1 = bn_from_hex(kA1Hex);
+    BnPtr minus_b1 = bn_from_hex(kMinusB1Hex);
+    BnPtr a2 = bn_from_hex(kA2Hex);
+    bool ok = BN_cmp(p.get(), field.get()) == 0 && BN_is_zero(a.get()) && BN_is_word(b.get(), 7);
+
+    // λ^3 ≡ 1 (mod n)，β^3 ≡ 1 (mod p)
+    ok = ok && BN_mod_sqr(t.get(), lambda.get(), n, ctx) && BN_mod_mul(t.get(), t.get(), lambda.get(), n, ctx) &&
+         BN_is_one(t.get());
+    ok = ok && BN_mod_sqr(t.get(), beta.get(), p.get(), ctx) &&
+         BN_mod_mul(t.get(), t.get(), beta.get(), p.get(), ctx) && BN_is_one(t.get());
+    // a1 - |b1| λ ≡ 0，a2 + a1 λ ≡ 0 (mod n)
+    ok = ok && BN_mod_mul(t.get(), minus_b1.get(), lambda.get(), n, ctx) &&
+         BN_mod_sub(t.get(), a1.get(), t.get(), n, ctx) && BN_is_zero(t.get());
+    ok = ok && BN_mod_mul(t.get(), a1.get(), lambda.get(), n, ctx) &&
+         BN_mod_add(t.get(), a2.get(), t.get(), n, ctx) && BN_is_zero(t.get());
+    // λG = (β x_G, y_G)
+    EcPointPtr lg(EC_POINT_new(group.get()));
+    BnPtr gx(BN_new()), gy(BN_new());
+    ok = ok && lg && gx && EC_POINT_mul(group.get(), lg.get(), lambda.get(), nullptr, nullptr, ctx) &&
+         EC_POINT_get_affine_coordinates(group.get(), lg.get(), t.get(), u.get(), ctx) &&
+         EC_POINT_get_affine_coordinates(group.get(), EC_GROUP_get0_generator(group.get()), gx.get(), gy.get(),
+                                         ctx) &&
+         BN_mod_mul(gx.get(), gx.get(), beta.get(), p.get(), ctx) && BN_cmp(gx.get(), t.get()) == 0 &&
+         BN_cmp(gy.get(), u.get()) == 0;
+    if (!ok) {
+        throw std::runtime_error("secp256k1 backend constants do not match the curve");
+    }
+
+    Constants c;
+    // g = round(2^384 b / n) = floor((2^384 b + n / 2) / n)
+    auto rounded_quotient = [&](u64 out[4], const BIGNUM* numerator) {
+        BnPtr half(BN_new()), q(BN_new());
+        if (!half || !q || !BN_lshift(t.get(), numerator, 384) || !BN_rshift1(half.get(), n) ||
+            !BN_add(t.get(), t.get(), half.get()) || !BN_div(q.get(), nullptr, t.get(), n, ctx) ||
+            !limbs_from_bn(out, q.get())) {
+            throw std::runtime_error("Failed to compute GLV constants");
+        }
+    };
+    rounded_quotient(c.g1, a1.get());
+    rounded_quotient(c.g2, minus_b1.get());
+    if (!limbs_from_bn(c.beta.n, beta.get()) || !limbs_from_bn(c.a1, a1.get()) ||
+        !limbs_from_bn(c.minus_b1, minus_b1.get()) || !limbs_from_bn(c.a2, a2.get())) {
+        throw std::runtime_error("Failed to load GLV constants");
+    }
+    return c;
+}
+
+const Constants& constants() {
+    static const Constants c = make_constants();
+    return c;
+}
+
+// 5 个字的有符号整数（二进制补码），用于 GLV 分解中的精确整数运算
+struct Wide {
+    u64 n[5];
+};
+
+// a（na 个字）× b（nb 个字），截断到 5 个字
+inline Wide wide_mul(const u64* a, int na, const u64* b, int nb) {
+    Wide r{{0, 0, 0, 0, 0}};
+    for (int i = 0; i < na; ++i) {
+        u64 carry = 0;
+        for (int j = 0; j < nb && i + j < 5; ++j) {
+            u128 x = static_cast<u128>(a[i]) * b[j] + r.n[i + j] + carry;
+            r.n[i + j] = static_cast<u64>(x);
+            carry = static_cast<u64>(x >> 64);
+        }
+        if (i + nb < 5) r.n[i + nb] = carry;
+    }
+    return r;
+}
+
+inline void wide_sub(Wide& r, const Wide& a, const Wide& b) {
+    u64 borrow = 0;
+    for (int i = 0; i < 5; ++i) {
+        u128 diff = static_cast<u128>(a.n[i]) - b.n[i] - borrow;
+        r.n[i] = static_cast<u64>(diff);
+        borrow = static_cast<u64>(diff >> 64) & 1;
+    }
+}
+
+// 半长标量：绝对值（小端 3 个字）与符号
+struct HalfScalar {
+    u64 n[3];
+    bool negative;
+};
+
+inline HalfScalar to_half(const Wide& w) {
+    Wide m = w;
+    bool negative = (w.n[4] >> 63) != 0;
+    if (negative) {
+        Wide zero{{0, 0, 0, 0, 0}};
+        wide_sub(m, zero, w);
+    }
+    if (m.n[3] != 0 || m.n[4] != 0 || (m.n[2] >> (kHalfBits - 128 - kWnafWindow)) != 0) {
+        throw std::runtime_error("GLV decomposition out of range");
+    }
+    return HalfScalar{{m.n[0], m.n[1], m.n[2]}, negative};
+}
+
+// round(k g / 2^384)，结果不超过 2^129
+inline void mul_shift_384(u64 out[3], const u64 k[4], const u64 g[4]) {
+    u64 t[8];
+    mul_4x4(t, k, g);
+    u128 acc = static_cast<u128>(t[6]) + (t[5] >> 63);
+    out[0] = static_cast<u64>(acc);
+    acc >>= 64;
+    acc += t[7];
+    out[1] = static_cast<u64>(acc);
+    out[2] = static_cast<u64>(acc >> 64);
+}
+
+// k ≡ k1 + k2 λ (mod n)：c1 = round(b2 k / n)，c2 = round(-b1 k / n)，
+// k1 = k - c1 a1 - c2 a2，k2 = -c1 b1 - c2 b2；|k1|、|k2| 约为 128 位
+void split_lambda(HalfScalar& k1, HalfScalar& k2, const u64 k[4]) {
+    const Constants& c = constants();
+    u64 c1[3], c2[3];
+    mul_shift_384(c1, k, c.g1);
+    mul_shift_384(c2, k, c.g2);
+    Wide r1{{k[0], k[1], k[2], k[3], 0}};
+    wide_sub(r1, r1, wide_mul(c1, 3, c.a1, 2));
+    wide_sub(r1, r1, wide_mul(c2, 3, c.a2, 3));
+    Wide r2 = wide_mul(c1, 3, c.minus_b1, 2);
+    wide_sub(r2, r2, wide_mul(c2, 3, c.a1, 2));
+    k1 = to_half(r1);
+    k2 = to_half(r2);
+}
+
+inline unsigned int get_bits(const u64* s, int words, int offset, int count) {
+    int word = offset >> 6;
+    int shift = offset & 63;
+    u64 lo = word < words ? s[word] >> shift : 0;
+    if (shift + count > 64 && word + 1 < words) {
+        lo |= s[word + 1] << (64 - shift);
+    }
+    return static_cast<unsigned int>(lo & ((1ULL << count) - 1));
+}
+
+// 宽度 w 的 wNAF：非零数字为奇数且 |d| < 2^(w-1)，任意 w 个相邻数字中至多一个非零。
+// 返回最高非零数字的位置加一
+int wnaf(int* out, const HalfScalar& s, int w) {
+    std::fill(out, out + kHalfBits, 0);
+    int carry = 0;
+    int bit = 0;
+    int last = -1;
+    while (bit < kHalfBits) {
+        if (static_cast<int>(get_bits(s.n, 3, bit, 1)) == carry) {
+            ++bit;
+            continue;
+        }
+        int now = std::min(w, kHalfBits - bit);
+        int word = static_cast<int>(get_bits(s.n, 3, bit, now)) + carry;
+        carry = (word >> (w - 1)) & 1;
+        word -= carry << w;
+        out[bit] = word;
+        last = bit;
+        bit += now;
+    }
+    return last + 1;
+}
+
+// 把 wNAF 数字对应的表项（可能取负）加到累加器上
+inline void add_wnaf_digit(Gej& acc, const Ge* table, int digit, bool negate) {
+    if (digit == 0) return;
+    const Ge& entry = table[(std::abs(digit) - 1) / 2];
+    if ((digit < 0) != negate) {
+        Ge neg;
+        ge_neg(neg, entry);
+        gej_add_ge(acc, acc, neg);
+    } else {
+        gej_add_ge(acc, acc, entry);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 与 OpenSSL 对象的转换：直接读写 Jacobian 坐标，不做求逆
+// ---------------------------------------------------------------------------
+
+void load_point(const EC_GROUP* group, const EC_POINT* point, Gej& out, BN_CTX* ctx) {
+    if (EC_POINT_is_at_infinity(group, point)) {
+        gej_set_infinity(out);
+        return;
+    }
+    BN_CTX_start(ctx);
+    BIGNUM* x = BN_CTX_get(ctx);
+    BIGNUM* y = BN_CTX_get(ctx);
+    BIGNUM* z = BN_CTX_get(ctx);
+    bool ok = z && EC_POINT_get_Jprojective_coordinates_GFp(group, point, x, y, z, ctx) &&
+              limbs_from_bn(out.x.n, x) && limbs_from_bn(out.y.n, y) && limbs_from_bn(out.z.n, z);
+    BN_CTX_end(ctx);
+    if (!ok) {
+        throw std::runtime_error("Failed to read point coordinates");
+    }
+    out.infinity = false;
+}
+
+void store_point(const EC_GROUP* group, EC_POINT* point, const Gej& a, BN_CTX* ctx) {
+    if (a.infinity) {
+        if (!EC_POINT_set_to_infinity(group, point)) {
+            throw std::runtime_error("Failed to set point to infinity");
+        }
+        return;
+    }
+    BN_CTX_start(ctx);
+    BIGNUM* x = BN_CTX_get(ctx);
+    BIGNUM* y = BN_CTX_get(ctx);
+    BIGNUM* z = BN_CTX_get(ctx);
+    bool ok = z && limbs_to_bn(x, a.x.n) && limbs_to_bn(y, a.y.n) && limbs_to_bn(z, a.z.n) &&
+              EC_POINT_set_Jprojective_coordinates_GFp(group, point, x, y, z, ctx);
+    BN_CTX_end(ctx);
+    if (!ok) {
+        throw std::runtime_error("Failed to write point coordinates");
+    }
+}
+
+// 标量模 n 后转为 4 个字；已在 [0, n) 内时不做约化
+void load_scalar(u64 out[4], const EC_GROUP* group, const BIGNUM* k, BN_CTX* ctx) {
+    const BIGNUM* order = EC_GROUP_get0_order(group);
+    if (!BN_is_negative(k) && BN_cmp(k, order) < 0) {
+        if (!limbs_from_bn(out, k)) {
+            throw std::runtime_error("Failed to read scalar");
+        }
+        return;
+    }
+    BN_CTX_start(ctx);
+    BIGNUM* reduced = BN_CTX_get(ctx);
+    bool ok = reduced && BN_nnmod(reduced, k, order, ctx) && limbs_from_bn(out, reduced);
+    BN_CTX_end(ctx);
+    if (!ok) {
+        throw std::runtime_error("Failed to reduce scalar");
+    }
+}
+
+inline bool scalar_is_zero(const u64 k[4]) { return (k[0] | k[1] | k[2] | k[3]) == 0; }
+
+// 多标量乘法的线程局部临时数组，只增不减，预热后不再分配
+struct Scratch {
+    std::vector<Gej> jacobian;
+    std::vector<Ge> points;       // 仿射化后的输入点
+    std::vector<Fe> prefix;
+    std::vector<HalfScalar> halves;  // 每个点两个半长标量：k1 对应 P，k2 对应 λP
+    std::vector<Gej> table_jacobian;
+    std::vector<Ge> tables;       // 每个点 2 × kWnafTableSize 项：P 与 λP 的奇数倍
+    std::vector<int> digits;
+    std::vector<int> lengths;
+    std::vector<Ge> glv_points;   // Pippenger：P_i 与 λP_i，已按半长标量的符号取负
+    std::vector<Gej> buckets;
+};
+
+Scratch& scratch() {
+    thread_local Scratch s;
+    return s;
+}
+
+// 有符号数字的 Pippenger 代价：每个窗口 n 次入桶 + 2^(c-1) 个桶的两次汇总加法
+int pippenger_window(size_t n) {
+    int best = 2;
+    double best_cost = 0;
+    for (int c = 2; c <= 16; ++c) {
+        double windows = static_cast<double>((kHalfBits - kWnafWindow + c - 1) / c + 1);
+        double cost = windows * (static_cast<double>(n) + static_cast<double>(1u << c));
+        if (c == 2 || cost < best_cost) {
+            best = c;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+void straus(Gej& acc, Scratch& s, size_t count) {
+    s.table_jacobian.resize(count * kWnafTableSize);
+    s.tables.resize(count * 2 * kWnafTableSize);
+    s.prefix.resize(count * kWnafTableSize);
+    s.digits.resize(count * 2 * kHalfBits);
+    s.lengths.resize(count * 2);
+
+    // 各点的奇数倍 P, 3P, ..., 15P，全部表项共用一次求逆转为仿射坐标
+    for (size_t i = 0; i < count; ++i) {
+        Gej* row = &s.table_jacobian[i * kWnafTableSize];
+        Gej twice;
+        gej_set_ge(row[0], s.points[i]);
+        gej_double(twice, row[0]);
+        for (int j = 1; j < kWnafTableSize; ++j) gej_add(row[j], row[j - 1], twice);
+    }
+    batch_to_affine(s.tables.data(), s.table_jacobian.data(), count * kWnafTableSize, s.prefix.data());
+    // λ 表：(β x, y)，放在各点 P 表之后
+    const Fe& beta = constants().beta;
+    for (size_t i = 0; i < count * kWnafTableSize; ++i) {
+        Ge& lam = s.tables[count * kWnafTableSize + i];
+        fe_mul(lam.x, s.tables[i].x, beta);
+        lam.y = s.tables[i].y;
+        lam.infinity = s.tables[i].infinity;
+    }
+
+    int bits = 0;
+    for (size_t h = 0; h < count * 2; ++h) {
+        s.lengths[h] = wnaf(&s.digits[h * kHalfBits], s.halves[h], kWnafWindow);
+        bits = std::max(bits, s.lengths[h]);
+    }
+    gej_set_infinity(acc);
+    for (int bit = bits - 1; bit >= 0; --bit) {
+        gej_double(acc, acc);
+        for (size_t i = 0; i < count; ++i) {
+            for (int part = 0; part < 2; ++part) {
+                size_t h = 2 * i + part;
+                if (bit >= s.lengths[h]) continue;
+                const Ge* table = &s.tables[(part * count + i) * kWnafTableSize];
+                add_wnaf_digit(acc, table, s.digits[h * kHalfBits + bit], s.halves[h].negative);
+            }
+        }
+    }
+}
+
+void pippenger(Gej& acc, Scratch& s, size_t count) {
+    size_t pairs = count * 2;
+    int c = pippenger_window(pairs);
+    int windows = (kHalfBits - kWnafWindow + c - 1) / c + 1;
+    size_t bucket_count = static_cast<size_t>(1) << (c - 1);
+
+    // P_i 与 λP_i，按半长标量的符号取负，之后只处理非负标量
+    const Fe& beta = constants().beta;
+    s.glv_points.resize(pairs);
+    for (size_t i = 0; i < count; ++i) {
+        Ge& p = s.glv_points[2 * i];
+        Ge& lam = s.glv_points[2 * i + 1];
+        p = s.points[i];
+        if (s.halves[2 * i].negative) fe_neg(p.y, p.y);
+        fe_mul(lam.x, s.points[i].x, beta);
+        lam.y = s.points[i].y;
+        lam.infinity = false;
+        if (s.halves[2 * i + 1].negative) fe_neg(lam.y, lam.y);
+    }
+
+    // 有符号窗口数字：d ∈ [-2^(c-1), 2^(c-1))，进位进入下一个窗口
+    s.digits.resize(pairs * windows);
+    for (size_t h = 0; h < pairs; ++h) {
+        int carry = 0;
+        for (int w = 0; w < windows; ++w) {
+            int value = static_cast<int>(get_bits(s.halves[h].n, 3, w * c, c)) + carry;
+            carry = value >= (1 << (c - 1)) ? 1 : 0;
+            s.digits[h * windows + w] = value - (carry << c);
+        }
+    }
+
+    s.buckets.resize(bucket_count);
+    gej_set_infinity(acc);
+    for (int w = windows - 1; w >= 0; --w) {
+        if (w != windows - 1) {
+            for (int d = 0; d < c; ++d) gej_double(acc, acc);
+        }
+        for (auto& bucket : s.buckets) gej_set_infinity(bucket);
+        for (size_t h = 0; h < pairs; ++h) {
+            int digit = s.digits[h * windows + w];
+            if (digit == 0) continue;
+            Gej& bucket = s.buckets[std::abs(digit) - 1];
+            if (digit > 0) {
+                gej_add_ge(bucket, bucket, s.glv_points[h]);
+            } else {
+                Ge neg;
+                ge_neg(neg, s.glv_points[h]);
+                gej_add_ge(bucket, bucket, neg);
+            }
+        }
+        // Σ j B_j = Σ_j (B_top + ... + B_j)
+        Gej running, window_sum;
+        gej_set_infinity(running);
+        gej_set_infinity(window_sum);
+        for (size_t j = bucket_count; j-- > 0;) {
+            gej_add(running, running, s.buckets[j]);
+            gej_add(window_sum, window_sum, running);
+        }
+        gej_add(acc, acc, window_sum);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 后端
+// ---------------------------------------------------------------------------
+
+class Secp256k1FixedBase : public EcBackend::FixedBase {
+public:
+    Secp256k1FixedBase(const EC_GROUP* group, const EC_POINT* base) : group_(group) {
+        base_.reset(EC_POINT_dup(base, group));
+        if (!base_) {
+            throw std::runtime_error("Failed to allocate fixed-base table");
+        }
+        ScopedBnCtx scoped_ctx;
+        Gej window_base;
+        load_point(group, base, window_base, scoped_ctx.get());
+
+        // table_[w * kFixedEntries + j - 1] = j * 2^(5w) * base，j = 1 .. 16
+        std::vector<Gej> jacobian(kFixedWindows * kFixedEntries);
+        for (int w = 0; w < kFixedWindows; ++w) {
+            Gej* row = &jacobian[w * kFixedEntries];
+            row[0] = window_base;
+            for (int j = 1; j < kFixedEntries; ++j) gej_add(row[j], row[j - 1], window_base);
+            for (int d = 0; d < kFixedWindow; ++d) gej_double(window_base, window_base);
+        }
+        std::vector<Fe> prefix(jacobian.size());
+        table_.resize(jacobian.size());
+        batch_to_affine(table_.data(), jacobian.data(), jacobian.size(), prefix.data());
+    }
+
+    void Mul(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const override {
+        if (!ctx) {
+            ScopedBnCtx local_ctx;
+            Mul(r, k, local_ctx.get());
+            return;
+        }
+        u64 scalar[4];
+        load_scalar(scalar, group_, k, ctx);
+        Gej acc;
+        gej_set_infinity(acc);
+        int carry = 0;
+        for (int w = 0; w < kFixedWindows; ++w) {
+            int value = static_cast<int>(get_bits(scalar, 4, w * kFixedWindow, kFixedWindow)) + carry;
+            carry = value > kFixedEntries ? 1 : 0;
+            value -= carry << kFixedWindow;
+            if (value == 0) continue;
+            const Ge& entry = table_[w * kFixedEntries + std::abs(value) - 1];
+            if (value > 0) {
+                gej_add_ge(acc, acc, entry);
+            } else {
+                Ge neg;
+                ge_neg(neg, entry);
+                gej_add_ge(acc, acc, neg);
+            }
+        }
+        store_point(group_, r, acc, ctx);
+    }
+
+    // 窗口查表与跳过零窗口都依赖标量的取值，秘密标量改用 OpenSSL 的常数时间阶梯
+    void MulSecret(EC_POINT* r, const BIGNUM* k, BN_CTX* ctx) const override {
+        if (!ctx) {
+            ScopedBnCtx local_ctx;
+            MulSecret(r, k, local_ctx.get());
+            return;
+        }
+        if (!EC_POINT_mul(group_, r, nullptr, base_.get(), k, ctx)) {
+            throw std::runtime_error("Point multiplication failed");
+        }
+    }
+
+    const EC_POINT* GetBase() const override { return base_.get(); }
+
+private:
+    const EC_GROUP* group_;
+    EcPointPtr base_;
+    std::vector<Ge> table_;
+};
+
+class NativeBackend final : public EcBackend {
+public:
+    NativeBackend() { constants(); }
+
+    const char* Name() const override { return "secp256k1"; }
+
+    void Mul(const EC_GROUP* group, EC_POINT* r, const EC_POINT* point, const BIGNUM* k,
+             BN_CTX* ctx) const override {
+        u64 scalar[4];
+        Gej p;
+        load_scalar(scalar, group, k, ctx);
+        load_point(group, point, p, ctx);
+        Gej acc;
+        gej_set_infinity(acc);
+        if (p.infinity || scalar_is_zero(scalar)) {
+            store_point(group, r, acc, ctx);
+            return;
+        }
+
+        HalfScalar k1, k2;
+        split_lambda(k1, k2, scalar);
+        Gej jacobian[kWnafTableSize];
+        Ge table[kWnafTableSize];
+        Ge lambda_table[kWnafTableSize];
+        Fe prefix[kWnafTableSize];
+        Gej twice;
+        jacobian[0] = p;
+        gej_double(twice, p);
+        for (int j = 1; j < kWnafTableSize; ++j) gej_add(jacobian[j], jacobian[j - 1], twice);
+        batch_to_affine(table, jacobian, kWnafTableSize, prefix);
+        const Fe& beta = constants().beta;
+        for (int j = 0; j < kWnafTableSize; ++j) {
+            fe_mul(lambda_table[j].x, table[j].x, beta);
+            lambda_table[j].y = table[j].y;
+            lambda_table[j].infinity = table[j].infinity;
+        }
+
+        int digits1[kHalfBits];
+        int digits2[kHalfBits];
+        int bits = std::max(wnaf(digits1, k1, kWnafWindow), wnaf(digits2, k2, kWnafWindow));
+        for (int bit = bits - 1; bit >= 0; --bit) {
+            gej_double(acc, acc);
+            add_wnaf_digit(acc, table, digits1[bit], k1.negative);
+            add_wnaf_digit(acc, lambda_table, digits2[bit], k2.negative);
+        }
+        store_point(group, r, acc, ctx);
+    }
+
+    void MultiMul(const EC_GROUP* group, EC_POINT* r, const std::vector<const EC_POINT*>& points,
+                  const std::vector<const BIGNUM*>& scalars, BN_CTX* ctx) const override {
+        if (points.size() != scalars.size()) {
+            throw std::invalid_argument("Point and scalar counts differ");
+        }
+        Scratch& s = scratch();
+        s.jacobian.resize(points.size());
+        s.halves.resize(points.size() * 2);
+        size_t count = 0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            u64 scalar[4];
+            load_scalar(scalar, group, scalars[i], ctx);
+            if (scalar_is_zero(scalar)) continue;
+            load_point(group, points[i], s.jacobian[count], ctx);
+            if (s.jacobian[count].infinity) continue;
+            split_lambda(s.halves[2 * count], s.halves[2 * count + 1], scalar);
+            ++count;
+        }
+        Gej acc;
+        gej_set_infinity(acc);
+        if (count > 0) {
+            // 输入点共用一次求逆转为仿射坐标（已是仿射坐标的点不参与），之后全部为混合加法
+            s.points.resize(count);
+            s.prefix.resize(count);
+            batch_to_affine(s.points.data(), s.jacobian.data(), count, s.prefix.data());
+            if (count <= kStrausMaxPoints) {
+                straus(acc, s, count);
+            } else {
+                pippenger(acc, s, count);
+            }
+        }
+        store_point(group, r, acc, ctx);
+    }
+
+    std::unique_ptr<FixedBase> NewFixedBase(const EC_GROUP* group, const EC_POINT* base, int) const override {
+        return std::unique_ptr<FixedBase>(new Secp256k1FixedBase(group, base));
+    }
+};
+
+} // namespace
+
+const EcBackend& Secp256k1Backend() {
+    static const NativeBackend backend;
+    return backend;
+}
+
+} // namespace ring_signature_lib
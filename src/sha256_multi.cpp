@@ -0,0 +1,642 @@
+#include "libringsign/sha256_multi.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RINGSIGN_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace ring_signature_lib {
+
+namespace {
+
+using Lane = Sha256MultiBuffer::Lane;
+
+alignas(64) const uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+const uint32_t kInitialState[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+// FinalBatch 中每条通道的尾部缓冲区：剩余数据至多 kTailData 字节，其后留出填充的空间
+const size_t kTailCapacity = 704;
+const size_t kTailData = kTailCapacity - 72;
+const size_t kMaxLanes = 16;
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t load_be32(const unsigned char* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+// 标量实现：按 FIPS 180-4 逐个分组压缩
+void compress_blocks_scalar(uint32_t* state, const unsigned char* blocks, size_t count) {
+    uint32_t w[64];
+    for (size_t n = 0; n < count; ++n) {
+        const unsigned char* block = blocks + 64 * n;
+        for (int i = 0; i < 16; ++i) {
+            w[i] = load_be32(block + 4 * i);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + kRoundConstants[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+void compress_scalar(Lane* lanes, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        compress_blocks_scalar(lanes[i].state, lanes[i].blocks, lanes[i].block_count);
+    }
+}
+
+// 在 block 中已有的 len 字节数据之后追加填充（0x80、补零与 64 位大端比特长度 total_bits），
+// 返回填充后的分组数；block 须有 len + 72 字节的空间
+size_t pad(unsigned char* block, size_t len, uint64_t total_bits) {
+    block[len++] = 0x80;
+    size_t padded = (len + 8 + 63) / 64 * 64;
+    std::memset(block + len, 0, padded - 8 - len);
+    for (int i = 0; i < 8; ++i) {
+        block[padded - 1 - i] = static_cast<unsigned char>(total_bits >> (8 * i));
+    }
+    return padded / 64;
+}
+
+// 把链接值按大端写出为 32 字节摘要
+void store_digest(const uint32_t state[8], unsigned char* out) {
+    for (int j = 0; j < 8; ++j) {
+        out[4 * j] = static_cast<unsigned char>(state[j] >> 24);
+        out[4 * j + 1] = static_cast<unsigned char>(state[j] >> 16);
+        out[4 * j + 2] = static_cast<unsigned char>(state[j] >> 8);
+        out[4 * j + 3] = static_cast<unsigned char>(state[j]);
+    }
+}
+
+#ifdef RINGSIGN_SHA256_X86
+
+#define RINGSIGN_TARGET_SHANI __attribute__((target("sha,sse4.1,ssse3")))
+#define RINGSIGN_TARGET_AVX2 __attribute__((target("avx2")))
+#define RINGSIGN_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+// 分组数不同的通道一起压缩时，已处理完的通道读取全零分组，结果按掩码丢弃
+alignas(64) const unsigned char kZeroBlock[64] = {0};
+
+// ---- SHA-NI：每条通道的链接值放在两个 128 位寄存器中（ABEF 与 CDGH），
+// 两条通道的指令交错排列，掩盖 SHA256RNDS2 的延迟 ----
+
+template <int N>
+RINGSIGN_TARGET_SHANI void shani_compress(uint32_t* const* states, const unsigned char* const* data, size_t blocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i abef[N], cdgh[N];
+    for (int l = 0; l < N; ++l) {
+        __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(states[l]));
+        __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(states[l] + 4));
+        __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+        __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+        abef[l] = _mm_alignr_epi8(cdab, efgh, 8);
+        cdgh[l] = _mm_blend_epi16(efgh, cdab, 0xF0);
+    }
+    for (size_t b = 0; b < blocks; ++b) {
+        __m128i abef_save[N], cdgh_save[N];
+        __m128i msg[N][4];
+        for (int l = 0; l < N; ++l) {
+            abef_save[l] = abef[l];
+            cdgh_save[l] = cdgh[l];
+        }
+        // 第 j 组的 4 轮使用 W[4j..4j+3]，msg[j % 4] 保存这 4 个字；
+        // 消息扩展按 SHA256MSG1 / SHA256MSG2 提前两组准备
+#pragma GCC unroll 16
+        for (int j = 0; j < 16; ++j) {
+            const __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(kRoundConstants + 4 * j));
+            for (int l = 0; l < N; ++l) {
+                if (j < 4) {
+                    const __m128i* in = reinterpret_cast<const __m128i*>(data[l] + 64 * b + 16 * j);
+                    msg[l][j] = _mm_shuffle_epi8(_mm_loadu_si128(in), bswap);
+                }
+                __m128i wk = _mm_add_epi32(msg[l][j & 3], k);
+                cdgh[l] = _mm_sha256rnds2_epu32(cdgh[l], abef[l], wk);
+                if (j >= 3 && j <= 14) {
+                    __m128i& next = msg[l][(j + 1) & 3];
+                    __m128i shifted = _mm_alignr_epi8(msg[l][j & 3], msg[l][(j + 3) & 3], 4);
+                    next = _mm_sha256msg2_epu32(_mm_add_epi32(next, shifted), msg[l][j & 3]);
+                }
+                wk = _mm_shuffle_epi32(wk, 0x0E);
+                abef[l] = _mm_sha256rnds2_epu32(abef[l], cdgh[l], wk);
+                if (j >= 1 && j <= 12) {
+                    msg[l][(j - 1) & 3] = _mm_sha256msg1_epu32(msg[l][(j - 1) & 3], msg[l][j & 3]);
+                }
+            }
+        }
+        for (int l = 0; l < N; ++l) {
+            abef[l] = _mm_add_epi32(abef[l], abef_save[l]);
+            cdgh[l] = _mm_add_epi32(cdgh[l], cdgh_save[l]);
+        }
+    }
+    for (int l = 0; l < N; ++l) {
+        __m128i feba = _mm_shuffle_epi32(abef[l], 0x1B);
+        __m128i dchg = _mm_shuffle_epi32(cdgh[l], 0xB1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(states[l]), _mm_blend_epi16(feba, dchg, 0xF0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(states[l] + 4), _mm_alignr_epi8(dchg, feba, 8));
+    }
+}
+
+RINGSIGN_TARGET_SHANI void shani_single(Lane& lane, size_t first_block) {
+    if (lane.block_count <= first_block) return;
+    uint32_t* state = lane.state;
+    const unsigned char* data = lane.blocks + 64 * first_block;
+    shani_compress<1>(&state, &data, lane.block_count - first_block);
+}
+
+RINGSIGN_TARGET_SHANI void compress_shani(Lane* lanes, size_t count) {
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        // 两条通道共同的分组交错压缩，较长通道剩余的分组单独压缩
+        size_t common = std::min(lanes[i].block_count, lanes[i + 1].block_count);
+        uint32_t* states[2] = {lanes[i].state, lanes[i + 1].state};
+        const unsigned char* data[2] = {lanes[i].blocks, lanes[i + 1].blocks};
+        shani_compress<2>(states, data, common);
+        shani_single(lanes[i], common);
+        shani_single(lanes[i + 1], common);
+    }
+    if (i < count) {
+        shani_single(lanes[i], 0);
+    }
+}
+
+// ---- AVX2：8 条通道，每个 256 位寄存器保存 8 条通道的同一个字 ----
+
+template <int N>
+RINGSIGN_TARGET_AVX2 inline __m256i rotr_avx2(__m256i x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+// 8 × 8 的 32 位字转置：r[i] 的第 j 个字移到 r[j] 的第 i 个字
+RINGSIGN_TARGET_AVX2 inline void transpose8(__m256i r[8]) {
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// 压缩不超过 8 条通道；不足 8 条时其余通道从零状态压缩零分组，结果不写回
+RINGSIGN_TARGET_AVX2 void avx2_group(Lane* lanes, size_t count) {
+    alignas(32) uint32_t words[8][8] = {};  // words[字][通道]
+    size_t max_blocks = 0;
+    for (size_t l = 0; l < count; ++l) {
+        for (int j = 0; j < 8; ++j) words[j][l] = lanes[l].state[j];
+        max_blocks = std::max(max_blocks, lanes[l].block_count);
+    }
+    __m256i state[8];
+    for (int j = 0; j < 8; ++j) state[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(words[j]));
+
+    const __m256i bswap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                          12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    for (size_t b = 0; b < max_blocks; ++b) {
+        alignas(32) int32_t active_words[8];
+        const unsigned char* in[8];
+        for (size_t l = 0; l < 8; ++l) {
+            bool active = l < count && b < lanes[l].block_count;
+            active_words[l] = active ? -1 : 0;
+            in[l] = active ? lanes[l].blocks + 64 * b : kZeroBlock;
+        }
+        const __m256i active = _mm256_load_si256(reinterpret_cast<const __m256i*>(active_words));
+
+        __m256i w[16];
+        for (int half = 0; half < 2; ++half) {
+            for (int l = 0; l < 8; ++l) {
+                w[8 * half + l] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[l] + 32 * half));
+            }
+            transpose8(w + 8 * half);
+        }
+        for (int j = 0; j < 16; ++j) w[j] = _mm256_shuffle_epi8(w[j], bswap);
+
+        __m256i a = state[0], b_ = state[1], c = state[2], d = state[3];
+        __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+#pragma GCC unroll 64
+        for (int t = 0; t < 64; ++t) {
+            __m256i wt;
+            if (t < 16) {
+                wt = w[t];
+            } else {
+                __m256i w2 = w[(t - 2) & 15];
+                __m256i w15 = w[(t - 15) & 15];
+                __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<17>(w2), rotr_avx2<19>(w2)),
+                                              _mm256_srli_epi32(w2, 10));
+                __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<7>(w15), rotr_avx2<18>(w15)),
+                                              _mm256_srli_epi32(w15, 3));
+                wt = _mm256_add_epi32(_mm256_add_epi32(s1, w[(t - 7) & 15]), _mm256_add_epi32(s0, w[t & 15]));
+                w[t & 15] = wt;
+            }
+            __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<6>(e), rotr_avx2<11>(e)), rotr_avx2<25>(e));
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1),
+                                          _mm256_add_epi32(_mm256_add_epi32(ch, wt),
+                                                           _mm256_set1_epi32(static_cast<int>(kRoundConstants[t]))));
+            __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<2>(a), rotr_avx2<13>(a)), rotr_avx2<22>(a));
+            __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b_), _mm256_and_si256(c, _mm256_or_si256(a, b_)));
+            __m256i t2 = _mm256_add_epi32(sigma0, maj);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b_;
+            b_ = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+        const __m256i result[8] = {a, b_, c, d, e, f, g, h};
+        for (int j = 0; j < 8; ++j) {
+            state[j] = _mm256_blendv_epi8(state[j], _mm256_add_epi32(state[j], result[j]), active);
+        }
+    }
+
+    for (int j = 0; j < 8; ++j) _mm256_store_si256(reinterpret_cast<__m256i*>(words[j]), state[j]);
+    for (size_t l = 0; l < count; ++l) {
+        for (int j = 0; j < 8; ++j) lanes[l].state[j] = words[j][l];
+    }
+}
+
+RINGSIGN_TARGET_AVX2 void compress_avx2(Lane* lanes, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        avx2_group(lanes + i, std::min<size_t>(8, count - i));
+    }
+}
+
+// ---- AVX-512：16 条通道，循环移位与三输入逻辑运算各为一条指令 ----
+
+// GCC 12 的 avx512fintrin.h 以自赋值的 __m512i 作为未定义的直通操作数，
+// 内联后误报 -Wmaybe-uninitialized，只在本段关闭
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// 16 × 16 的 32 位字转置：r[i] 的第 j 个字移到 r[j] 的第 i 个字
+RINGSIGN_TARGET_AVX512 inline void transpose16(__m512i r[16]) {
+    __m512i t[16], u[16];
+    for (int k = 0; k < 8; ++k) {
+        t[2 * k] = _mm512_unpacklo_epi32(r[2 * k], r[2 * k + 1]);
+        t[2 * k + 1] = _mm512_unpackhi_epi32(r[2 * k], r[2 * k + 1]);
+    }
+    // u[4m + s] 的第 q 个 128 位块为第 4m..4m+3 行的第 4q + s 个字
+    for (int m = 0; m < 4; ++m) {
+        u[4 * m] = _mm512_unpacklo_epi64(t[4 * m], t[4 * m + 2]);
+        u[4 * m + 1] = _mm512_unpackhi_epi64(t[4 * m], t[4 * m + 2]);
+        u[4 * m + 2] = _mm512_unpacklo_epi64(t[4 * m + 1], t[4 * m + 3]);
+        u[4 * m + 3] = _mm512_unpackhi_epi64(t[4 * m + 1], t[4 * m + 3]);
+    }
+    // 对每个 s 转置 4 × 4 的 128 位块
+    for (int s = 0; s < 4; ++s) {
+        __m512i x0 = _mm512_shuffle_i32x4(u[s], u[4 + s], 0x44);
+        __m512i x1 = _mm512_shuffle_i32x4(u[s], u[4 + s], 0xEE);
+        __m512i x2 = _mm512_shuffle_i32x4(u[8 + s], u[12 + s], 0x44);
+        __m512i x3 = _mm512_shuffle_i32x4(u[8 + s], u[12 + s], 0xEE);
+        r[s] = _mm512_shuffle_i32x4(x0, x2, 0x88);
+        r[4 + s] = _mm512_shuffle_i32x4(x0, x2, 0xDD);
+        r[8 + s] = _mm512_shuffle_i32x4(x1, x3, 0x88);
+        r[12 + s] = _mm512_shuffle_i32x4(x1, x3, 0xDD);
+    }
+}
+
+// 压缩不超过 16 条通道，约定同 avx2_group
+RINGSIGN_TARGET_AVX512 void avx512_group(Lane* lanes, size_t count) {
+    alignas(64) uint32_t words[8][16] = {};  // words[字][通道]
+    size_t max_blocks = 0;
+    for (size_t l = 0; l < count; ++l) {
+        for (int j = 0; j < 8; ++j) words[j][l] = lanes[l].state[j];
+        max_blocks = std::max(max_blocks, lanes[l].block_count);
+    }
+    __m512i state[8];
+    for (int j = 0; j < 8; ++j) state[j] = _mm512_load_si512(words[j]);
+
+    const __m512i bswap = _mm512_broadcast_i32x4(_mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3));
+    for (size_t b = 0; b < max_blocks; ++b) {
+        __mmask16 active = 0;
+        __m512i w[16];
+        for (size_t l = 0; l < 16; ++l) {
+            const unsigned char* in = kZeroBlock;
+            if (l < count && b < lanes[l].block_count) {
+                active = static_cast<__mmask16>(active | (1u << l));
+                in = lanes[l].blocks + 64 * b;
+            }
+            w[l] = _mm512_loadu_si512(in);
+        }
+        transpose16(w);
+        for (int j = 0; j < 16; ++j) w[j] = _mm512_shuffle_epi8(w[j], bswap);
+
+        __m512i a = state[0], b_ = state[1], c = state[2], d = state[3];
+        __m512i e = state[4], f = state[5], g = state[6], h = state[7];
+#pragma GCC unroll 64
+        for (int t = 0; t < 64; ++t) {
+            __m512i wt;
+            if (t < 16) {
+                wt = w[t];
+            } else {
+                __m512i w2 = w[(t - 2) & 15];
+                __m512i w15 = w[(t - 15) & 15];
+                __m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w2, 17), _mm512_ror_epi32(w2, 19),
+                                                       _mm512_srli_epi32(w2, 10), 0x96);
+                __m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(w15, 7), _mm512_ror_epi32(w15, 18),
+                                                       _mm512_srli_epi32(w15, 3), 0x96);
+                wt = _mm512_add_epi32(_mm512_add_epi32(s1, w[(t - 7) & 15]), _mm512_add_epi32(s0, w[t & 15]));
+                w[t & 15] = wt;
+            }
+            // 0x96 为三输入异或，0xCA 为 e ? f : g，0xE8 为多数函数
+            __m512i sigma1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11),
+                                                       _mm512_ror_epi32(e, 25), 0x96);
+            __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+            __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(h, sigma1),
+                                          _mm512_add_epi32(_mm512_add_epi32(ch, wt),
+                                                           _mm512_set1_epi32(static_cast<int>(kRoundConstants[t]))));
+            __m512i sigma0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13),
+                                                       _mm512_ror_epi32(a, 22), 0x96);
+            __m512i maj = _mm512_ternarylogic_epi32(a, b_, c, 0xE8);
+            __m512i t2 = _mm512_add_epi32(sigma0, maj);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm512_add_epi32(d, t1);
+            d = c;
+            c = b_;
+            b_ = a;
+            a = _mm512_add_epi32(t1, t2);
+        }
+        const __m512i result[8] = {a, b_, c, d, e, f, g, h};
+        for (int j = 0; j < 8; ++j) {
+            state[j] = _mm512_mask_add_epi32(state[j], active, state[j], result[j]);
+        }
+    }
+
+    for (int j = 0; j < 8; ++j) _mm512_store_si512(words[j], state[j]);
+    for (size_t l = 0; l < count; ++l) {
+        for (int j = 0; j < 8; ++j) lanes[l].state[j] = words[j][l];
+    }
+}
+
+RINGSIGN_TARGET_AVX512 void compress_avx512(Lane* lanes, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        avx512_group(lanes + i, std::min<size_t>(16, count - i));
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+struct CpuFeatures {
+    bool sha = false;
+    bool avx2 = false;
+    bool avx512 = false;
+};
+
+CpuFeatures detect_cpu() {
+    CpuFeatures features;
+    __builtin_cpu_init();
+    // __builtin_cpu_supports 对 AVX 系列同时检查操作系统是否保存对应寄存器
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    unsigned int eax, ebx, ecx, edx;
+    features.sha = __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 29)) &&
+                   __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("ssse3");
+    return features;
+}
+
+const CpuFeatures& cpu() {
+    static const CpuFeatures features = detect_cpu();
+    return features;
+}
+
+#endif // RINGSIGN_SHA256_X86
+
+Sha256MultiBuffer::Kernel select_kernel() {
+    const char* value = std::getenv("RINGSIGN_SHA256_KERNEL");
+    if (value) {
+        for (int k = Sha256MultiBuffer::kAvx512; k >= Sha256MultiBuffer::kScalar; --k) {
+            auto kernel = static_cast<Sha256MultiBuffer::Kernel>(k);
+            if (std::strcmp(value, Sha256MultiBuffer::Name(kernel)) == 0 && Sha256MultiBuffer::IsSupported(kernel)) {
+                return kernel;
+            }
+        }
+    }
+    // 同时有多条消息时多通道实现的吞吐量最高；只有 SHA-NI 时两条通道交错
+    for (Sha256MultiBuffer::Kernel kernel : {Sha256MultiBuffer::kAvx512, Sha256MultiBuffer::kShaNi,
+                                             Sha256MultiBuffer::kAvx2}) {
+        if (Sha256MultiBuffer::IsSupported(kernel)) return kernel;
+    }
+    return Sha256MultiBuffer::kScalar;
+}
+
+// 单条消息的增量压缩：多通道实现只有一条通道时没有收益，有 SHA-NI 时用 SHA-NI，
+// 指定标量实现或不支持 SHA-NI 时用标量实现
+void compress_serial(uint32_t* state, const unsigned char* blocks, size_t count) {
+#ifdef RINGSIGN_SHA256_X86
+    static const bool use_shani =
+        Sha256MultiBuffer::Active() != Sha256MultiBuffer::kScalar && Sha256MultiBuffer::IsSupported(Sha256MultiBuffer::kShaNi);
+    if (use_shani) {
+        shani_compress<1>(&state, &blocks, count);
+        return;
+    }
+#endif
+    compress_blocks_scalar(state, blocks, count);
+}
+
+} // namespace
+
+void Sha256MultiBuffer::Init(State& state) {
+    std::memcpy(state.h, kInitialState, sizeof(state.h));
+    state.length = 0;
+}
+
+void Sha256MultiBuffer::Update(State& state, const void* data, size_t len) {
+    const unsigned char* in = static_cast<const unsigned char*>(data);
+    size_t pending = state.length % 64;
+    state.length += len;
+    if (pending > 0) {
+        size_t take = std::min(len, 64 - pending);
+        std::memcpy(state.block + pending, in, take);
+        in += take;
+        len -= take;
+        if (pending + take < 64) return;
+        compress_serial(state.h, state.block, 1);
+    }
+    if (len >= 64) {
+        compress_serial(state.h, in, len / 64);
+        in += len / 64 * 64;
+        len %= 64;
+    }
+    std::memcpy(state.block, in, len);
+}
+
+void Sha256MultiBuffer::Final(State& state, unsigned char* out) {
+    unsigned char tail[128];
+    size_t pending = state.length % 64;
+    std::memcpy(tail, state.block, pending);
+    compress_serial(state.h, tail, pad(tail, pending, 8 * state.length));
+    store_digest(state.h, out);
+}
+
+void Sha256MultiBuffer::FinalBatch(State* const* states, const unsigned char* const* data, const size_t* len,
+                                   unsigned char* out, size_t count) {
+    alignas(64) unsigned char tails[kMaxLanes][kTailCapacity];
+    Lane lanes[kMaxLanes];
+    for (size_t begin = 0; begin < count; begin += kMaxLanes) {
+        size_t n = std::min(count - begin, kMaxLanes);
+        for (size_t i = 0; i < n; ++i) {
+            State& state = *states[begin + i];
+            const unsigned char* in = data[begin + i];
+            size_t in_len = len[begin + i];
+            // 剩余数据超出尾部缓冲区时，超出部分先逐个分组压缩
+            if (state.length % 64 + in_len > kTailData) {
+                size_t head = in_len - (kTailData - 64);
+                Update(state, in, head);
+                in += head;
+                in_len -= head;
+            }
+            size_t pending = state.length % 64;
+            std::memcpy(tails[i], state.block, pending);
+            std::memcpy(tails[i] + pending, in, in_len);
+            state.length += in_len;
+            size_t blocks = pad(tails[i], pending + in_len, 8 * state.length);
+            lanes[i] = {state.h, tails[i], blocks};
+        }
+        Compress(lanes, n);
+        for (size_t i = 0; i < n; ++i) {
+            store_digest(states[begin + i]->h, out + 32 * (begin + i));
+        }
+    }
+}
+
+bool Sha256MultiBuffer::IsSupported(Kernel kernel) {
+    switch (kernel) {
+    case kScalar:
+        return true;
+#ifdef RINGSIGN_SHA256_X86
+    case kShaNi:
+        return cpu().sha;
+    case kAvx2:
+        return cpu().avx2;
+    case kAvx512:
+        return cpu().avx512;
+#endif
+    default:
+        return false;
+    }
+}
+
+Sha256MultiBuffer::Kernel Sha256MultiBuffer::Active() {
+    static const Kernel kernel = select_kernel();
+    return kernel;
+}
+
+const char* Sha256MultiBuffer::Name(Kernel kernel) {
+    switch (kernel) {
+    case kScalar:
+        return "scalar";
+    case kShaNi:
+        return "shani";
+    case kAvx2:
+        return "avx2";
+    case kAvx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+size_t Sha256MultiBuffer::Width(Kernel kernel) {
+    switch (kernel) {
+    case kShaNi:
+        return 2;
+    case kAvx2:
+        return 8;
+    case kAvx512:
+        return 16;
+    default:
+        return 1;
+    }
+}
+
+void Sha256MultiBuffer::Compress(Lane* lanes, size_t count) {
+    Compress(Active(), lanes, count);
+}
+
+void Sha256MultiBuffer::Compress(Kernel kernel, Lane* lanes, size_t count) {
+    if (!IsSupported(kernel)) {
+        throw std::invalid_argument("SHA-256 kernel not supported on this CPU");
+    }
+    switch (kernel) {
+#ifdef RINGSIGN_SHA256_X86
+    case kShaNi:
+        compress_shani(lanes, count);
+        return;
+    case kAvx2:
+        compress_avx2(lanes, count);
+        return;
+    case kAvx512:
+        compress_avx512(lanes, count);
+        return;
+#endif
+    default:
+        compress_scalar(lanes, count);
+        return;
+    }
+}
+
+} // namespace ring_signature_lib
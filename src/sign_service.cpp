@@ -0,0 +1,220 @@
+#include "libringsign/sign_service.h"
+#include "libringsign/message_digest.h"
+#include "libringsign/network_utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+using json = nlohmann::json;
+
+namespace {
+
+// 签名对象归调用方所有，转换为 JSON 后释放
+struct SignatureGuard {
+    Signature& signature;
+    ~SignatureGuard() {
+        for (auto* point : signature.A) EC_POINT_free(point);
+        BN_free(signature.phi);
+        BN_free(signature.psi);
+        EC_POINT_free(signature.T);
+    }
+};
+
+json error_response(const std::string& message) {
+    return {{"status", "error"}, {"error", message}};
+}
+
+// 成员 ID 来自请求并拼入配置文件路径：只允许字母、数字与 "_.-"，且不含 ".."
+void check_member_id(const std::string& id) {
+    bool valid = !id.empty() && id.find("..") == std::string::npos &&
+                 std::all_of(id.begin(), id.end(), [](char c) {
+                     return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                            c == '_' || c == '.' || c == '-';
+                 });
+    if (!valid) {
+        throw std::invalid_argument("Invalid member ID: " + id);
+    }
+}
+
+} // namespace
+
+json SignatureToJson(const EC_GROUP* group, const Signature& signature, const std::string& digest_algorithm) {
+    json signature_json;
+    signature_json["transcript_version"] = signature.transcript_version;
+    if (digest_algorithm.empty()) {
+        signature_json["message_mode"] = MESSAGE_MODE_RAW;
+    } else {
+        signature_json["message_mode"] = MESSAGE_MODE_DIGEST;
+        signature_json["message_digest"] = digest_algorithm;
+    }
+    signature_json["A"] = json::array();
+    for (const auto* point : signature.A) {
+        signature_json["A"].push_back(PointToHex(group, point));
+    }
+    signature_json["phi"] = BnToHex(signature.phi);
+    signature_json["psi"] = BnToHex(signature.psi);
+    signature_json["T"] = PointToHex(group, signature.T);
+    return signature_json;
+}
+
+SignService::SignService(const std::string& config_path, const std::string& sign_key_path,
+                         const std::string& config_dir, size_t ring_cache_capacity)
+    : config_dir_(config_dir),
+      ring_cache_capacity_(std::max<size_t>(ring_cache_capacity, 1)),
+      ring_hits_(0),
+      ring_misses_(0),
+      requests_(0) {
+    signer_.LoadConfig(config_path, sign_key_path);
+    if (!signer_.VerifyKey()) {
+        throw std::runtime_error("Signer key verification failed: " + sign_key_path);
+    }
+    signer_id_ = ConfigManager::LoadJson(sign_key_path)["id"].get<std::string>();
+}
+
+std::shared_ptr<const SignService::MemberKey> SignService::member(const std::string& id) {
+    check_member_id(id);
+    std::string path = config_dir_ + "/" + id + "_config.json";
+    // 修改时间在读取之前取得，读取期间文件被改写时下次请求会重新读取
+    std::error_code error;
+    auto mtime = std::filesystem::last_write_time(path, error);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = members_.find(id);
+        if (it != members_.end() && !error && it->second.mtime == mtime) return it->second.key;
+    }
+
+    // 在锁外读取并解析成员配置，其他请求不必等待文件读取
+    json member_config = ConfigManager::LoadJson(path);
+    EC_GROUP* group = signer_.GetGroup();
+    auto key = std::make_shared<MemberKey>(
+        PointFromHex(group, member_config["full_public_key_0"].get<std::string>()),
+        PointFromHex(group, member_config["full_public_key_1"].get<std::string>()));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (members_.size() >= kMemberCacheCapacity && members_.find(id) == members_.end()) {
+        // 缓存已满时淘汰任意一项，被淘汰的成员下次使用时重新读取
+        members_.erase(members_.begin());
+    }
+    members_[id] = {key, mtime};
+    return key;
+}
+
+std::shared_ptr<const RingContext> SignService::ring(const std::vector<std::string>& ring_ids) {
+    RingKey key(ring_ids);
+    key.push_back(signer_id_);
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+    if (key.size() < 2) {
+        throw std::invalid_argument("Ring must contain at least 2 members");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ring_index_.find(key);
+        if (it != ring_index_.end()) {
+            rings_.splice(rings_.begin(), rings_, it->second);
+            ++ring_hits_;
+            return it->second->second;
+        }
+        ++ring_misses_;
+    }
+
+    // 环上下文在锁外构建（含 K_i 的预计算），成员公钥的 shared_ptr 保证构建期间不被释放
+    std::vector<std::shared_ptr<const MemberKey>> keys;
+    std::vector<RingContext::Member> members;
+    keys.reserve(key.size());
+    members.reserve(key.size());
+    for (const auto& id : key) {
+        if (id == signer_id_) {
+            members.emplace_back(id, signer_.GetPublicKey());
+            continue;
+        }
+        keys.push_back(member(id));
+        members.emplace_back(id, std::make_pair(keys.back()->first.get(), keys.back()->second.get()));
+    }
+    auto context = std::make_shared<const RingContext>(signer_.CreateRingContext(members));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ring_index_.find(key);
+    if (it != ring_index_.end()) {
+        // 其他线程已并发构建同一个环
+        return it->second->second;
+    }
+    rings_.emplace_front(key, context);
+    ring_index_.emplace(std::move(key), rings_.begin());
+    while (rings_.size() > ring_cache_capacity_) {
+        ring_index_.erase(rings_.back().first);
+        rings_.pop_back();
+    }
+    return context;
+}
+
+json SignService::Sign(std::string_view msg, const std::string& event, const std::vector<std::string>& ring_ids,
+                       const std::string& digest_algorithm) {
+    std::shared_ptr<const RingContext> context = ring(ring_ids);
+    Signature signature = signer_.Sign(msg, event, *context);
+    SignatureGuard guard{signature};
+    return SignatureToJson(signer_.GetGroup(), signature, digest_algorithm);
+}
+
+bool SignService::NeedsPayload(const json& header) {
+    return header.is_object() && header.value("op", "sign") == "sign";
+}
+
+json SignService::HandleRequest(const json& header, std::string_view payload) {
+    try {
+        std::string op = header.value("op", "sign");
+        if (op == "status") {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return {{"status", "ok"},
+                    {"signer_id", signer_id_},
+                    {"requests", requests_},
+                    {"cached_rings", rings_.size()},
+                    {"ring_cache_hits", ring_hits_},
+                    {"ring_cache_misses", ring_misses_}};
+        }
+        if (op != "sign") {
+            return error_response("Unsupported op: " + op);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++requests_;
+        }
+        std::vector<std::string> ring_ids = header.at("ring").get<std::vector<std::string>>();
+        std::string event = header.value("event", "ring_signature_event");
+        std::string digest_algorithm = header.value("message_digest", "");
+        json signature = Sign(payload, event, ring_ids, digest_algorithm);
+        return {{"status", "ok"}, {"signer_id", signer_id_}, {"signature", std::move(signature)}};
+    } catch (const std::exception& e) {
+        return error_response(e.what());
+    }
+}
+
+void SignService::ServeConnection(int fd, size_t max_message_size) {
+    std::string header_frame, payload;
+    while (RecvFrame(fd, header_frame)) {
+        json header = json::parse(header_frame, nullptr, false);
+        if (header.is_discarded()) {
+            SendFrame(fd, error_response("Malformed request header").dump());
+            return;
+        }
+        payload.clear();
+        if (NeedsPayload(header) && !RecvFrame(fd, payload, max_message_size)) {
+            return;
+        }
+        SendFrame(fd, HandleRequest(header, payload).dump());
+    }
+}
+
+size_t SignService::RingCacheHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_hits_;
+}
+
+size_t SignService::RingCacheMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_misses_;
+}
+
+} // namespace ring_signature_lib
@@ -0,0 +1,197 @@
+#include "libringsign/signature_codec.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include <openssl/evp.h>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace ring_signature_lib {
+
+namespace {
+
+const char kMagic[4] = {'R', 'S', 'I', 'G'};
+// magic、格式版本、transcript 版本、标志、标量宽度、点宽度、摘要算法名长度
+const size_t kFixedHeaderSize = 4 + 6;
+// 并行解压缩时每个分块的最少点数
+const size_t kMinPointsPerChunk = 256;
+
+size_t scalar_size(const EC_GROUP* group) {
+    return static_cast<size_t>(BN_num_bytes(EC_GROUP_get0_order(group)));
+}
+
+size_t point_size(const EC_GROUP* group) {
+    return 1 + (static_cast<size_t>(EC_GROUP_get_degree(group)) + 7) / 8;
+}
+
+void checksum(const char* data, size_t len, unsigned char out[kSignatureChecksumSize]) {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_len = 0;
+    if (!EVP_Digest(data, len, digest, &digest_len, EVP_sha256(), nullptr)) {
+        throw std::runtime_error("Failed to compute signature checksum");
+    }
+    std::memcpy(out, digest, kSignatureChecksumSize);
+}
+
+void append_point(std::string& out, const EC_GROUP* group, const EC_POINT* point, size_t width, BN_CTX* ctx) {
+    size_t offset = out.size();
+    out.resize(offset + width, '\0');
+    if (EC_POINT_is_at_infinity(group, point)) return;  // 无穷远点编码为全零
+    unsigned char* dst = reinterpret_cast<unsigned char*>(&out[offset]);
+    if (EC_POINT_point2oct(group, point, POINT_CONVERSION_COMPRESSED, dst, width, ctx) != width) {
+        throw std::runtime_error("Failed to encode signature point");
+    }
+}
+
+void append_scalar(std::string& out, const BIGNUM* scalar, size_t width) {
+    size_t offset = out.size();
+    out.resize(offset + width, '\0');
+    if (BN_bn2binpad(scalar, reinterpret_cast<unsigned char*>(&out[offset]), static_cast<int>(width)) < 0) {
+        throw std::runtime_error("Signature scalar too large");
+    }
+}
+
+void decode_point(const EC_GROUP* group, std::string_view bytes, EC_POINT* point, BN_CTX* ctx) {
+    bool zero = true;
+    for (char c : bytes) zero = zero && c == '\0';
+    if (zero) {
+        EC_POINT_set_to_infinity(group, point);
+        return;
+    }
+    // 解压缩时 OpenSSL 检查 x 是否对应曲线上的点
+    if (!EC_POINT_oct2point(group, point, reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), ctx)) {
+        throw std::runtime_error("Invalid point in binary signature");
+    }
+}
+
+BnPtr decode_scalar(std::string_view bytes, const BIGNUM* order) {
+    BnPtr scalar(BN_bin2bn(reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<int>(bytes.size()), nullptr));
+    if (!scalar) {
+        throw std::runtime_error("Failed to decode signature scalar");
+    }
+    if (BN_cmp(scalar.get(), order) >= 0) {
+        throw std::runtime_error("Signature scalar out of range");
+    }
+    return scalar;
+}
+
+} // namespace
+
+std::string EncodeSignature(const EC_GROUP* group, const Signature& signature,
+                            const std::string& digest_algorithm, bool with_checksum) {
+    if (digest_algorithm.size() > 0xFF) {
+        throw std::invalid_argument("Digest algorithm name too long");
+    }
+    if (signature.A.size() > 0xFFFFFFFFu) {
+        throw std::invalid_argument("Ring too large for binary signature");
+    }
+    size_t scalar_width = scalar_size(group);
+    size_t point_width = point_size(group);
+    size_t ring_size = signature.A.size();
+
+    std::string out;
+    out.reserve(kFixedHeaderSize + digest_algorithm.size() + 4 + (ring_size + 1) * point_width +
+                2 * scalar_width + kSignatureChecksumSize);
+    out.append(kMagic, sizeof(kMagic));
+    out.push_back(static_cast<char>(kSignatureFormatVersion));
+    out.push_back(static_cast<char>(signature.transcript_version));
+    out.push_back(static_cast<char>(with_checksum ? kSignatureFlagChecksum : 0));
+    out.push_back(static_cast<char>(scalar_width));
+    out.push_back(static_cast<char>(point_width));
+    out.push_back(static_cast<char>(digest_algorithm.size()));
+    out += digest_algorithm;
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<char>(ring_size >> shift));
+
+    ScopedBnCtx scoped_ctx;
+    for (const EC_POINT* point : signature.A) {
+        append_point(out, group, point, point_width, scoped_ctx.get());
+    }
+    append_point(out, group, signature.T, point_width, scoped_ctx.get());
+    append_scalar(out, signature.phi, scalar_width);
+    append_scalar(out, signature.psi, scalar_width);
+
+    if (with_checksum) {
+        unsigned char sum[kSignatureChecksumSize];
+        checksum(out.data(), out.size(), sum);
+        out.append(reinterpret_cast<const char*>(sum), sizeof(sum));
+    }
+    return out;
+}
+
+bool IsBinarySignature(std::string_view data) {
+    return data.size() >= sizeof(kMagic) && std::memcmp(data.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+SignatureView::SignatureView(std::string_view data) {
+    if (!IsBinarySignature(data) || data.size() < kFixedHeaderSize) {
+        throw std::runtime_error("Not a binary signature");
+    }
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(data.data());
+    if (header[4] != kSignatureFormatVersion) {
+        throw std::runtime_error("Unsupported binary signature format version");
+    }
+    transcript_version_ = header[5];
+    flags_ = header[6];
+    scalar_size_ = header[7];
+    point_size_ = header[8];
+    size_t digest_len = header[9];
+    if (scalar_size_ == 0 || point_size_ < 2) {
+        throw std::runtime_error("Invalid binary signature header");
+    }
+    if (data.size() < kFixedHeaderSize + digest_len + 4) {
+        throw std::runtime_error("Truncated binary signature");
+    }
+    digest_algorithm_ = data.substr(kFixedHeaderSize, digest_len);
+    const unsigned char* count = header + kFixedHeaderSize + digest_len;
+    ring_size_ = (static_cast<size_t>(count[0]) << 24) | (static_cast<size_t>(count[1]) << 16) |
+                 (static_cast<size_t>(count[2]) << 8) | count[3];
+
+    size_t body_offset = kFixedHeaderSize + digest_len + 4;
+    size_t body_size = (ring_size_ + 1) * point_size_ + 2 * scalar_size_;
+    size_t trailer = HasChecksum() ? kSignatureChecksumSize : 0;
+    if (data.size() != body_offset + body_size + trailer) {
+        throw std::runtime_error("Binary signature size does not match its header");
+    }
+    if (HasChecksum()) {
+        unsigned char sum[kSignatureChecksumSize];
+        checksum(data.data(), body_offset + body_size, sum);
+        if (std::memcmp(sum, data.data() + body_offset + body_size, kSignatureChecksumSize) != 0) {
+            throw std::runtime_error("Binary signature checksum mismatch");
+        }
+    }
+    body_ = data.substr(body_offset, body_size);
+}
+
+Signature SignatureView::Decode(const EC_GROUP* group, ThreadPool* pool) const {
+    if (scalar_size_ != scalar_size(group) || point_size_ != point_size(group)) {
+        throw std::runtime_error("Binary signature does not match the curve");
+    }
+    const BIGNUM* order = EC_GROUP_get0_order(group);
+    BnPtr phi = decode_scalar(Phi(), order);
+    BnPtr psi = decode_scalar(Psi(), order);
+
+    // 先分配全部点，再（并行）解压缩；任一点无效时全部释放
+    std::vector<EcPointPtr> points(ring_size_ + 1);
+    for (auto& point : points) {
+        point.reset(EC_POINT_new(group));
+        if (!point) throw std::runtime_error("Failed to allocate signature point");
+    }
+    auto decode = [&](size_t, size_t begin, size_t end) {
+        ScopedBnCtx scoped_ctx;
+        for (size_t i = begin; i < end; ++i) {
+            decode_point(group, i < ring_size_ ? A(i) : T(), points[i].get(), scoped_ctx.get());
+        }
+    };
+    if (pool) {
+        pool->ParallelFor(points.size(), decode, kMinPointsPerChunk);
+    } else {
+        decode(0, 0, points.size());
+    }
+
+    std::vector<EC_POINT*> A;
+    A.reserve(ring_size_);
+    for (size_t i = 0; i < ring_size_; ++i) A.push_back(points[i].release());
+    return Signature(std::move(A), phi.release(), psi.release(), points[ring_size_].release(), transcript_version_);
+}
+
+} // namespace ring_signature_lib
@@ -1,4 +1,10 @@
 #include "libringsign/signer.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/keystore.h"
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
 #include <openssl/rand.h>
 #include <stdexcept>
 #include <iostream>
@@ -8,18 +14,12 @@ namespace ring_signature_lib {
 using json = nlohmann::json;
 
 Signer::Signer()
-    : private_key_(nullptr),
-      partial_private_key_(nullptr),
-      id_hash_(nullptr),
-      system_public_key_(nullptr),
-      group_(nullptr),
+    : curve_nid_(0),
+      transcript_version_(TRANSCRIPT_VERSION_1),
+      backend_(nullptr),
       is_initialized_(false),
       is_partial_key_generated_(false),
-      is_full_key_generated_(false),
-      curve_nid_(0) {
-    full_public_key_[0] = nullptr;
-    full_public_key_[1] = nullptr;
-}
+      is_full_key_generated_(false) {}
 
 void Signer::Initialize(const std::string& id, const std::string& config_path) {
     initialize_id(id);
@@ -27,6 +27,28 @@ void Signer::Initialize(const std::string& id, const std::string& config_path) {
     is_initialized_ = true;
 }
 
+void Signer::Initialize(const std::string& id, const Signer& parameters) {
+    if (!parameters.is_initialized_) {
+        throw std::runtime_error("System configuration not loaded.");
+    }
+    initialize_id(id);
+    curve_nid_ = parameters.curve_nid_;
+    hash_type_ = parameters.hash_type_;
+    transcript_version_ = parameters.transcript_version_;
+    group_.reset(EC_GROUP_dup(parameters.group_.get()));
+    if (!group_) {
+        throw std::runtime_error("Failed to create EC group");
+    }
+    system_public_key_.reset(EC_POINT_dup(parameters.system_public_key_.get(), group_.get()));
+    if (!system_public_key_) {
+        throw std::runtime_error("Failed to copy system public key");
+    }
+    hash_ = parameters.hash_;
+    backend_ = parameters.backend_;
+    precompute_ = parameters.precompute_;
+    is_initialized_ = true;
+}
+
 void Signer::initialize_id(const std::string& id) {
     id_ = id;  // 设置用户ID
 }
@@ -43,19 +65,27 @@ void Signer::load_config(const std::string& path) {
 
     curve_nid_ = j["curve_nid"];
     hash_type_ = j["hash_type"];
+    transcript_version_ = j.value("transcript_version", TRANSCRIPT_VERSION_1);
+    if (!Transcript::IsSupported(transcript_version_)) {
+        throw std::runtime_error("Unsupported transcript version in config");
+    }
 
     // 初始化群 group_
-    group_ = EC_GROUP_new_by_curve_name(curve_nid_);
+    group_.reset(EC_GROUP_new_by_curve_name(curve_nid_));
     if (!group_) {
         throw std::runtime_error("Failed to create EC group");
     }
 
-    system_public_key_ = EC_POINT_new(group_);
-    EC_POINT_hex2point(group_, j["system_public_key"].get<std::string>().c_str(), system_public_key_, nullptr);
+    system_public_key_ = PointFromHex(group_.get(), j["system_public_key"].get<std::string>());
 
     for (const auto& key : j["hash_keys"]) {
         hash_.emplace_back(key, hash_type_);
     }
+
+    // 为 G、P_pub 和事件点构建固定基点预计算层，由按曲线选择的后端构建
+    backend_ = &EcBackend::ForGroup(group_.get());
+    precompute_ = std::make_shared<PrecomputeCache>(group_.get(), system_public_key_.get(), hash_[0],
+                                                    PrecomputeCache::kDefaultEventCapacity, backend_);
 }
 
 std::pair<std::string, EC_POINT*> Signer::GeneratePartialKey(unsigned int seed) {
@@ -65,7 +95,7 @@ std::pair<std::string, EC_POINT*> Signer::GeneratePartialKey(unsigned int seed)
 
     generate_partial_key(seed);
     is_partial_key_generated_ = true;
-    return {id_, full_public_key_[0]};
+    return {id_, full_public_key_[0].get()};
 }
 
 void Signer::generate_partial_key(unsigned int seed) {
@@ -74,26 +104,18 @@ void Signer::generate_partial_key(unsigned int seed) {
     }
     srand(seed);
 
-    private_key_ = BN_new();
-    BIGNUM* group_order = BN_new();
-    EC_GROUP_get_order(group_, group_order, nullptr);
-    if (!private_key_ || !BN_rand_range(private_key_, group_order)) {
-        BN_free(group_order);
+    private_key_.reset(BN_new());
+    if (!private_key_ || !BN_rand_range(private_key_.get(), EC_GROUP_get0_order(group_.get()))) {
         throw std::runtime_error("Failed to generate private key");
     }
 
-    full_public_key_[0] = EC_POINT_new(group_);
-
-    // 直接将生成元作为参数传递，而不是存储在非 const 变量中
-    if (!full_public_key_[0] || !EC_POINT_mul(group_, full_public_key_[0], private_key_, nullptr, nullptr, nullptr)) {
-        BN_free(group_order);
+    full_public_key_[0].reset(EC_POINT_new(group_.get()));
+    if (!full_public_key_[0]) {
         throw std::runtime_error("Failed to generate partial public key");
     }
+    precompute_->Generator().MulSecret(full_public_key_[0].get(), private_key_.get(), nullptr);  // X_i = x_i * G
 
-    std::string data = id_ + EC_POINT_point2hex(group_, full_public_key_[0], POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                       EC_POINT_point2hex(group_, system_public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    id_hash_ = hash_[1].hashToBn(data);
-    BN_free(group_order);
+    id_hash_.reset(compute_id_hash(nullptr));
 }
 
 void Signer::GenerateFullKey(const EC_POINT* partial_system_public_key, const BIGNUM* partial_private_key) {
@@ -106,31 +128,32 @@ void Signer::GenerateFullKey(const EC_POINT* partial_system_public_key, const BI
 }
 
 void Signer::generate_full_key(const EC_POINT* partial_system_public_key, const BIGNUM* partial_private_key) {
-    full_public_key_[1] = EC_POINT_dup(partial_system_public_key, group_);
-    partial_private_key_ = BN_dup(partial_private_key);
+    full_public_key_[1].reset(EC_POINT_dup(partial_system_public_key, group_.get()));
+    partial_private_key_.reset(BN_dup(partial_private_key));
+    if (!full_public_key_[1] || !partial_private_key_) {
+        throw std::runtime_error("Failed to copy full key");
+    }
 }
 
 bool Signer::VerifyKey() const {
     if (!is_full_key_generated_) return false;
 
-    return verify_key(full_public_key_[1], partial_private_key_);
+    return verify_key(full_public_key_[1].get(), partial_private_key_.get());
 }
 
 bool Signer::verify_key(const EC_POINT* partial_system_public_key, const BIGNUM* partial_private_key) const {
-    EC_POINT* lhs = EC_POINT_new(group_);
-    EC_POINT* rhs = EC_POINT_new(group_);
-
-    // 将生成元直接传递给 EC_POINT_mul
-    EC_POINT_mul(group_, lhs, nullptr, system_public_key_, id_hash_, nullptr);
-    EC_POINT_add(group_, lhs, partial_system_public_key, lhs, nullptr);
-    EC_POINT_mul(group_, rhs, partial_private_key, nullptr, nullptr, nullptr);
-
-    bool is_valid = (EC_POINT_cmp(group_, lhs, rhs, nullptr) == 0);
-
-    EC_POINT_free(lhs);
-    EC_POINT_free(rhs);
-
-    return is_valid;
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+    ScopedArena arena(group_.get());
+    EC_POINT* lhs = arena.Point();
+    EC_POINT* rhs = arena.Point();
+
+    // 使用 P_pub 与生成元的预计算表
+    precompute_->SystemPublicKey().Mul(lhs, id_hash_.get(), ctx);
+    EC_POINT_add(group_.get(), lhs, partial_system_public_key, lhs, ctx);
+    precompute_->Generator().MulSecret(rhs, partial_private_key, ctx);
+
+    return EC_POINT_cmp(group_.get(), lhs, rhs, ctx) == 0;
 }
 
 void Signer::SaveConfig(const std::string& sign_key_path) {
@@ -156,21 +179,15 @@ void Signer::save_key(const std::string& sign_key_path) {
     j["id"] = id_;  // 保存用户ID
 
     // 保存私钥
-    char* private_key_hex = BN_bn2hex(private_key_);
-    j["private_key"] = private_key_hex;
-    OPENSSL_free(private_key_hex);
+    j["private_key"] = BnToHex(private_key_.get());
 
     // 保存部分私钥
-    char* partial_private_key_hex = BN_bn2hex(partial_private_key_);
-    j["partial_private_key"] = partial_private_key_hex;
-    OPENSSL_free(partial_private_key_hex);
+    j["partial_private_key"] = BnToHex(partial_private_key_.get());
 
     // 保存完整公钥（X_i 和 Y_i）
     for (int i = 0; i < 2; ++i) {
-        if (full_public_key_[i] != nullptr) {
-            char* public_key_hex = EC_POINT_point2hex(group_, full_public_key_[i], POINT_CONVERSION_UNCOMPRESSED, nullptr);
-            j["full_public_key_" + std::to_string(i)] = public_key_hex;
-            OPENSSL_free(public_key_hex);
+        if (full_public_key_[i]) {
+            j["full_public_key_" + std::to_string(i)] = PointToHex(group_.get(), full_public_key_[i].get());
         }
     }
 
@@ -197,22 +214,16 @@ void Signer::load_key(const std::string& sign_key_path) {
     id_ = j["id"];  // 加载用户ID
 
     // 加载私钥
-    std::string private_key_hex = j["private_key"];
-    private_key_ = BN_new();
-    BN_hex2bn(&private_key_, private_key_hex.c_str());
+    private_key_ = BnFromHex(j["private_key"].get<std::string>());
 
     // 加载部分私钥
-    std::string partial_private_key_hex = j["partial_private_key"];
-    partial_private_key_ = BN_new();
-    BN_hex2bn(&partial_private_key_, partial_private_key_hex.c_str());
+    partial_private_key_ = BnFromHex(j["partial_private_key"].get<std::string>());
 
     // 加载完整公钥（X_i 和 Y_i）
     for (int i = 0; i < 2; ++i) {
         std::string public_key_key = "full_public_key_" + std::to_string(i);
         if (j.contains(public_key_key)) {
-            std::string public_key_hex = j[public_key_key];
-            full_public_key_[i] = EC_POINT_new(group_);
-            EC_POINT_hex2point(group_, public_key_hex.c_str(), full_public_key_[i], nullptr);
+            full_public_key_[i] = PointFromHex(group_.get(), j[public_key_key].get<std::string>());
         }
     }
 
@@ -227,27 +238,32 @@ void Signer::load_key(const std::string& sign_key_path) {
     }
 
     // 计算 ID 的哈希值
-    std::string data = id_ + 
-                       EC_POINT_point2hex(group_, full_public_key_[0], POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                       EC_POINT_point2hex(group_, system_public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    id_hash_ = hash_[1].hashToBn(data);
+    id_hash_.reset(compute_id_hash(nullptr));
+}
+
+BIGNUM* Signer::compute_id_hash(BN_CTX* ctx) const {
+    // h_i = H_1(ID_i || X_i || P_pub)，按系统的 transcript 版本编码
+    Transcript transcript(hash_[1], transcript_version_);
+    transcript.AppendString(id_);
+    transcript.AppendPoint(group_.get(), full_public_key_[0].get(), ctx);
+    transcript.AppendPoint(group_.get(), system_public_key_.get(), ctx);
+    return transcript.FinalToBn();
 }
 
 std::string Signer::GetParametersAsString() const {
     std::ostringstream oss;
 
     oss << "ID: " << id_ << "\n";
-    oss << "Private Key: " << BN_bn2hex(private_key_) << "\n";
-    oss << "Partial Private Key (z_i): " << BN_bn2hex(partial_private_key_) << "\n";
-    oss << "ID Hash (H_1): " << BN_bn2hex(id_hash_) << "\n";
+    oss << "Private Key: " << BnToHex(private_key_.get()) << "\n";
+    oss << "Partial Private Key (z_i): " << BnToHex(partial_private_key_.get()) << "\n";
+    oss << "ID Hash (H_1): " << BnToHex(id_hash_.get()) << "\n";
 
     // 输出公钥的 X_i 和 Y_i 部分
-    oss << "Public Key X_i: " << EC_POINT_point2hex(group_, full_public_key_[0], POINT_CONVERSION_UNCOMPRESSED, nullptr) << "\n";
-    oss << "Public Key Y_i: " << EC_POINT_point2hex(group_, full_public_key_[1], POINT_CONVERSION_UNCOMPRESSED, nullptr) << "\n";
-     
+    oss << "Public Key X_i: " << PointToHex(group_.get(), full_public_key_[0].get()) << "\n";
+    oss << "Public Key Y_i: " << PointToHex(group_.get(), full_public_key_[1].get()) << "\n";
 
     // 输出系统公钥
-    oss << "System Public Key (P_pub): " << EC_POINT_point2hex(group_, system_public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr) << "\n";
+    oss << "System Public Key (P_pub): " << PointToHex(group_.get(), system_public_key_.get()) << "\n";
 
     // 输出椭圆曲线和哈希类型
     oss << "Curve NID: " << curve_nid_ << "\n";
@@ -267,40 +283,96 @@ std::string Signer::GetParametersAsString() const {
     return oss.str();
 }
 
-Signature Signer::Sign(
-    const std::string& msg, const std::string& event,
-    std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> other_signer_pkc) {
-
-    // 将 signer 自己的信息（ID 和公钥）添加到 other_signer_pkc 中
-    other_signer_pkc.emplace_back(id_, std::make_pair(full_public_key_[0], full_public_key_[1]));
-
-    // 对包含 signer 自身信息的 other_signer_pkc 按照 ID 字符串字典序排序
-    std::sort(other_signer_pkc.begin(), other_signer_pkc.end(), 
-        [](const auto& lhs, const auto& rhs) {
-            return lhs.first < rhs.first;
-    });
-
-    // 查找 signer 在排序后的列表中的位置（signer_index），并检查重复 ID
-    int signer_index = -1;
-    for (size_t i = 0; i < other_signer_pkc.size(); ++i) {
-        if (i > 0 && other_signer_pkc[i].first == other_signer_pkc[i - 1].first) {
-            throw std::invalid_argument("Duplicate ID found in other_signer_pkc.");
-        }
-        if (other_signer_pkc[i].first == id_) {
-            signer_index = i;
+RingContext Signer::CreateRingContext(const std::vector<RingContext::Member>& members, bool combine) const {
+    if (!group_ || !system_public_key_ || hash_.size() < 2) {
+        throw std::runtime_error("System configuration not loaded.");
+    }
+    return RingContext(group_.get(), system_public_key_.get(), hash_[1], transcript_version_, members,
+                       &precompute_->SystemPublicKey(), combine, pool_.get());
+}
+
+RingContext Signer::CreateRingContext(const Keystore& keystore, const std::vector<std::string>& ids,
+                                      bool combine) const {
+    if (!group_ || !system_public_key_ || hash_.size() < 2) {
+        throw std::runtime_error("System configuration not loaded.");
+    }
+    if (keystore.Fingerprint() != SystemFingerprint() || keystore.TranscriptVersion() != transcript_version_) {
+        throw std::runtime_error("Keystore was built for different system parameters.");
+    }
+    std::vector<size_t> indices;
+    indices.reserve(ids.size());
+    for (const auto& id : ids) {
+        long index = keystore.IndexOf(id);
+        if (index < 0) {
+            throw std::invalid_argument("Ring member not found in keystore: " + id);
         }
+        indices.push_back(static_cast<size_t>(index));
     }
+    std::sort(indices.begin(), indices.end());
+    if (std::adjacent_find(indices.begin(), indices.end()) != indices.end()) {
+        throw std::invalid_argument("Duplicate ID found in ring members.");
+    }
+    return RingContext(group_.get(), keystore, indices, combine, pool_.get());
+}
+
+std::string Signer::SystemFingerprint() const {
+    if (!group_ || !system_public_key_ || hash_.size() < 2) {
+        throw std::runtime_error("System configuration not loaded.");
+    }
+    // 各字段以长度为前缀拼接，避免不同字段组合产生相同输入
+    ScopedBnCtx scoped_ctx;
+    PointEncoding ppub_enc = PointEncoding::Encode(group_.get(), system_public_key_.get(), scoped_ctx.get());
+    std::string input;
+    for (const std::string& field : {std::to_string(curve_nid_), std::to_string(transcript_version_),
+                                     ppub_enc.compressed, hash_[1].GetType(), hash_[1].GetKey()}) {
+        input += std::to_string(field.size()) + ":" + field;
+    }
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_len = 0;
+    if (!EVP_Digest(input.data(), input.size(), digest, &digest_len, EVP_sha256(), nullptr)) {
+        throw std::runtime_error("Failed to compute system fingerprint");
+    }
+    return std::string(reinterpret_cast<const char*>(digest), digest_len);
+}
+
+void Signer::SetThreadCount(size_t threads) {
+    if (threads <= 1) {
+        pool_.reset();
+    } else if (!pool_ || pool_->Size() != threads) {
+        pool_ = std::make_shared<ThreadPool>(threads);
+    }
+}
+
+Signature Signer::Sign(
+    std::string_view msg, const std::string& event,
+    const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& other_signer_pkc) {
+
+    // 将 signer 自己的信息（ID 和公钥）加入环成员，构建环上下文（按 ID 排序并检查重复）
+    // 环只使用一次，不预计算 K_i
+    std::vector<RingContext::Member> members(other_signer_pkc);
+    members.emplace_back(id_, std::make_pair(full_public_key_[0].get(), full_public_key_[1].get()));
+    RingContext ring = CreateRingContext(members, false);
+
+    return Sign(msg, event, ring);
+}
 
-    // 如果 signer_index 未找到，抛出异常（一般不会发生）
+Signature Signer::Sign(std::string_view msg, const std::string& event, const RingContext& ring) {
+    // 查找 signer 在排序后的列表中的位置（signer_index）
+    int signer_index = ring.IndexOf(id_);
     if (signer_index == -1) {
-        throw std::runtime_error("Signer ID not found in sorted list.");
+        throw std::invalid_argument("Signer ID not found in ring.");
+    }
+    ScopedBnCtx scoped_ctx;
+    if (EC_POINT_cmp(group_.get(), ring[signer_index].X, full_public_key_[0].get(), scoped_ctx.get()) != 0 ||
+        EC_POINT_cmp(group_.get(), ring[signer_index].Y, full_public_key_[1].get(), scoped_ctx.get()) != 0) {
+        throw std::invalid_argument("Signer public key does not match the ring entry.");
     }
 
     // 调用私有的签名生成函数
-    auto [A, phi, psi, T] = sign(msg, event, other_signer_pkc, signer_index);
+    auto [A, phi, psi, T] = sign(msg, event, ring, signer_index);
 
-    // 返回 Signature 结构体
-    return Signature(A, phi, psi, T);
+    // 返回 Signature 结构体，记录签名使用的 transcript 版本
+    return Signature(std::move(A), phi, psi, T, transcript_version_);
 }
 
 void print_bignum(const std::string& label, const BIGNUM* bn) {
@@ -316,151 +388,267 @@ void print_ec_point(const std::string& label, const EC_GROUP* group, const EC_PO
     OPENSSL_free(point_str);
 }
 
+Transcript Signer::member_hash_prefix(int transcript_version, std::string_view msg,
+                                      const std::string& event) const {
+    Transcript prefix(hash_[3], transcript_version);
+    prefix.AppendString(msg);
+    prefix.AppendString(event);
+    return prefix;
+}
+
+void Signer::member_hash(BIGNUM* out, const Transcript& prefix, const RingContext::Entry& member,
+                         const EC_POINT* A_i, BN_CTX* ctx) const {
+    // 复制已写入 msg || event 的中间状态，消息只需哈希一次
+    Transcript transcript(prefix);
+    transcript.AppendString(member.id);
+    transcript.AppendPoint(member.X_enc);
+    transcript.AppendPoint(member.Y_enc);
+    transcript.AppendPoint(group_.get(), A_i, ctx);
+    transcript.FinalToBn(out);
+}
+
+void Signer::member_hash_batch(BIGNUM* const* out, const Transcript& prefix, const RingContext& L,
+                               const EC_POINT* const* A, size_t begin, size_t end, int skip, BN_CTX* ctx) const {
+    // 一组成员各复制一份中间状态并写入各自的后缀，再一起输出
+    std::optional<Transcript> transcripts[HashState::kBatchSize];
+    Transcript* pending[HashState::kBatchSize];
+    size_t count = 0;
+    size_t written = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (static_cast<int>(i) == skip) continue;
+        Transcript& transcript = transcripts[count].emplace(prefix);
+        transcript.AppendString(L[i].id);
+        transcript.AppendPoint(L[i].X_enc);
+        transcript.AppendPoint(L[i].Y_enc);
+        transcript.AppendPoint(group_.get(), A[i], ctx);
+        pending[count++] = &transcript;
+        if (count == HashState::kBatchSize) {
+            Transcript::FinalToBnBatch(pending, out + written, count);
+            written += count;
+            count = 0;
+        }
+    }
+    if (count > 0) {
+        Transcript::FinalToBnBatch(pending, out + written, count);
+    }
+}
+
 std::tuple<std::vector<EC_POINT*>, BIGNUM*, BIGNUM*, EC_POINT*> Signer::sign(
-    const std::string& msg, const std::string& event,
-    const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& L,
+    std::string_view msg, const std::string& event,
+    const RingContext& L,
     int signer_index) {
 
-    BN_CTX* ctx = BN_CTX_new();
-    const EC_POINT* P = EC_GROUP_get0_generator(group_);
-    BIGNUM* group_order = BN_new();
-    EC_GROUP_get_order(group_, group_order, ctx);
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+    // 临时 BIGNUM 与点从线程局部的分配器借出，返回或抛出异常时统一归还（BIGNUM 先清零）
+    ScopedArena arena(group_.get());
+    const EC_GROUP* group = group_.get();
+    const EcBackend::FixedBase& generator = precompute_->Generator();
+    const BIGNUM* group_order = EC_GROUP_get0_order(group);
+    int n = static_cast<int>(L.Size());
+
+    // msg || event 只写入 H_3 一次，各成员的 a_i 从该中间状态继续
+    Transcript prefix = member_hash_prefix(transcript_version_, msg, event);
 
     // 复用的临时变量
-    BIGNUM* temp_bn = BN_new();  // 用于各类中间 BIGNUM 计算，包括替代 random_bn
-    EC_POINT* temp_point = EC_POINT_new(group_);
-
-    // 步骤 1：选择随机值并生成 A_i 和 a_i
-    std::vector<EC_POINT*> A(L.size(), nullptr);
-    std::vector<BIGNUM*> a(L.size(), nullptr);
-
-    for (int i = 0; i < L.size(); ++i) {
-        if (i == signer_index) continue;  // 跳过 signer_index
-        A[i] = EC_POINT_new(group_);
-        // 生成随机数并计算 A_i
-        BN_rand_range(temp_bn, group_order);
-        EC_POINT_mul(group_, A[i], temp_bn, P, nullptr, ctx);
-        // 拼接消息、事件和其他签名者信息计算 a_i
-        // 计算 a_i = H_3(msg || event || L_i || A_i)
-        std::string input = msg + event + L[i].first +
-                            EC_POINT_point2hex(group_, L[i].second.first, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                            EC_POINT_point2hex(group_, L[i].second.second, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                            EC_POINT_point2hex(group_, A[i], POINT_CONVERSION_UNCOMPRESSED, nullptr);
-        a[i] = hash_[3].hashToBn(input);
-    }
-
-    // 步骤 2：计算 h_i
-    std::vector<BIGNUM*> h(L.size());
-    for (int i = 0; i < L.size(); ++i) {
-        if (i == signer_index) {
-            // 对于 signer 自己，直接使用 id_hash_
-            h[i] = BN_dup(id_hash_);
-        } else {
-            std::string h_input = L[i].first + EC_POINT_point2hex(group_, L[i].second.first, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                                  EC_POINT_point2hex(group_, system_public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-            h[i] = hash_[1].hashToBn(h_input);
+    BIGNUM* temp_bn = arena.Bn();  // 用于各类中间 BIGNUM 计算
+    EC_POINT* temp_point = arena.Point();
+    bool combined = L.HasCombinedPoints();
+
+    // 签名在借出的对象上计算，通过自检后才复制为返回给调用方的对象，
+    // 中途抛出异常时不会泄漏，返回对象的大小也与计算过程中的中间表示无关
+    std::vector<EC_POINT*>& A = arena.List<EC_POINT*>();
+    for (int i = 0; i < n; ++i) A.push_back(arena.Point());
+    EC_POINT* T = arena.Point();
+    BIGNUM* phi = arena.Bn();
+    BIGNUM* psi = arena.Bn();
+
+    // 步骤 1：选择随机值并生成 A_i 和 a_i；同时按分块累加 M 的多标量乘法部分和、
+    // ∑ a_i、∑ a_i h_i 与 ∑ A_i。环成员按分块处理，多线程时各分块并行，
+    // 每个分块使用独立的 BN_CTX 与分配器，a_i 只在分块内使用；部分和在调用线程上借出，
+    // 最后按分块顺序归约。
+    //
+    // 多标量乘法不是常数时间实现，若跳过签名者，其耗时会随签名者位置变化。因此签名者一项
+    // 同样参与，系数取与 a_i 同样均匀分布的随机掩码 ρ：部分和多出 ρ K_ω = ρ (x_ω + z_ω) P，
+    // 在步骤 4 中并入常数时间的定基点乘法抵消；∑ a_i 中的 ρ 归约后减去
+    BIGNUM* rho = arena.Bn();
+    RandRange(rho, group_order);
+    size_t chunks = pool_ ? pool_->ChunkCount(n, RingContext::kMinMembersPerChunk) : 1;
+    std::vector<EC_POINT*>& partial_M = arena.List<EC_POINT*>();  // ∑ a_i K_i 或 ∑ a_i (X_i + Y_i)，a_ω = ρ
+    std::vector<EC_POINT*>& partial_A = arena.List<EC_POINT*>();  // ∑_{i ≠ ω} A_i
+    std::vector<BIGNUM*>& partial_a = arena.List<BIGNUM*>();      // ∑ a_i，a_ω = ρ
+    std::vector<BIGNUM*>& partial_ah = arena.List<BIGNUM*>();     // ∑ a_i h_i，a_ω = ρ
+    for (size_t c = 0; c < chunks; ++c) {
+        partial_M.push_back(arena.Point());
+        partial_A.push_back(arena.Point());
+        partial_a.push_back(arena.Bn());
+        partial_ah.push_back(arena.Bn());
+    }
+    auto sign_chunk = [&](size_t chunk, size_t begin, size_t end) {
+        ScopedBnCtx scoped_chunk_ctx;
+        BN_CTX* chunk_ctx = scoped_chunk_ctx.get();
+        ScopedArena chunk_arena(group);
+        BIGNUM* r = chunk_arena.Bn();
+        std::vector<const EC_POINT*>& points = chunk_arena.List<const EC_POINT*>();
+        std::vector<const BIGNUM*>& scalars = chunk_arena.List<const BIGNUM*>();
+        std::vector<EC_POINT*>& chunk_A = chunk_arena.List<EC_POINT*>();
+        points.reserve(end - begin);
+        scalars.reserve(end - begin);
+        chunk_A.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            if (static_cast<int>(i) == signer_index) continue;  // A_signer 在步骤 6 中计算
+            // 生成随机数并计算 A_i
+            RandRange(r, group_order);
+            generator.MulSecret(A[i], r, chunk_ctx);
+            chunk_A.push_back(A[i]);
         }
+        // A_i 在哈希中编码、在签名中序列化，整块一次仿射化后各点编码不再求逆
+        MakeAffine(group, chunk_A.data(), chunk_A.size(), chunk_ctx);
+        // 计算 a_i = H_3(msg || event || L_i || A_i)，按组批量输出
+        std::vector<BIGNUM*>& a = chunk_arena.List<BIGNUM*>();
+        a.reserve(chunk_A.size());
+        for (size_t k = 0; k < chunk_A.size(); ++k) a.push_back(chunk_arena.Bn());
+        member_hash_batch(a.data(), prefix, L, A.data(), begin, end, signer_index, chunk_ctx);
+        size_t next = 0;
+        for (size_t i = begin; i < end; ++i) {
+            bool is_signer = static_cast<int>(i) == signer_index;
+            const BIGNUM* a_i = is_signer ? rho : a[next++];
+
+            points.push_back(combined ? L[i].K : L[i].XY);
+            scalars.push_back(a_i);
+            BN_mod_add(partial_a[chunk], partial_a[chunk], a_i, group_order, chunk_ctx);
+            if (!is_signer) {
+                EC_POINT_add(group, partial_A[chunk], partial_A[chunk], A[i], chunk_ctx);
+            }
+            if (!combined) {
+                BN_mod_mul(r, a_i, L[i].h, group_order, chunk_ctx);
+                BN_mod_add(partial_ah[chunk], partial_ah[chunk], r, group_order, chunk_ctx);
+            }
+        }
+        backend_->MultiMul(group, partial_M[chunk], points, scalars, chunk_ctx);
+    };
+    if (pool_) {
+        pool_->ParallelFor(n, sign_chunk, RingContext::kMinMembersPerChunk);
+    } else {
+        sign_chunk(0, 0, n);
     }
 
+    // 步骤 2：h_i 已在环上下文中计算（可能已合并为 K_i = X_i + Y_i + h_i P_pub）
+
     // 步骤 3：计算 E 和 T
-    EC_POINT* E = EC_POINT_new(group_);
-    EC_POINT_mul(group_, E, nullptr, P, hash_[0].hashToBn(event), nullptr);
-    EC_POINT* T = EC_POINT_new(group_);
-    EC_POINT_mul(group_, T, nullptr, E, private_key_, nullptr); // T = x_signer * E
+    // E = H_0(event) * P 及其预计算表来自事件缓存
+    std::shared_ptr<const EcBackend::FixedBase> event_table = precompute_->EventTable(event);
+    event_table->MulSecret(T, private_key_.get(), ctx); // T = x_signer * E
 
     // 步骤 4：选择随机值 μ 和 ν 并计算 M 和 N
-    BIGNUM* mu = BN_new();
-    BIGNUM* nu = BN_new();
-    BN_rand_range(mu, group_order);
-    BN_rand_range(nu, group_order);
-
-    // 计算 M = (μ + ν)P + ∑_{i=1, i ≠ ω}^{n} a_i (X_i + Y_i + h_i P_{pub})
-    EC_POINT* M = EC_POINT_new(group_);
-    BN_mod_add(temp_bn, mu, nu, group_order, ctx);  // 复用 temp_bn 计算 μ + ν
-    EC_POINT_mul(group_, M, nullptr, P, temp_bn, ctx);
-
-    // 累加 M = (μ + ν)P + ∑_{i=1, i ≠ ω}^{n} a_i * (X_i + Y_i + h_i * P_pub)
-    for (int i = 0; i < L.size(); ++i) {
-        if (i == signer_index) continue;  // 跳过 signer 自己的索引
-
-        EC_POINT_mul(group_, temp_point, nullptr, system_public_key_, h[i], ctx); // temp_point = h_i * P_pub
-        EC_POINT_add(group_, temp_point, temp_point, L[i].second.first, ctx); // temp_point = h_i * P_pub + X_i
-        EC_POINT_add(group_, temp_point, temp_point, L[i].second.second, ctx); // temp_point = X_i + Y_i + h_i * P_pub
-        EC_POINT_mul(group_, temp_point, nullptr, temp_point, a[i], ctx);
-        EC_POINT_add(group_, M, M, temp_point, ctx);
-    }
-
-    // 计算 N = ν E + ∑_{i=1, i ≠ signer_index}^{n} a_i T
-    EC_POINT* N = EC_POINT_new(group_);
-    EC_POINT_mul(group_, N, nullptr, E, nu, ctx);
-    for (int i = 0; i < L.size(); ++i) {
-        if (i == signer_index) continue;
-        EC_POINT_mul(group_, temp_point, nullptr, T, a[i], ctx); // a_i T
-        EC_POINT_add(group_, N, N, temp_point, ctx);
-    }
-
-    // 步骤 5：计算 θ
-    std::string theta_input = msg + event + 
-                              EC_POINT_point2hex(group_, T, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                              EC_POINT_point2hex(group_, M, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                              EC_POINT_point2hex(group_, N, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    for (const auto& entry : L) {
-        theta_input += entry.first + 
-                       EC_POINT_point2hex(group_, entry.second.first, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                       EC_POINT_point2hex(group_, entry.second.second, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    }
-    BIGNUM* theta = hash_[4].hashToBn(theta_input);
-
-    // 步骤 6：计算 D 和 A_signer
-    EC_POINT* D = EC_POINT_new(group_);
-    EC_POINT_add(group_, D, M, N, ctx);               // D = M + N
-    EC_POINT_mul(group_, temp_point, nullptr, P, theta, ctx);  // θP
-    EC_POINT_add(group_, D, D, temp_point, ctx);               // D = M + N + θP
+    BIGNUM* mu = arena.Bn();
+    BIGNUM* nu = arena.Bn();
+    RandRange(mu, group_order);
+    RandRange(nu, group_order);
+
+    // M = (μ + ν)P + ∑_{i ≠ ω} a_i K_i。部分和中签名者一项的系数为 ρ，改写为
+    // M = (μ + ν - ρ (x_ω + z_ω))P + ∑ a_i K_i；未预计算 K_i 时 ∑ a_i K_i 为
+    // ∑ a_i (X_i + Y_i) + (∑ a_i h_i) P_pub，其中 a_ω = ρ。
+    // 按分块顺序归约各部分和
+    BIGNUM* sum_a = arena.Bn();   // ∑_{i ≠ ω} a_i
+    BIGNUM* sum_ah = arena.Bn();  // ∑ a_i h_i，a_ω = ρ
+    EC_POINT* sum_A = arena.Point();  // ∑_{i ≠ ω} A_i
+    EC_POINT* M = arena.Point();
+    for (size_t c = 0; c < chunks; ++c) {
+        EC_POINT_add(group, M, M, partial_M[c], ctx);
+        EC_POINT_add(group, sum_A, sum_A, partial_A[c], ctx);
+        BN_mod_add(sum_a, sum_a, partial_a[c], group_order, ctx);
+        BN_mod_add(sum_ah, sum_ah, partial_ah[c], group_order, ctx);
+    }
 
-    // 计算 A[signer_index] = D - ∑_{i ≠ signer_index} A_i
-    A[signer_index] = EC_POINT_dup(D, group_);
-    for (int i = 0; i < L.size(); ++i) {
-        if (i == signer_index) continue;
+    BN_mod_sub(sum_a, sum_a, rho, group_order, ctx);
+
+    BIGNUM* mu_nu = arena.Bn();
+    BN_mod_add(mu_nu, mu, nu, group_order, ctx);  // μ + ν
+    BN_mod_add(temp_bn, private_key_.get(), partial_private_key_.get(), group_order, ctx);
+    BN_mod_mul(temp_bn, rho, temp_bn, group_order, ctx);
+    BN_mod_sub(mu_nu, mu_nu, temp_bn, group_order, ctx);  // μ + ν - ρ (x_ω + z_ω)
+    generator.MulSecret(temp_point, mu_nu, ctx);
+    EC_POINT_add(group, M, M, temp_point, ctx);
+    if (!combined) {
+        // 和中含掩码 ρ，与签名随机数同样经由常数时间实现
+        precompute_->SystemPublicKey().MulSecret(temp_point, sum_ah, ctx);  // (∑ a_i h_i) P_pub
+        EC_POINT_add(group, M, M, temp_point, ctx);
+    }
 
-        EC_POINT_copy(temp_point, A[i]);
-        EC_POINT_invert(group_, temp_point, ctx);  // 取反 A[i]
-        EC_POINT_add(group_, A[signer_index], A[signer_index], temp_point, ctx);  // A[signer_index] = D - ∑ A_i
+    // 计算 N = ν E + (∑_{i ≠ ω} a_i) T，由于 T = x_ω E，只需一次标量乘法：
+    // N = (ν + x_ω ∑_{i ≠ ω} a_i) E
+    EC_POINT* N = arena.Point();
+    BN_mod_mul(temp_bn, sum_a, private_key_.get(), group_order, ctx);
+    BN_mod_add(temp_bn, temp_bn, nu, group_order, ctx);
+    event_table->MulSecret(N, temp_bn, ctx);
+
+    // 步骤 5：计算 θ = H_4(msg || event || T || M || N || L)
+    // 各成员的 ID 与公钥编码在遍历时逐个写入运行中的 HMAC 状态，不构造完整的输入字符串，
+    // 该步骤的内存占用与环大小无关。T、M、N 编码前一起仿射化，三次求逆合并为一次
+    EC_POINT* const transcript_points[] = {T, M, N};
+    MakeAffine(group, transcript_points, 3, ctx);
+    Transcript theta_transcript(hash_[4], transcript_version_);
+    theta_transcript.AppendString(msg);
+    theta_transcript.AppendString(event);
+    theta_transcript.AppendPoint(group, T, ctx);
+    theta_transcript.AppendPoint(group, M, ctx);
+    theta_transcript.AppendPoint(group, N, ctx);
+    for (const auto& entry : L.Entries()) {
+        theta_transcript.AppendString(entry.id);
+        theta_transcript.AppendPoint(entry.X_enc);
+        theta_transcript.AppendPoint(entry.Y_enc);
     }
+    BIGNUM* theta = arena.Bn();
+    theta_transcript.FinalToBn(theta);
+
+    // 步骤 6：计算 D 和 A_signer
+    EC_POINT* D = arena.Point();
+    EC_POINT_add(group, D, M, N, ctx);               // D = M + N
+    generator.Mul(temp_point, theta, ctx);  // θP
+    EC_POINT_add(group, D, D, temp_point, ctx);               // D = M + N + θP
 
+    // 计算 A[signer_index] = D - ∑_{i ≠ signer_index} A_i（求和已在步骤 1 中完成，只取反一次）
+    EC_POINT_invert(group, sum_A, ctx);
+    EC_POINT_add(group, A[signer_index], D, sum_A, ctx);
+    // 其余 A_i 已在步骤 1 中仿射化；A_signer 仿射化后哈希与序列化时同样无需求逆
+    MakeAffine(group, &A[signer_index], 1, ctx);
 
     // 步骤 7：计算 a[signer_index] 和生成 φ, ψ
-    std::string a_signer_input = msg + event + id_ +
-                                  EC_POINT_point2hex(group_, full_public_key_[0], POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                                  EC_POINT_point2hex(group_, full_public_key_[1], POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                                  EC_POINT_point2hex(group_, A[signer_index], POINT_CONVERSION_UNCOMPRESSED, nullptr);
-    a[signer_index] = hash_[3].hashToBn(a_signer_input);
-
-    BIGNUM* phi = BN_new();
-    BIGNUM* psi = BN_new();
+    BIGNUM* a_signer = arena.Bn();
+    member_hash(a_signer, prefix, L[signer_index], A[signer_index], ctx);
 
     // 计算 φ = μ + θ - a[signer_index] * z_signer
     BN_mod_add(phi, mu, theta, group_order, ctx);               // 先计算 μ + θ，直接存入 φ
-    BN_mod_mul(temp_bn, a[signer_index], partial_private_key_, group_order, ctx);  // 计算 a[signer_index] * z_signer 并存入 temp_bn
+    BN_mod_mul(temp_bn, a_signer, partial_private_key_.get(), group_order, ctx);  // 计算 a[signer_index] * z_signer 并存入 temp_bn
     BN_mod_sub(phi, phi, temp_bn, group_order, ctx);            // φ = μ + θ - a[signer_index] * z_signer
 
     // 计算 ψ = ν - a[signer_index] * x_signer
-    BN_mod_mul(temp_bn, a[signer_index], private_key_, group_order, ctx);  // a[signer_index] * x_signer
-    BN_mod_sub(psi, nu, temp_bn, group_order, ctx);      
-
-    // 清理资源
-    BN_free(group_order);
-    BN_free(temp_bn);
-    EC_POINT_free(temp_point);
-    BN_CTX_free(ctx);
+    BN_mod_mul(temp_bn, a_signer, private_key_.get(), group_order, ctx);  // a[signer_index] * x_signer
+    BN_mod_sub(psi, nu, temp_bn, group_order, ctx);
 
     // 验证签名
-    bool is_valid = verify(A, phi, psi, T, msg, event, L);
+    bool is_valid = verify(A, phi, psi, T, msg, event, L, transcript_version_);
     if (!is_valid) {
         // 可以选择抛出异常，或记录日志，或返回错误标志
         throw std::runtime_error("Signature verification failed after signing.");
     }
-   
-    return {A, phi, psi, T};
+
+    // 自检通过后复制出返回给调用方的对象
+    BnPtr phi_out(BN_dup(phi));
+    BnPtr psi_out(BN_dup(psi));
+    EcPointPtr T_out(EC_POINT_dup(T, group));
+    std::vector<EC_POINT*> result(n, nullptr);
+    bool allocated = phi_out && psi_out && T_out;
+    for (int i = 0; allocated && i < n; ++i) {
+        result[i] = EC_POINT_dup(A[i], group);
+        allocated = result[i] != nullptr;
+    }
+    if (!allocated) {
+        for (auto* A_i : result) EC_POINT_free(A_i);
+        throw std::runtime_error("Failed to allocate signature");
+    }
+    return {std::move(result), phi_out.release(), psi_out.release(), T_out.release()};
 }
 
 bool Signer::verify(
@@ -468,81 +656,115 @@ bool Signer::verify(
     BIGNUM* phi,
     BIGNUM* psi,
     EC_POINT* T,
-    const std::string& msg,
+    std::string_view msg,
     const std::string& event,
-    const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& L) {
-
-        BN_CTX* ctx = BN_CTX_new();
-        const EC_POINT* P = EC_GROUP_get0_generator(group_);
-        BIGNUM *group_order = BN_new();
-        EC_GROUP_get_order(group_, group_order, NULL);
-        EC_POINT* lhs = EC_POINT_new(group_);  // 左侧求和项
-        EC_POINT* rhs = EC_POINT_new(group_);  // 右侧求和项
-        EC_POINT* temp_point = EC_POINT_new(group_);  // 临时计算点
-        BIGNUM* temp_bn = BN_new();  // 用于存储中间 BIGNUM 值
- 
-        // 计算 E = H_0(event) * P
-        EC_POINT* E = EC_POINT_new(group_);
-        EC_POINT_mul(group_, E, nullptr, P, hash_[0].hashToBn(event), ctx);  // E = H_0(event) * P
-
-        // 计算左侧: ∑_{i=1}^{n} A_i
-        EC_POINT_set_to_infinity(group_, lhs);
-        for (const auto& Ai : A) {
-            EC_POINT_add(group_, lhs, lhs, Ai, ctx);
-        }
+    const RingContext& L,
+    int transcript_version) {
 
-        // 计算右侧
-        EC_POINT_set_to_infinity(group_, rhs);  // 初始 rhs 为无穷点
-
-        // 逐项计算右侧公式中的每一项
-        for (size_t i = 0; i < L.size(); ++i) {
-            // 计算 a_i = H_3(msg || event || L_i || A_i)
-            std::string a_input = msg + event + L[i].first +
-                                EC_POINT_point2hex(group_, L[i].second.first, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                                EC_POINT_point2hex(group_, L[i].second.second, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                                EC_POINT_point2hex(group_, A[i], POINT_CONVERSION_UNCOMPRESSED, nullptr);
-            BIGNUM* a_i = hash_[3].hashToBn(a_input);
-
-            // 计算 h_i = H_1(ID_i || X_i || P_pub)
-            std::string h_input = L[i].first +
-                                EC_POINT_point2hex(group_, L[i].second.first, POINT_CONVERSION_UNCOMPRESSED, nullptr) +
-                                EC_POINT_point2hex(group_, system_public_key_, POINT_CONVERSION_UNCOMPRESSED, nullptr);
-            BIGNUM* h_i = hash_[1].hashToBn(h_input);
-
-            // 计算 a_i * (X_i + Y_i + T)
-            EC_POINT_add(group_, temp_point, L[i].second.first, L[i].second.second, ctx);  // temp_point = X_i + Y_i
-            EC_POINT_add(group_, temp_point, temp_point, T, ctx);  // temp_point = X_i + Y_i + T
-            EC_POINT_mul(group_, temp_point, nullptr, temp_point, a_i, ctx);  // temp_point = a_i * (X_i + Y_i + T)
-            EC_POINT_add(group_, rhs, rhs, temp_point, ctx);  // 加入到 rhs
-
-            // 计算 (∑_{i=1}^{n} a_i h_i) * P_{pub}
-            EC_POINT_mul(group_, temp_point, nullptr, system_public_key_, h_i, ctx);  // temp_point = h_i * P_{pub}
-            EC_POINT_mul(group_, temp_point, nullptr, temp_point, a_i, ctx);  // temp_point = a_i * h_i * P_{pub}
-            EC_POINT_add(group_, rhs, rhs, temp_point, ctx);  // 累加到 rhs
-
-            BN_free(a_i);
-            BN_free(h_i);
+        if (A.size() != L.Size() || !phi || !psi || !T || !Transcript::IsSupported(transcript_version) ||
+            std::find(A.begin(), A.end(), nullptr) != A.end()) {
+            return false;
         }
 
-        // 计算 ψ * E
-        EC_POINT_mul(group_, temp_point, nullptr, E, psi, ctx);  // temp_point = ψ * E
-        EC_POINT_add(group_, rhs, rhs, temp_point, ctx);  // 累加到 rhs
-
-         // 计算 (φ + ψ) * P
-        BN_mod_add(temp_bn, phi, psi, group_order, ctx);  // temp_bn = φ + ψ
-        EC_POINT_mul(group_, temp_point, nullptr, P, temp_bn, ctx);  // temp_point = (φ + ψ) * P
-        EC_POINT_add(group_, rhs, rhs, temp_point, ctx);  // 累加到 rhs
-
-        // 验证 ∑_{i=1}^{n} A_i 是否等于右侧计算结果
-        bool is_valid = (EC_POINT_cmp(group_, lhs, rhs, ctx) == 0);
-
-        // 清理资源
-        EC_POINT_free(lhs);
-        EC_POINT_free(rhs);
-        EC_POINT_free(E);
-        EC_POINT_free(temp_point);
-        BN_free(temp_bn);
-        BN_CTX_free(ctx);
+        // msg || event 只写入 H_3 一次，各分块复制该中间状态计算 a_i
+        Transcript prefix = member_hash_prefix(transcript_version, msg, event);
+
+        ScopedBnCtx scoped_ctx;
+        BN_CTX* ctx = scoped_ctx.get();
+        // 临时 BIGNUM 与点从线程局部的分配器借出，返回时统一归还
+        ScopedArena arena(group_.get());
+        const EC_GROUP* group = group_.get();
+        const BIGNUM* group_order = EC_GROUP_get0_order(group);
+        EC_POINT* lhs = arena.Point();  // 左侧求和项
+        EC_POINT* rhs = arena.Point();  // 右侧求和项
+        EC_POINT* temp_point = arena.Point();  // 临时计算点
+
+        // E = H_0(event) * P 的预计算表来自事件缓存
+        std::shared_ptr<const EcBackend::FixedBase> event_table = precompute_->EventTable(event);
+
+        // 右侧改写为多标量乘法加上固定基点乘法：
+        // ∑ a_i K_i + (∑ a_i) T  +  ψ E + (φ + ψ) P，其中 K_i = X_i + Y_i + h_i P_pub；
+        // 未预计算 K_i 时改为 ∑ a_i (X_i + Y_i) + (∑ a_i) T  +  (∑ a_i h_i) P_pub + ψ E + (φ + ψ) P
+        //
+        // 环成员按分块处理：每个分块计算 a_i，累加 ∑ A_i、∑ a_i h_i，并对本块成员及
+        // (本块 ∑ a_i) T 做一次多标量乘法，得到左右两侧的部分和。设置了线程池且环足够大时
+        // 各分块并行执行，否则只有一个分块并在调用线程上执行。
+        size_t n = L.Size();
+        bool combined = L.HasCombinedPoints();
+        size_t chunks = pool_ ? pool_->ChunkCount(n, RingContext::kMinMembersPerChunk) : 1;
+        std::vector<EC_POINT*>& partial_lhs = arena.List<EC_POINT*>();   // 本块 ∑ A_i
+        std::vector<EC_POINT*>& partial_rhs = arena.List<EC_POINT*>();   // 本块 ∑ a_i K_i + (∑ a_i) T
+        std::vector<BIGNUM*>& partial_ah = arena.List<BIGNUM*>();        // 本块 ∑ a_i h_i
+        for (size_t c = 0; c < chunks; ++c) {
+            partial_lhs.push_back(arena.Point());
+            partial_rhs.push_back(arena.Point());
+            partial_ah.push_back(arena.Bn());
+        }
+        auto verify_chunk = [&](size_t chunk, size_t begin, size_t end) {
+            ScopedBnCtx scoped_chunk_ctx;
+            BN_CTX* chunk_ctx = scoped_chunk_ctx.get();
+            ScopedArena chunk_arena(group);
+            BIGNUM* sum_a = chunk_arena.Bn();
+            BIGNUM* temp_bn = chunk_arena.Bn();
+            std::vector<const EC_POINT*>& points = chunk_arena.List<const EC_POINT*>();
+            std::vector<const BIGNUM*>& scalars = chunk_arena.List<const BIGNUM*>();
+            points.reserve(end - begin + 1);
+            scalars.reserve(end - begin + 1);
+            // 计算 a_i = H_3(msg || event || L_i || A_i)，按组批量输出
+            std::vector<BIGNUM*>& a = chunk_arena.List<BIGNUM*>();
+            a.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) a.push_back(chunk_arena.Bn());
+            member_hash_batch(a.data(), prefix, L, A.data(), begin, end, -1, chunk_ctx);
+            for (size_t i = begin; i < end; ++i) {
+                BIGNUM* a_i = a[i - begin];
+                BN_mod_add(sum_a, sum_a, a_i, group_order, chunk_ctx);
+                EC_POINT_add(group, partial_lhs[chunk], partial_lhs[chunk], A[i], chunk_ctx);
+                points.push_back(combined ? L[i].K : L[i].XY);
+                scalars.push_back(a_i);
+                if (!combined) {
+                    BN_mod_mul(temp_bn, a_i, L[i].h, group_order, chunk_ctx);
+                    BN_mod_add(partial_ah[chunk], partial_ah[chunk], temp_bn, group_order, chunk_ctx);
+                }
+            }
+
+            points.push_back(T);
+            scalars.push_back(sum_a);
+            backend_->MultiMul(group, partial_rhs[chunk], points, scalars, chunk_ctx);
+        };
+
+        BIGNUM* sum_ah = arena.Bn();                    // ∑ a_i h_i
+        BIGNUM* phi_psi = arena.Bn();                   // φ + ψ
+
+        bool is_valid = false;
+        try {
+            if (pool_) {
+                pool_->ParallelFor(n, verify_chunk, RingContext::kMinMembersPerChunk);
+            } else {
+                verify_chunk(0, 0, n);
+            }
+
+            // 按分块顺序归约左右两侧的部分和
+            for (size_t c = 0; c < chunks; ++c) {
+                EC_POINT_add(group, lhs, lhs, partial_lhs[c], ctx);
+                EC_POINT_add(group, rhs, rhs, partial_rhs[c], ctx);
+                BN_mod_add(sum_ah, sum_ah, partial_ah[c], group_order, ctx);
+            }
+
+            BN_mod_add(phi_psi, phi, psi, group_order, ctx);  // φ + ψ
+            if (!combined) {
+                precompute_->SystemPublicKey().Mul(temp_point, sum_ah, ctx);  // (∑ a_i h_i) P_pub
+                EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+            }
+            event_table->Mul(temp_point, psi, ctx);                        // ψ E
+            EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+            precompute_->Generator().Mul(temp_point, phi_psi, ctx);       // (φ + ψ) P
+            EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+
+            // 验证 ∑_{i=1}^{n} A_i 是否等于右侧计算结果
+            is_valid = (EC_POINT_cmp(group, lhs, rhs, ctx) == 0);
+        } catch (const std::exception&) {
+            is_valid = false;
+        }
 
         return is_valid;
     }
@@ -552,12 +774,253 @@ bool Signer::Verify(
     BIGNUM* phi,
     BIGNUM* psi,
     EC_POINT* T,
-    const std::string& msg,
+    std::string_view msg,
     const std::string& event,
-    std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>> ring_pubkeys) {
-    
-    // 调用私有的verify方法
-    return verify(A, phi, psi, T, msg, event, ring_pubkeys);
+    const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& ring_pubkeys,
+    int transcript_version) {
+
+    // 构建环上下文（按 ID 排序，环只使用一次，不预计算 K_i）后调用私有的verify方法。
+    // 该接口始终以返回值表示结果，含重复 ID 的环视为验证失败
+    try {
+        RingContext ring = CreateRingContext(ring_pubkeys, false);
+        return verify(A, phi, psi, T, msg, event, ring, transcript_version);
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
+bool Signer::Verify(
+    const std::vector<EC_POINT*>& A,
+    BIGNUM* phi,
+    BIGNUM* psi,
+    EC_POINT* T,
+    std::string_view msg,
+    const std::string& event,
+    const RingContext& ring,
+    int transcript_version) {
+
+    return verify(A, phi, psi, T, msg, event, ring, transcript_version);
+}
+
+bool Signer::Verify(
+    const Signature& signature, std::string_view msg, const std::string& event,
+    const std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>& ring_pubkeys) {
+
+    return Verify(signature.A, signature.phi, signature.psi, signature.T, msg, event, ring_pubkeys,
+                  signature.transcript_version);
+}
+
+bool Signer::Verify(const Signature& signature, std::string_view msg, const std::string& event,
+                    const RingContext& ring) {
+    return verify(signature.A, signature.phi, signature.psi, signature.T, msg, event, ring,
+                  signature.transcript_version);
+}
+
+// 批量验证中单个签名的预处理结果：a_i、∑ a_i 与 ∑ A_i 只计算一次，供各次合并检查复用。
+// BIGNUM、点与 a_i 列表均从 VerifyBatch 的 ScopedArena 借出，随其作用域一起归还
+struct Signer::BatchItem {
+    const SignatureInput* input;
+    std::vector<BIGNUM*>& a;                              // a_i
+    BIGNUM* sum_a;                                        // ∑ a_i
+    BIGNUM* phi_psi;                                      // φ + ψ
+    EC_POINT* sum_A;                                      // ∑ A_i
+    std::shared_ptr<const EcBackend::FixedBase> event_table;    // E = H_0(event) * P
+
+    BatchItem(const SignatureInput* input, ScopedArena& arena)
+        : input(input), a(arena.List<BIGNUM*>()), sum_a(arena.Bn()), phi_psi(arena.Bn()), sum_A(arena.Point()) {}
+    BatchItem(const BatchItem&) = delete;
+    BatchItem& operator=(const BatchItem&) = delete;
+};
+
+std::vector<bool> Signer::VerifyBatch(const std::vector<SignatureInput>& inputs) {
+    return VerifyBatch(inputs.data(), inputs.size());
+}
+
+std::vector<bool> Signer::VerifyBatch(const SignatureInput* inputs, size_t count) {
+    std::vector<bool> results(count, false);
+    if (!group_ || !precompute_) {
+        throw std::runtime_error("System configuration not loaded.");
+    }
+
+
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+    ScopedArena arena(group_.get());
+    const EC_GROUP* group = group_.get();
+    const BIGNUM* group_order = EC_GROUP_get0_order(group);
+    std::vector<std::unique_ptr<BatchItem>> items(count);
+    std::vector<size_t> pending;
+    pending.reserve(count);
+
+    // 预处理：检查签名结构并计算 a_i、∑ a_i、φ + ψ 与 ∑ A_i，结构不合法的签名直接判为无效
+    for (size_t j = 0; j < count; ++j) {
+        const SignatureInput& input = inputs[j];
+        const Signature& sig = input.signature;
+        const RingContext& L = input.ring;
+        if (sig.A.size() != L.Size() || !sig.phi || !sig.psi || !sig.T ||
+            std::find(sig.A.begin(), sig.A.end(), nullptr) != sig.A.end()) {
+            continue;
+        }
+
+        try {
+            std::unique_ptr<BatchItem> item(new BatchItem(&input, arena));
+            item->a.reserve(L.Size());
+            Transcript prefix = member_hash_prefix(sig.transcript_version, input.msg, input.event);
+            for (size_t i = 0; i < L.Size(); ++i) item->a.push_back(arena.Bn());
+            member_hash_batch(item->a.data(), prefix, L, sig.A.data(), 0, L.Size(), -1, ctx);
+            for (size_t i = 0; i < L.Size(); ++i) {
+                BIGNUM* a_i = item->a[i];
+                BN_mod_add(item->sum_a, item->sum_a, a_i, group_order, ctx);
+                EC_POINT_add(group, item->sum_A, item->sum_A, sig.A[i], ctx);
+            }
+            BN_mod_add(item->phi_psi, sig.phi, sig.psi, group_order, ctx);
+            item->event_table = precompute_->EventTable(input.event);
+            items[j] = std::move(item);
+            pending.push_back(j);
+        } catch (const std::exception&) {
+            // 预处理失败的签名视为无效
+        }
+    }
+
+    if (!pending.empty()) {
+        verify_batch_bisect(items, pending, false, results);
+    }
+    return results;
+}
+
+void Signer::verify_batch_bisect(const std::vector<std::unique_ptr<BatchItem>>& items,
+                                 const std::vector<size_t>& indices, bool known_bad, std::vector<bool>& results) {
+    // 单个签名总是做一次精确检查（权重为 1）
+    if (indices.size() == 1 || !known_bad) {
+        if (verify_batch_subset(items, indices)) {
+            for (size_t j : indices) results[j] = true;
+            return;
+        }
+        if (indices.size() == 1) {
+            return;
+        }
+    }
+
+    // 合并检查失败：拆成两半，左半通过时无效签名必在右半，右半可跳过整体检查
+    size_t half = indices.size() / 2;
+    std::vector<size_t> left(indices.begin(), indices.begin() + half);
+    std::vector<size_t> right(indices.begin() + half, indices.end());
+    verify_batch_bisect(items, left, false, results);
+    bool left_valid = std::all_of(left.begin(), left.end(), [&results](size_t j) { return results[j]; });
+    verify_batch_bisect(items, right, left_valid, results);
+}
+
+bool Signer::verify_batch_subset(const std::vector<std::unique_ptr<BatchItem>>& items,
+                                 const std::vector<size_t>& indices) {
+    // 对每个签名 j 取随机权重 w_j，检查
+    //   ∑_j w_j (∑ a_ji K_ji + (∑ a_ji) T_j + ψ_j E_j + (φ_j + ψ_j) P - ∑ A_ji) = O
+    // 同一环上下文的 K_i（或 X_i + Y_i）系数合并为 ∑_j w_j a_ji，同一事件的 E 系数合并为 ∑_j w_j ψ_j，
+    // P 与 P_pub 各只需一次固定基点乘法。
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+    // 本次检查的所有系数与临时点从分配器借出，返回时统一归还
+    ScopedArena arena(group_.get());
+    const EC_GROUP* group = group_.get();
+    const BIGNUM* group_order = EC_GROUP_get0_order(group);
+
+    bool is_valid = false;
+    try {
+        EC_POINT* result = arena.Point();
+        EC_POINT* temp_point = arena.Point();
+        BIGNUM* g_coeff = arena.Bn();      // ∑ w_j (φ_j + ψ_j)
+        BIGNUM* ppub_coeff = arena.Bn();   // ∑ (∑_j w_j a_ji) h_i，仅用于未预计算 K_i 的环
+        BIGNUM* temp_bn = arena.Bn();
+        std::vector<const EC_POINT*>& points = arena.List<const EC_POINT*>();
+        std::vector<const BIGNUM*>& scalars = arena.List<const BIGNUM*>();
+        // 按环上下文对象与事件分组的系数
+        std::vector<std::pair<const RingContext*, std::vector<BIGNUM*>*>> ring_coeffs;
+        std::unordered_map<const RingContext*, size_t> ring_index;
+        std::vector<std::pair<const EC_POINT*, BIGNUM*>> event_coeffs;
+        std::unordered_map<std::string, size_t> event_index;
+
+        for (size_t j : indices) {
+            const BatchItem& item = *items[j];
+            const Signature& sig = item.input->signature;
+            const RingContext* L = &item.input->ring;
+
+            BIGNUM* w = arena.Bn();
+            if (indices.size() == 1) {
+                BN_one(w);
+            } else {
+                do {
+                    if (!BN_rand(w, kBatchWeightBits, BN_RAND_TOP_ANY, BN_RAND_BOTTOM_ANY)) {
+                        throw std::runtime_error("Failed to generate batch weight");
+                    }
+                } while (BN_is_zero(w));
+            }
+
+            // (w_j ∑ a_ji) T_j 与 -w_j ∑ A_ji
+            BIGNUM* t_coeff = arena.Bn();
+            BN_mod_mul(t_coeff, w, item.sum_a, group_order, ctx);
+            points.push_back(sig.T);
+            scalars.push_back(t_coeff);
+            BIGNUM* neg_w = arena.Bn();
+            BN_mod_sub(neg_w, group_order, w, group_order, ctx);
+            points.push_back(item.sum_A);
+            scalars.push_back(neg_w);
+
+            // w_j (φ_j + ψ_j) 累加到 P 的系数
+            BN_mod_mul(temp_bn, w, item.phi_psi, group_order, ctx);
+            BN_mod_add(g_coeff, g_coeff, temp_bn, group_order, ctx);
+
+            // w_j ψ_j 累加到事件点 E 的系数
+            auto event_it = event_index.find(item.input->event);
+            if (event_it == event_index.end()) {
+                event_it = event_index.emplace(item.input->event, event_coeffs.size()).first;
+                event_coeffs.emplace_back(item.event_table->GetBase(), arena.Bn());
+            }
+            BIGNUM* e_coeff = event_coeffs[event_it->second].second;
+            BN_mod_mul(temp_bn, w, sig.psi, group_order, ctx);
+            BN_mod_add(e_coeff, e_coeff, temp_bn, group_order, ctx);
+
+            // w_j a_ji 累加到环成员基点的系数
+            auto ring_it = ring_index.find(L);
+            if (ring_it == ring_index.end()) {
+                ring_it = ring_index.emplace(L, ring_coeffs.size()).first;
+                std::vector<BIGNUM*>& coeffs = arena.List<BIGNUM*>();
+                coeffs.reserve(L->Size());
+                for (size_t i = 0; i < L->Size(); ++i) coeffs.push_back(arena.Bn());
+                ring_coeffs.emplace_back(L, &coeffs);
+            }
+            std::vector<BIGNUM*>& coeffs = *ring_coeffs[ring_it->second].second;
+            for (size_t i = 0; i < coeffs.size(); ++i) {
+                BN_mod_mul(temp_bn, w, item.a[i], group_order, ctx);
+                BN_mod_add(coeffs[i], coeffs[i], temp_bn, group_order, ctx);
+            }
+        }
+
+        for (const auto& [L, coeffs] : ring_coeffs) {
+            bool combined = L->HasCombinedPoints();
+            for (size_t i = 0; i < coeffs->size(); ++i) {
+                points.push_back(combined ? (*L)[i].K : (*L)[i].XY);
+                scalars.push_back((*coeffs)[i]);
+                if (!combined) {
+                    BN_mod_mul(temp_bn, (*coeffs)[i], (*L)[i].h, group_order, ctx);
+                    BN_mod_add(ppub_coeff, ppub_coeff, temp_bn, group_order, ctx);
+                }
+            }
+        }
+        for (const auto& [E, coeff] : event_coeffs) {
+            points.push_back(E);
+            scalars.push_back(coeff);
+        }
+
+        backend_->MultiMul(group, result, points, scalars, ctx);
+        precompute_->SystemPublicKey().Mul(temp_point, ppub_coeff, ctx);
+        EC_POINT_add(group, result, result, temp_point, ctx);
+        precompute_->Generator().Mul(temp_point, g_coeff, ctx);
+        EC_POINT_add(group, result, result, temp_point, ctx);
+
+        is_valid = EC_POINT_is_at_infinity(group, result) == 1;
+    } catch (const std::exception&) {
+        is_valid = false;
+    }
+    return is_valid;
 }
 
 } // namespace ring_signature_lib
@@ -0,0 +1,96 @@
+#include "libringsign/thread_pool.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace ring_signature_lib {
+
+ThreadPool::ThreadPool(size_t threads) : stop_(false) {
+    if (threads == 0) threads = 1;
+    workers_.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+size_t ThreadPool::ChunkCount(size_t count, size_t min_chunk_size) const {
+    if (count == 0) return 0;
+    size_t chunks = count / (min_chunk_size == 0 ? 1 : min_chunk_size);
+    if (chunks == 0) chunks = 1;
+    return chunks < Size() ? chunks : Size();
+}
+
+size_t ThreadPool::DefaultThreadCount() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+void ThreadPool::worker_loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            if (stop_ && tasks_.empty()) return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t, size_t, size_t)>& fn,
+                             size_t min_chunk_size) {
+    size_t chunks = ChunkCount(count, min_chunk_size);
+    if (chunks == 0) return;
+    if (chunks == 1) {
+        fn(0, 0, count);
+        return;
+    }
+
+    // 各执行者（工作线程与调用线程）从共享计数器领取分块，直到领完为止
+    struct Job {
+        std::atomic<size_t> next{0};
+        size_t done = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto job = std::make_shared<Job>();
+    auto run = [job, chunks, count, &fn]() {
+        for (;;) {
+            size_t chunk = job->next++;
+            if (chunk >= chunks) return;
+            try {
+                fn(chunk, chunk * count / chunks, (chunk + 1) * count / chunks);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                if (!job->error) job->error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(job->mutex);
+            if (++job->done == chunks) job->cv.notify_all();
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 1; i < chunks; ++i) tasks_.emplace_back(run);
+    }
+    cv_.notify_all();
+    run();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->cv.wait(lock, [&job, chunks] { return job->done == chunks; });
+    if (job->error) std::rethrow_exception(job->error);
+}
+
+} // namespace ring_signature_lib
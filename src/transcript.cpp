@@ -0,0 +1,107 @@
+#include "libringsign/transcript.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ring_signature_lib {
+
+namespace {
+
+// 非压缩点编码的最大长度（1 字节前缀 + 两个坐标，坐标不超过 66 字节）
+const size_t kMaxPointBytes = 1 + 2 * 66;
+
+const char kHexDigits[] = "0123456789ABCDEF";
+
+void to_hex(const unsigned char* data, size_t len, char* out) {
+    for (size_t i = 0; i < len; ++i) {
+        out[2 * i] = kHexDigits[data[i] >> 4];
+        out[2 * i + 1] = kHexDigits[data[i] & 0x0f];
+    }
+}
+
+size_t encode_point(const EC_GROUP* group, const EC_POINT* point, point_conversion_form_t form,
+                    unsigned char* buf, BN_CTX* ctx) {
+    size_t len = EC_POINT_point2oct(group, point, form, buf, kMaxPointBytes, ctx);
+    if (len == 0) {
+        throw std::runtime_error("Failed to encode EC point");
+    }
+    return len;
+}
+
+} // namespace
+
+PointEncoding PointEncoding::Encode(const EC_GROUP* group, const EC_POINT* point, BN_CTX* ctx) {
+    unsigned char buf[kMaxPointBytes];
+    size_t len = encode_point(group, point, POINT_CONVERSION_UNCOMPRESSED, buf, ctx);
+
+    PointEncoding encoding;
+    encoding.hex.resize(2 * len);
+    to_hex(buf, len, &encoding.hex[0]);
+    if (len == 1) {
+        // 无穷远点只有一个零字节
+        encoding.compressed.assign(1, '\0');
+    } else {
+        // 压缩格式：0x02 | (y 的奇偶性)，后接 x 坐标
+        size_t field_len = (len - 1) / 2;
+        encoding.compressed.resize(1 + field_len);
+        encoding.compressed[0] = static_cast<char>(0x02 | (buf[len - 1] & 1));
+        encoding.compressed.replace(1, field_len, reinterpret_cast<const char*>(buf + 1), field_len);
+    }
+    return encoding;
+}
+
+Transcript::Transcript(const HashUtils& hash, int version) : state_(hash), version_(version) {
+    if (!IsSupported(version)) {
+        throw std::invalid_argument("Unsupported transcript version");
+    }
+}
+
+void Transcript::FinalToBnBatch(Transcript* const* transcripts, BIGNUM* const* out, size_t count) {
+    HashState* states[HashState::kBatchSize];
+    for (size_t begin = 0; begin < count; begin += HashState::kBatchSize) {
+        size_t n = std::min(count - begin, HashState::kBatchSize);
+        for (size_t i = 0; i < n; ++i) states[i] = &transcripts[begin + i]->state_;
+        HashState::FinalToBnBatch(states, out + begin, n);
+    }
+}
+
+void Transcript::append_length(size_t len) {
+    if (len > UINT32_MAX) {
+        throw std::length_error("Transcript field too long");
+    }
+    unsigned char prefix[4] = {
+        static_cast<unsigned char>(len >> 24), static_cast<unsigned char>(len >> 16),
+        static_cast<unsigned char>(len >> 8), static_cast<unsigned char>(len)};
+    state_.Update(prefix, sizeof(prefix));
+}
+
+void Transcript::AppendString(std::string_view data) {
+    if (version_ == TRANSCRIPT_VERSION_2) {
+        append_length(data.size());
+    }
+    state_.Update(data);
+}
+
+void Transcript::AppendPoint(const EC_GROUP* group, const EC_POINT* point, BN_CTX* ctx) {
+    unsigned char buf[kMaxPointBytes];
+    if (version_ == TRANSCRIPT_VERSION_2) {
+        size_t len = encode_point(group, point, POINT_CONVERSION_COMPRESSED, buf, ctx);
+        append_length(len);
+        state_.Update(buf, len);
+        return;
+    }
+    size_t len = encode_point(group, point, POINT_CONVERSION_UNCOMPRESSED, buf, ctx);
+    char hex[2 * kMaxPointBytes];
+    to_hex(buf, len, hex);
+    state_.Update(hex, 2 * len);
+}
+
+void Transcript::AppendPoint(const PointEncoding& encoding) {
+    if (version_ == TRANSCRIPT_VERSION_2) {
+        append_length(encoding.compressed.size());
+        state_.Update(encoding.compressed);
+        return;
+    }
+    state_.Update(encoding.hex);
+}
+
+} // namespace ring_signature_lib
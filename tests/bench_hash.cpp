@@ -0,0 +1,243 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <openssl/bn.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include "libringsign/hash_utils.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/sha256_multi.h"
+#include "libringsign/transcript.h"
+
+using namespace ring_signature_lib;
+using namespace std::chrono;
+
+// 原有的 hashToBn 实现：每次调用都获取 HMAC、新建上下文并重新设置密钥
+BIGNUM* legacy_hash_to_bn(const std::string& key, const EVP_MD* md, const std::string& data) {
+    unsigned char hash[EVP_MAX_MD_SIZE];
+    size_t hash_len;
+    EVP_MAC* mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+    EVP_MAC_CTX* ctx = EVP_MAC_CTX_new(mac);
+    EVP_MAC_free(mac);
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string("digest", const_cast<char*>(EVP_MD_get0_name(md)), 0),
+        OSSL_PARAM_END
+    };
+    EVP_MAC_init(ctx, reinterpret_cast<const unsigned char*>(key.c_str()), key.length(), params);
+    EVP_MAC_update(ctx, reinterpret_cast<const unsigned char*>(data.c_str()), data.length());
+    EVP_MAC_final(ctx, hash, &hash_len, sizeof(hash));
+    EVP_MAC_CTX_free(ctx);
+    return BN_bin2bn(hash, hash_len, nullptr);
+}
+
+template <typename F>
+double time_ns(F&& f, int iterations) {
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) f();
+    auto end = high_resolution_clock::now();
+    return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 20000;
+    const std::string key = "hash_key_123456789";
+    HashUtils hash(key);
+
+    // 典型的 H_3 输入长度：消息、事件、ID 与三个压缩点
+    for (size_t len : {32, 160, 1024}) {
+        std::string data(len, 'x');
+
+        BIGNUM* expected = legacy_hash_to_bn(key, EVP_sha256(), data);
+        BIGNUM* actual = hash.hashToBn(data);
+        assert(BN_cmp(expected, actual) == 0);
+        BN_free(expected);
+        BN_free(actual);
+
+        double legacy_ns = time_ns([&] { BN_free(legacy_hash_to_bn(key, EVP_sha256(), data)); }, iterations);
+        double pooled_ns = time_ns([&] { BN_free(hash.hashToBn(data)); }, iterations);
+        std::cout << "hashToBn " << len << " bytes"
+                  << "  per-call setup: " << legacy_ns << " ns"
+                  << "  pre-keyed dup: " << pooled_ns << " ns"
+                  << "  speedup: " << legacy_ns / pooled_ns << "x" << std::endl;
+    }
+
+    // H_3 的 msg || event 前缀：每个成员重新哈希整条消息 vs 复制只哈希一次的中间状态
+    {
+        std::string msg(1 << 20, 'm');
+        std::string event = "event";
+        const int members = 500;
+        auto suffix = [](Transcript& transcript, int i) {
+            transcript.AppendString("member" + std::to_string(i));
+            BN_free(transcript.FinalToBn());
+        };
+        double rehash_ns = time_ns([&] {
+            for (int i = 0; i < members; ++i) {
+                Transcript transcript(hash, TRANSCRIPT_VERSION_2);
+                transcript.AppendString(msg);
+                transcript.AppendString(event);
+                suffix(transcript, i);
+            }
+        }, 1);
+        double midstate_ns = time_ns([&] {
+            Transcript prefix(hash, TRANSCRIPT_VERSION_2);
+            prefix.AppendString(msg);
+            prefix.AppendString(event);
+            for (int i = 0; i < members; ++i) {
+                Transcript transcript(prefix);
+                suffix(transcript, i);
+            }
+        }, 1);
+        std::cout << "H_3 1 MB message x " << members << " members"
+                  << "  re-hash: " << rehash_ns / 1e6 << " ms"
+                  << "  shared midstate: " << midstate_ns / 1e6 << " ms" << std::endl;
+    }
+
+    // θ = H_4(... || L)：原实现把所有成员的 ID 与十六进制公钥拼接成一个字符串后哈希；
+    // 现在逐成员写入运行中的 HMAC 状态，内存占用与环大小无关
+    {
+        const int members = 10000;
+        EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+        BN_CTX* ctx = BN_CTX_new();
+        BIGNUM* k = BN_new();
+        EC_POINT* point = EC_POINT_new(group);
+        std::vector<std::string> ids;
+        std::vector<PointEncoding> encodings;
+        for (int i = 0; i < members; ++i) {
+            BN_set_word(k, i + 1);
+            EC_POINT_mul(group, point, k, nullptr, nullptr, ctx);
+            ids.push_back("signer" + std::to_string(i + 1));
+            encodings.push_back(PointEncoding::Encode(group, point, ctx));
+        }
+        size_t theta_input_bytes = 0;
+        double concat_ns = time_ns([&] {
+            std::string theta_input = "msg";
+            for (int i = 0; i < members; ++i) {
+                theta_input += ids[i] + encodings[i].hex + encodings[i].hex;
+            }
+            theta_input_bytes = theta_input.size();
+            BN_free(hash.hashToBn(theta_input));
+        }, 10);
+        std::cout << "theta " << members << " members  concatenated string (" << theta_input_bytes / 1024
+                  << " KB): " << concat_ns / 1e6 << " ms";
+        for (int version : {TRANSCRIPT_VERSION_1, TRANSCRIPT_VERSION_2}) {
+            double streaming_ns = time_ns([&] {
+                Transcript transcript(hash, version);
+                transcript.AppendString("msg");
+                for (int i = 0; i < members; ++i) {
+                    transcript.AppendString(ids[i]);
+                    transcript.AppendPoint(encodings[i]);
+                    transcript.AppendPoint(encodings[i]);
+                }
+                BN_free(transcript.FinalToBn());
+            }, 10);
+            std::cout << "  streaming v" << version << ": " << streaming_ns / 1e6 << " ms";
+        }
+        std::cout << std::endl;
+        BN_free(k);
+        EC_POINT_free(point);
+        BN_CTX_free(ctx);
+        EC_GROUP_free(group);
+    }
+
+    // 各成员的 a_i = H_3(msg || event || L_i || A_i)：逐个输出 vs 每 16 个一组多缓冲输出
+    {
+        const int members = 1024;
+        EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+        BN_CTX* ctx = BN_CTX_new();
+        BIGNUM* k = BN_new();
+        EC_POINT* point = EC_POINT_new(group);
+        std::vector<std::string> ids;
+        std::vector<PointEncoding> encodings;
+        for (int i = 0; i < members; ++i) {
+            BN_set_word(k, i + 1);
+            EC_POINT_mul(group, point, k, nullptr, nullptr, ctx);
+            ids.push_back("signer" + std::to_string(i + 1));
+            encodings.push_back(PointEncoding::Encode(group, point, ctx));
+        }
+        std::vector<BIGNUM*> out;
+        for (int i = 0; i < members; ++i) out.push_back(BN_new());
+        std::cout << "H_3 x " << members << " members, kernel "
+                  << Sha256MultiBuffer::Name(Sha256MultiBuffer::Active());
+        for (int version : {TRANSCRIPT_VERSION_1, TRANSCRIPT_VERSION_2}) {
+            Transcript prefix(hash, version);
+            prefix.AppendString("message");
+            prefix.AppendString("event");
+            auto member = [&](Transcript& transcript, int i) {
+                transcript.AppendString(ids[i]);
+                transcript.AppendPoint(encodings[i]);
+                transcript.AppendPoint(encodings[i]);
+                transcript.AppendPoint(encodings[i]);
+            };
+            double single_ns = time_ns([&] {
+                for (int i = 0; i < members; ++i) {
+                    Transcript transcript(prefix);
+                    member(transcript, i);
+                    transcript.FinalToBn(out[i]);
+                }
+            }, 20);
+            double batch_ns = time_ns([&] {
+                std::vector<Transcript> transcripts(HashState::kBatchSize, prefix);
+                Transcript* pointers[HashState::kBatchSize];
+                for (int begin = 0; begin < members; begin += HashState::kBatchSize) {
+                    for (size_t j = 0; j < HashState::kBatchSize; ++j) {
+                        transcripts[j] = prefix;
+                        member(transcripts[j], begin + static_cast<int>(j));
+                        pointers[j] = &transcripts[j];
+                    }
+                    Transcript::FinalToBnBatch(pointers, &out[begin], HashState::kBatchSize);
+                }
+            }, 20);
+            std::cout << "  v" << version << " one by one: " << single_ns / members << " ns"
+                      << "  batched: " << batch_ns / members << " ns"
+                      << "  speedup: " << single_ns / batch_ns << "x";
+        }
+        std::cout << std::endl;
+
+        // 压缩函数本身：每个实现每个分组的平均时间
+        const size_t lanes = 64, blocks = 4;
+        std::vector<unsigned char> data(lanes * blocks * 64, 0x5a);
+        std::vector<uint32_t> states(lanes * 8, 1);
+        std::vector<Sha256MultiBuffer::Lane> lane_list(lanes);
+        for (size_t i = 0; i < lanes; ++i) lane_list[i] = {&states[8 * i], &data[i * blocks * 64], blocks};
+        std::cout << "SHA-256 compression per block";
+        for (int kernel = Sha256MultiBuffer::kScalar; kernel <= Sha256MultiBuffer::kAvx512; ++kernel) {
+            auto selected = static_cast<Sha256MultiBuffer::Kernel>(kernel);
+            if (!Sha256MultiBuffer::IsSupported(selected)) continue;
+            double ns = time_ns([&] { Sha256MultiBuffer::Compress(selected, lane_list.data(), lanes); }, 2000);
+            std::cout << "  " << Sha256MultiBuffer::Name(selected) << ": " << ns / (lanes * blocks) << " ns";
+        }
+        std::cout << std::endl;
+
+        for (auto* bn : out) BN_free(bn);
+        BN_free(k);
+        EC_POINT_free(point);
+        BN_CTX_free(ctx);
+        EC_GROUP_free(group);
+    }
+
+    // BN_CTX 的开销主要在首次使用时为内部 BIGNUM 分配内存，因此每次借用后执行一次模乘
+    BIGNUM* a = hash.hashToBn("a");
+    BIGNUM* b = hash.hashToBn("b");
+    BIGNUM* m = hash.hashToBn("m");
+    BIGNUM* r = BN_new();
+    double new_ctx_ns = time_ns([&] {
+        BN_CTX* ctx = BN_CTX_new();
+        BN_mod_mul(r, a, b, m, ctx);
+        BN_CTX_free(ctx);
+    }, iterations);
+    double pooled_ctx_ns = time_ns([&] {
+        ScopedBnCtx ctx;
+        BN_mod_mul(r, a, b, m, ctx.get());
+    }, iterations);
+    std::cout << "BN_CTX + BN_mod_mul  new/free: " << new_ctx_ns << " ns"
+              << "  pooled: " << pooled_ctx_ns << " ns" << std::endl;
+    BN_free(a);
+    BN_free(b);
+    BN_free(m);
+    BN_free(r);
+    return 0;
+}
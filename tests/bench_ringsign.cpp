@@ -0,0 +1,742 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/objects.h>
+#include <nlohmann/json.hpp>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/hash_utils.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/precompute.h"
+#include "libringsign/sha256_multi.h"
+#include "libringsign/signature_codec.h"
+
+using namespace ring_signature_lib;
+using json = nlohmann::json;
+
+// 结果文件的格式版本，比较时要求一致
+const int kResultFormatVersion = 1;
+
+struct Options {
+    std::vector<size_t> sizes = {2, 10, 100, 1000, 10000, 100000};
+    std::string filter;
+    double min_time = 0.5;        // 每个 (基准, 环大小) 至少测量的秒数
+    size_t min_samples = 5;
+    size_t max_samples = 100;
+    size_t threads = 1;
+    std::string output_file;
+    std::string baseline_file;
+    std::string input_file;
+    double threshold = 0.05;      // 中位数变化超过该比例才判定为回退或改进
+    double alpha = 0.05;          // Mann-Whitney U 单侧检验的显著性水平
+    bool list = false;
+};
+
+void print_usage() {
+    std::cout << "用法: ./bench_ringsign [-n <环大小列表>] [-f <过滤>] [-t <秒>] [-r <样本数>] [-j <线程数>] [-o <输出文件>]\n"
+                 "                        [-b <基线文件>] [-i <结果文件>] [-T <阈值>] [-a <显著性水平>] [-l]\n";
+    std::cout << "参数说明:\n";
+    std::cout << "  -n: 逗号分隔的环大小 (可选，默认 2,10,100,1000,10000,100000)；每个基准在各环大小下对 n 个成员执行一次\n";
+    std::cout << "  -f: 只运行名称包含该子串的基准 (可选)\n";
+    std::cout << "  -t: 每个基准每个环大小至少测量的秒数 (可选，默认 0.5)\n";
+    std::cout << "  -r: 每个基准每个环大小至少采集的样本数 (可选，默认 5，不少于 3)\n";
+    std::cout << "  -j: 签名、验证与批量签发使用的线程数 (可选，默认 1)\n";
+    std::cout << "  -o: 结果 JSON 的输出文件 (可选，默认输出到屏幕)\n";
+    std::cout << "  -b: 与基线结果 JSON 比较，有显著回退时返回 1\n";
+    std::cout << "  -i: 不运行基准，直接读取已保存的结果与 -b 的基线比较\n";
+    std::cout << "  -T: 判定回退/改进的中位数相对变化阈值 (可选，默认 0.05)\n";
+    std::cout << "  -a: 判定回退/改进的单侧 Mann-Whitney U 检验显著性水平 (可选，默认 0.05)\n";
+    std::cout << "  -l: 列出全部基准名称\n";
+    std::cout << "进度与比较摘要输出到标准错误，结果 JSON 输出到标准输出或 -o 指定的文件。\n";
+}
+
+// ---------------------------------------------------------------------------
+// 统计
+// ---------------------------------------------------------------------------
+
+double median_of(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// 自由度为 df 的 t 分布 0.975 分位数，df > 30 时取正态近似
+double t_quantile_975(size_t df) {
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df == 0) return 0;
+    return df <= 30 ? table[df - 1] : 1.96;
+}
+
+// 各样本为一次执行（覆盖 n 个成员）的平均纳秒数
+json summarize(const std::vector<double>& samples) {
+    size_t n = samples.size();
+    double mean = 0;
+    for (double s : samples) mean += s;
+    mean /= n;
+    double variance = 0;
+    for (double s : samples) variance += (s - mean) * (s - mean);
+    double stddev = n > 1 ? std::sqrt(variance / (n - 1)) : 0;
+    double median = median_of(samples);
+    std::vector<double> deviations;
+    for (double s : samples) deviations.push_back(std::fabs(s - median));
+    double half_width = n > 1 ? t_quantile_975(n - 1) * stddev / std::sqrt(static_cast<double>(n)) : 0;
+    return {{"median_ns", median},
+            {"mean_ns", mean},
+            {"stddev_ns", stddev},
+            {"min_ns", *std::min_element(samples.begin(), samples.end())},
+            {"max_ns", *std::max_element(samples.begin(), samples.end())},
+            {"mad_ns", median_of(deviations)},
+            {"ci95_ns", {mean - half_width, mean + half_width}}};
+}
+
+// 单侧 Mann-Whitney U 检验：H1 为 x 的分布整体大于 y，返回 p 值。
+// 两组都不超过 30 个样本时用无结假设下的精确分布，否则用带结校正与连续性校正的正态近似
+double mann_whitney_greater(const std::vector<double>& x, const std::vector<double>& y) {
+    size_t m = x.size(), n = y.size();
+    if (m == 0 || n == 0) return 1.0;
+    double u = 0;
+    for (double a : x) {
+        for (double b : y) u += a > b ? 1.0 : (a == b ? 0.5 : 0.0);
+    }
+
+    if (m <= 30 && n <= 30) {
+        // count[i][j][k]：i 个 x 与 j 个 y 的排列中 U = k 的个数
+        size_t max_u = m * n;
+        std::vector<std::vector<std::vector<double>>> count(
+            m + 1, std::vector<std::vector<double>>(n + 1, std::vector<double>(max_u + 1, 0)));
+        for (size_t i = 0; i <= m; ++i) {
+            for (size_t j = 0; j <= n; ++j) {
+                if (i == 0 || j == 0) {
+                    count[i][j][0] = 1;
+                    continue;
+                }
+                // 最大的元素来自 x 时它大于全部 j 个 y
+                for (size_t k = 0; k <= i * j; ++k) {
+                    double from_x = k >= j ? count[i - 1][j][k - j] : 0;
+                    count[i][j][k] = from_x + count[i][j - 1][k];
+                }
+            }
+        }
+        double total = 0, tail = 0;
+        for (size_t k = 0; k <= max_u; ++k) {
+            total += count[m][n][k];
+            if (static_cast<double>(k) >= u - 1e-9) tail += count[m][n][k];
+        }
+        return tail / total;
+    }
+
+    std::vector<double> pooled(x);
+    pooled.insert(pooled.end(), y.begin(), y.end());
+    std::sort(pooled.begin(), pooled.end());
+    double tie_sum = 0;
+    for (size_t i = 0; i < pooled.size();) {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j] == pooled[i]) ++j;
+        double t = static_cast<double>(j - i);
+        tie_sum += t * t * t - t;
+        i = j;
+    }
+    double total = static_cast<double>(m + n);
+    double variance = m * n / 12.0 * ((total + 1) - tie_sum / (total * (total - 1)));
+    if (variance <= 0) return 1.0;
+    double z = (u - m * n / 2.0 - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// ---------------------------------------------------------------------------
+// 测量
+// ---------------------------------------------------------------------------
+
+// 每个样本至少持续的时间，使计时器精度与循环开销可以忽略
+const double kMinSampleSeconds = 0.01;
+
+double elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 预热一次并据此确定每个样本的重复次数，之后采样直到样本数与总时间都达到下限
+json measure(const std::function<void()>& run, const Options& options) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    double warmup_ns = elapsed_ns(start);
+    size_t iterations = std::max<size_t>(1, static_cast<size_t>(std::ceil(kMinSampleSeconds * 1e9 / std::max(warmup_ns, 1.0))));
+
+    std::vector<double> samples;
+    double total_ns = 0;
+    while (samples.size() < options.max_samples &&
+           (samples.size() < options.min_samples || total_ns < options.min_time * 1e9)) {
+        auto sample_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) run();
+        double ns = elapsed_ns(sample_start);
+        total_ns += ns;
+        samples.push_back(ns / iterations);
+    }
+    json result = summarize(samples);
+    result["iterations"] = iterations;
+    result["samples_ns"] = samples;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// 基准数据
+// ---------------------------------------------------------------------------
+
+void free_signature(Signature* sig) {
+    for (auto* p : sig->A) EC_POINT_free(p);
+    BN_free(sig->phi);
+    BN_free(sig->psi);
+    EC_POINT_free(sig->T);
+    delete sig;
+}
+
+using SignaturePtr = std::unique_ptr<Signature, decltype(&free_signature)>;
+
+// 全部环大小共用的成员：按需增长到最大的环，第 0 个成员是签名者自己。
+// 每个成员带有完整公钥、一个随机标量以及 H_3 长度的哈希输入
+class Population {
+public:
+    Population(const std::string& config_path, const std::string& key_path, size_t threads) {
+        keygen_.Initialize();
+        keygen_.SaveConfig(config_path, key_path);
+        keygen_.SetThreadCount(threads);
+        parameters_.Initialize("", config_path);
+        self_.Initialize("signer1", parameters_);
+        self_.SetThreadCount(threads);
+        auto partial_key = self_.GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen_.GenerateSignKey("signer1", partial_key.second);
+        self_.GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        add_member("signer1", self_.GetPublicKey());
+        EC_POINT* points[] = {X_.back().get(), Y_.back().get()};
+        MakeAffine(group(), points, 2, ctx());
+    }
+
+    KeyGenerator& Keygen() { return keygen_; }
+    Signer& Self() { return self_; }
+    const EC_GROUP* group() const { return self_.GetGroup(); }
+    BN_CTX* ctx() { return ctx_.get(); }
+    size_t Size() const { return ids_.size(); }
+    const std::string& Id(size_t i) const { return ids_[i]; }
+    EC_POINT* X(size_t i) const { return X_[i].get(); }
+    const BIGNUM* Scalar(size_t i) const { return scalars_[i].get(); }
+    const std::string& HashInput(size_t i) const { return hash_inputs_[i]; }
+
+    // 补足到 n 个成员：分块生成签名者，部分密钥按块批量签发，只保留公钥
+    void Grow(size_t n) {
+        const size_t chunk_size = 1024;
+        while (Size() < n) {
+            size_t count = std::min(chunk_size, n - Size());
+            std::vector<Signer> signers(count);
+            std::vector<std::pair<std::string, const EC_POINT*>> entries;
+            for (size_t i = 0; i < count; ++i) {
+                std::string signer_id = "signer" + std::to_string(Size() + i + 1);
+                signers[i].Initialize(signer_id, parameters_);
+                entries.emplace_back(signer_id, signers[i].GeneratePartialKey().second);
+            }
+            auto keys = keygen_.GenerateSignKeys(entries);
+            size_t first = Size();
+            for (size_t i = 0; i < count; ++i) {
+                signers[i].GenerateFullKey(keys[i].first.get(), keys[i].second.get());
+                add_member(entries[i].first, signers[i].GetPublicKey());
+            }
+            // 编解码基准测量的是仿射坐标的点，与从配置或签名中读出的公钥一致
+            std::vector<EC_POINT*> points;
+            for (size_t i = first; i < Size(); ++i) {
+                points.push_back(X_[i].get());
+                points.push_back(Y_[i].get());
+            }
+            MakeAffine(group(), points.data(), points.size(), ctx());
+        }
+    }
+
+    std::vector<RingContext::Member> Members(size_t n) const {
+        std::vector<RingContext::Member> members;
+        for (size_t i = 0; i < n; ++i) members.emplace_back(ids_[i], std::make_pair(X_[i].get(), Y_[i].get()));
+        return members;
+    }
+
+private:
+    KeyGenerator keygen_;
+    Signer parameters_;
+    Signer self_;
+    ScopedBnCtx ctx_;
+    std::vector<std::string> ids_;
+    std::vector<EcPointPtr> X_;
+    std::vector<EcPointPtr> Y_;
+    std::vector<BnPtr> scalars_;
+    std::vector<std::string> hash_inputs_;
+
+    void add_member(const std::string& id, std::pair<EC_POINT*, EC_POINT*> key) {
+        ids_.push_back(id);
+        X_.emplace_back(EC_POINT_dup(key.first, group()));
+        Y_.emplace_back(EC_POINT_dup(key.second, group()));
+        BnPtr k(BN_new());
+        BN_rand_range(k.get(), EC_GROUP_get0_order(group()));
+        scalars_.push_back(std::move(k));
+        // 与 a_i = H_3(msg || event || ID_i || X_i || Y_i || A_i) 的输入长度相当
+        std::string input = "Benchmark message|ring_signature_event|" + id;
+        unsigned char buf[65];
+        for (const EC_POINT* p : {key.first, key.second, key.first}) {
+            size_t len = EC_POINT_point2oct(group(), p, POINT_CONVERSION_COMPRESSED, buf, sizeof(buf), ctx());
+            input.append(reinterpret_cast<const char*>(buf), len);
+        }
+        hash_inputs_.push_back(std::move(input));
+    }
+};
+
+// 一个环大小下各基准共用的环上下文与签名，首次使用时构建
+class RingFixture {
+public:
+    RingFixture(Population& population, size_t n) : population_(population), n_(n), signature_(nullptr, free_signature) {}
+
+    const std::string msg = "Benchmark message";
+    const std::string event = "ring_signature_event";
+
+    size_t Size() const { return n_; }
+
+    const RingContext& Ring() {
+        if (!ring_) ring_.emplace(population_.Self().CreateRingContext(population_.Members(n_)));
+        return *ring_;
+    }
+
+    const Signature& Sig() {
+        if (!signature_) {
+            signature_.reset(new Signature(population_.Self().Sign(msg, event, Ring())));
+            if (!population_.Self().Verify(*signature_, msg, event, Ring())) {
+                throw std::runtime_error("benchmark signature does not verify");
+            }
+        }
+        return *signature_;
+    }
+
+    const std::string& Encoded() {
+        if (encoded_.empty()) encoded_ = EncodeSignature(population_.group(), Sig());
+        return encoded_;
+    }
+
+private:
+    Population& population_;
+    size_t n_;
+    std::optional<RingContext> ring_;
+    SignaturePtr signature_;
+    std::string encoded_;
+};
+
+// 基准：由数据准备出对 n 个成员执行一次的函数，准备工作不计入测量
+struct Benchmark {
+    std::string name;
+    std::function<std::function<void()>(Population&, RingFixture&)> prepare;
+};
+
+// 防止结果未被使用的计算被优化掉
+volatile size_t g_sink = 0;
+
+std::vector<Benchmark> make_benchmarks() {
+    std::vector<Benchmark> benchmarks;
+
+    // HMAC 哈希到整数：n 条成员长度的输入逐条调用 hashToBn
+    for (const char* algorithm : {"SHA256", "SHA512", "SM3", "MD5"}) {
+        benchmarks.push_back({std::string("hashToBn/") + algorithm, [algorithm](Population& population, RingFixture& fixture) {
+            auto hash = std::make_shared<HashUtils>("hash_key_123456789", algorithm);
+            size_t n = fixture.Size();
+            return std::function<void()>([hash, n, &population] {
+                for (size_t i = 0; i < n; ++i) BN_free(hash->hashToBn(population.HashInput(i)));
+            });
+        }});
+    }
+    benchmarks.push_back({"hashToBnBatch/SHA256", [](Population& population, RingFixture& fixture) {
+        auto hash = std::make_shared<HashUtils>("hash_key_123456789");
+        size_t n = fixture.Size();
+        auto views = std::make_shared<std::vector<std::string_view>>();
+        auto out = std::make_shared<std::vector<BnPtr>>();
+        auto out_ptrs = std::make_shared<std::vector<BIGNUM*>>();
+        for (size_t i = 0; i < n; ++i) {
+            views->push_back(population.HashInput(i));
+            out->emplace_back(BN_new());
+            out_ptrs->push_back(out->back().get());
+        }
+        return std::function<void()>([hash, views, out, out_ptrs] {
+            hash->hashToBnBatch(views->data(), out_ptrs->data(), views->size());
+        });
+    }});
+
+    // 标量乘法，按基点类型区分：OpenSSL 的生成元与任意点、后端的定基点表与变基乘法，以及 n 元多标量乘法
+    benchmarks.push_back({"ec_mul/generator", [](Population& population, RingFixture& fixture) {
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        size_t n = fixture.Size();
+        return std::function<void()>([r, n, &population] {
+            for (size_t i = 0; i < n; ++i) {
+                EC_POINT_mul(population.group(), r->get(), population.Scalar(i), nullptr, nullptr, population.ctx());
+            }
+        });
+    }});
+    benchmarks.push_back({"ec_mul/variable", [](Population& population, RingFixture& fixture) {
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        size_t n = fixture.Size();
+        return std::function<void()>([r, n, &population] {
+            for (size_t i = 0; i < n; ++i) {
+                EC_POINT_mul(population.group(), r->get(), nullptr, population.X(i), population.Scalar(i), population.ctx());
+            }
+        });
+    }});
+    benchmarks.push_back({"ec_mul/fixed_table", [](Population& population, RingFixture& fixture) {
+        const EcBackend& backend = population.Self().GetEcBackend();
+        std::shared_ptr<EcBackend::FixedBase> table = backend.NewFixedBase(
+            population.group(), EC_GROUP_get0_generator(population.group()), FixedBaseTable::kDefaultTeeth);
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        size_t n = fixture.Size();
+        return std::function<void()>([table, r, n, &population] {
+            for (size_t i = 0; i < n; ++i) table->Mul(r->get(), population.Scalar(i), population.ctx());
+        });
+    }});
+    benchmarks.push_back({"ec_mul/backend_variable", [](Population& population, RingFixture& fixture) {
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        size_t n = fixture.Size();
+        return std::function<void()>([r, n, &population] {
+            const EcBackend& backend = population.Self().GetEcBackend();
+            for (size_t i = 0; i < n; ++i) {
+                backend.Mul(population.group(), r->get(), population.X(i), population.Scalar(i), population.ctx());
+            }
+        });
+    }});
+    benchmarks.push_back({"ec_msm", [](Population& population, RingFixture& fixture) {
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        auto points = std::make_shared<std::vector<const EC_POINT*>>();
+        auto scalars = std::make_shared<std::vector<const BIGNUM*>>();
+        for (size_t i = 0; i < fixture.Size(); ++i) {
+            points->push_back(population.X(i));
+            scalars->push_back(population.Scalar(i));
+        }
+        return std::function<void()>([r, points, scalars, &population] {
+            population.Self().GetEcBackend().MultiMul(population.group(), r->get(), *points, *scalars, population.ctx());
+        });
+    }});
+
+    // 点编解码：十六进制（配置与 JSON 签名）与压缩二进制（v2 transcript 与二进制签名）
+    benchmarks.push_back({"codec/point2hex", [](Population& population, RingFixture& fixture) {
+        size_t n = fixture.Size();
+        return std::function<void()>([n, &population] {
+            for (size_t i = 0; i < n; ++i) {
+                OpensslString hex(EC_POINT_point2hex(population.group(), population.X(i), POINT_CONVERSION_UNCOMPRESSED,
+                                                     population.ctx()));
+                g_sink = g_sink + hex.get()[2];
+            }
+        });
+    }});
+    benchmarks.push_back({"codec/hex2point", [](Population& population, RingFixture& fixture) {
+        auto hex = std::make_shared<std::vector<std::string>>();
+        for (size_t i = 0; i < fixture.Size(); ++i) {
+            OpensslString s(EC_POINT_point2hex(population.group(), population.X(i), POINT_CONVERSION_UNCOMPRESSED,
+                                               population.ctx()));
+            hex->push_back(s.get());
+        }
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        return std::function<void()>([hex, r, &population] {
+            for (const auto& s : *hex) {
+                if (!EC_POINT_hex2point(population.group(), s.c_str(), r->get(), population.ctx())) {
+                    throw std::runtime_error("EC_POINT_hex2point failed");
+                }
+            }
+        });
+    }});
+    benchmarks.push_back({"codec/point2oct", [](Population& population, RingFixture& fixture) {
+        size_t n = fixture.Size();
+        return std::function<void()>([n, &population] {
+            unsigned char buf[65];
+            for (size_t i = 0; i < n; ++i) {
+                g_sink = g_sink + EC_POINT_point2oct(population.group(), population.X(i), POINT_CONVERSION_COMPRESSED,
+                                                     buf, sizeof(buf), population.ctx());
+            }
+        });
+    }});
+    benchmarks.push_back({"codec/oct2point", [](Population& population, RingFixture& fixture) {
+        auto oct = std::make_shared<std::vector<std::string>>();
+        unsigned char buf[65];
+        for (size_t i = 0; i < fixture.Size(); ++i) {
+            size_t len = EC_POINT_point2oct(population.group(), population.X(i), POINT_CONVERSION_COMPRESSED, buf,
+                                            sizeof(buf), population.ctx());
+            oct->emplace_back(reinterpret_cast<const char*>(buf), len);
+        }
+        auto r = std::make_shared<EcPointPtr>(EC_POINT_new(population.group()));
+        return std::function<void()>([oct, r, &population] {
+            for (const auto& s : *oct) {
+                if (!EC_POINT_oct2point(population.group(), r->get(), reinterpret_cast<const unsigned char*>(s.data()),
+                                        s.size(), population.ctx())) {
+                    throw std::runtime_error("EC_POINT_oct2point failed");
+                }
+            }
+        });
+    }});
+    benchmarks.push_back({"codec/signature_encode", [](Population& population, RingFixture& fixture) {
+        const Signature& sig = fixture.Sig();
+        return std::function<void()>([&sig, &population] {
+            g_sink = g_sink + EncodeSignature(population.group(), sig).size();
+        });
+    }});
+    benchmarks.push_back({"codec/signature_decode", [](Population& population, RingFixture& fixture) {
+        const std::string& data = fixture.Encoded();
+        return std::function<void()>([&data, &population] {
+            SignaturePtr sig(new Signature(SignatureView(data).Decode(population.group())), free_signature);
+            g_sink = g_sink + sig->A.size();
+        });
+    }});
+
+    // 协议操作：为 n 个签名者签发部分密钥、构建环上下文、签名与验证
+    benchmarks.push_back({"keygen/GenerateSignKey", [](Population& population, RingFixture& fixture) {
+        size_t n = fixture.Size();
+        return std::function<void()>([n, &population] {
+            for (size_t i = 0; i < n; ++i) {
+                auto [partial_system_public_key, partial_private_key] =
+                    population.Keygen().GenerateSignKey(population.Id(i), population.X(i));
+                EC_POINT_free(partial_system_public_key);
+                BN_free(partial_private_key);
+            }
+        });
+    }});
+    benchmarks.push_back({"ring/CreateRingContext", [](Population& population, RingFixture& fixture) {
+        auto members = std::make_shared<std::vector<RingContext::Member>>(population.Members(fixture.Size()));
+        return std::function<void()>([members, &population] {
+            RingContext ring = population.Self().CreateRingContext(*members);
+            g_sink = g_sink + ring.Size();
+        });
+    }});
+    benchmarks.push_back({"sign", [](Population& population, RingFixture& fixture) {
+        const RingContext& ring = fixture.Ring();
+        return std::function<void()>([&ring, &fixture, &population] {
+            SignaturePtr sig(new Signature(population.Self().Sign(fixture.msg, fixture.event, ring)), free_signature);
+            g_sink = g_sink + sig->A.size();
+        });
+    }});
+    benchmarks.push_back({"verify", [](Population& population, RingFixture& fixture) {
+        const RingContext& ring = fixture.Ring();
+        const Signature& sig = fixture.Sig();
+        return std::function<void()>([&ring, &sig, &fixture, &population] {
+            if (!population.Self().Verify(sig, fixture.msg, fixture.event, ring)) {
+                throw std::runtime_error("benchmark signature does not verify");
+            }
+        });
+    }});
+    return benchmarks;
+}
+
+// ---------------------------------------------------------------------------
+// 运行与比较
+// ---------------------------------------------------------------------------
+
+json run_benchmarks(const Options& options) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "bench_ringsign_config.json").string();
+    std::string key_path = (dir / "bench_ringsign_key.json").string();
+    Population population(config_path, key_path, options.threads);
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+
+    std::vector<Benchmark> benchmarks;
+    for (auto& benchmark : make_benchmarks()) {
+        if (benchmark.name.find(options.filter) != std::string::npos) benchmarks.push_back(std::move(benchmark));
+    }
+
+    json results = json::array();
+    for (size_t n : options.sizes) {
+        std::cerr << "preparing " << n << " members..." << std::endl;
+        population.Grow(n);
+        RingFixture fixture(population, n);
+        for (const auto& benchmark : benchmarks) {
+            std::function<void()> run = benchmark.prepare(population, fixture);
+            json result = measure(run, options);
+            result["name"] = benchmark.name;
+            result["ring_size"] = n;
+            result["per_member_ns"] = result["median_ns"].get<double>() / n;
+            double median = result["median_ns"];
+            std::cerr << "  " << benchmark.name << " n=" << n << "  median: " << median / 1e3 << " us"
+                      << " (+/- " << result["mad_ns"].get<double>() / median * 100 << "% MAD, "
+                      << result["samples_ns"].size() << " samples x " << result["iterations"] << ")"
+                      << "  per member: " << median / n << " ns" << std::endl;
+            results.push_back(std::move(result));
+        }
+    }
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    const Signer& self = population.Self();
+    json context = {
+        {"timestamp", timestamp},
+        {"curve", OBJ_nid2sn(EC_GROUP_get_curve_name(self.GetGroup()))},
+        {"hash_type", population.Keygen().GetHashType()},
+        {"transcript_version", self.GetTranscriptVersion()},
+        {"ec_backend", self.GetEcBackend().Name()},
+        {"sha256_kernel", Sha256MultiBuffer::Name(Sha256MultiBuffer::Active())},
+        {"threads", options.threads},
+#ifdef NDEBUG
+        {"assertions", false},
+#else
+        {"assertions", true},
+#endif
+        {"min_time_s", options.min_time},
+        {"min_samples", options.min_samples},
+    };
+    return {{"format_version", kResultFormatVersion}, {"context", context}, {"benchmarks", results}};
+}
+
+json load_json(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) throw std::runtime_error("cannot open " + path);
+    json j = json::parse(file);
+    if (j.value("format_version", 0) != kResultFormatVersion) {
+        throw std::runtime_error(path + ": unsupported result format version");
+    }
+    return j;
+}
+
+// 按 (名称, 环大小) 匹配两次结果：中位数变化超过阈值且单侧检验显著时判定为回退或改进。
+// 返回比较结果，regressions 为回退的个数
+json compare(const json& current, const json& baseline, const Options& options, size_t& regressions) {
+    for (const char* key : {"curve", "hash_type", "ec_backend", "sha256_kernel", "threads", "assertions"}) {
+        if (current["context"].value(key, json()) != baseline["context"].value(key, json())) {
+            std::cerr << "warning: " << key << " differs from the baseline: " << current["context"].value(key, json())
+                      << " vs " << baseline["context"].value(key, json()) << std::endl;
+        }
+    }
+
+    std::map<std::pair<std::string, size_t>, const json*> base;
+    for (const auto& entry : baseline["benchmarks"]) {
+        base[{entry["name"].get<std::string>(), entry["ring_size"].get<size_t>()}] = &entry;
+    }
+
+    json comparison = json::array();
+    regressions = 0;
+    for (const auto& entry : current["benchmarks"]) {
+        std::string name = entry["name"];
+        size_t n = entry["ring_size"];
+        json row = {{"name", name}, {"ring_size", n}, {"median_ns", entry["median_ns"]}};
+        auto it = base.find({name, n});
+        if (it == base.end()) {
+            row["status"] = "new";
+            comparison.push_back(row);
+            continue;
+        }
+        const json& old = *it->second;
+        auto samples = entry["samples_ns"].get<std::vector<double>>();
+        auto old_samples = old["samples_ns"].get<std::vector<double>>();
+        double ratio = entry["median_ns"].get<double>() / old["median_ns"].get<double>();
+        double p_slower = mann_whitney_greater(samples, old_samples);
+        double p_faster = mann_whitney_greater(old_samples, samples);
+        std::string status = "unchanged";
+        if (ratio > 1 + options.threshold && p_slower <= options.alpha) {
+            status = "regression";
+            ++regressions;
+        } else if (ratio < 1 - options.threshold && p_faster <= options.alpha) {
+            status = "improvement";
+        }
+        row["baseline_median_ns"] = old["median_ns"];
+        row["ratio"] = ratio;
+        row["p_value"] = ratio >= 1 ? p_slower : p_faster;
+        row["status"] = status;
+        std::cerr << (status == "regression" ? "! " : "  ") << name << " n=" << n << "  " << ratio << "x"
+                  << "  p=" << row["p_value"].get<double>() << "  " << status << std::endl;
+        comparison.push_back(row);
+    }
+    return comparison;
+}
+
+std::vector<size_t> parse_sizes(const std::string& list) {
+    std::vector<size_t> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        size_t n = std::stoul(item);
+        if (n < 2) throw std::invalid_argument("ring size must be at least 2");
+        sizes.push_back(n);
+    }
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+                options.sizes = parse_sizes(argv[++i]);
+            } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+                options.filter = argv[++i];
+            } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+                options.min_time = std::stod(argv[++i]);
+            } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+                options.min_samples = std::max<size_t>(3, std::stoul(argv[++i]));
+            } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+                options.threads = std::max<size_t>(1, std::stoul(argv[++i]));
+            } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+                options.output_file = argv[++i];
+            } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+                options.baseline_file = argv[++i];
+            } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+                options.input_file = argv[++i];
+            } else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) {
+                options.threshold = std::stod(argv[++i]);
+            } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+                options.alpha = std::stod(argv[++i]);
+            } else if (strcmp(argv[i], "-l") == 0) {
+                options.list = true;
+            } else {
+                print_usage();
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << std::endl;
+        print_usage();
+        return 1;
+    }
+    if (!options.input_file.empty() && options.baseline_file.empty()) {
+        std::cerr << "错误: -i 须与 -b 一起使用" << std::endl;
+        return 1;
+    }
+
+    if (options.list) {
+        for (const auto& benchmark : make_benchmarks()) std::cout << benchmark.name << "\n";
+        return 0;
+    }
+
+    try {
+        json result = options.input_file.empty() ? run_benchmarks(options) : load_json(options.input_file);
+        size_t regressions = 0;
+        if (!options.baseline_file.empty()) {
+            result["comparison"] = compare(result, load_json(options.baseline_file), options, regressions);
+            std::cerr << regressions << " regression(s)" << std::endl;
+        }
+        if (options.output_file.empty()) {
+            std::cout << result.dump(2) << std::endl;
+        } else {
+            std::ofstream file(options.output_file);
+            if (!file.is_open()) throw std::runtime_error("cannot write " + options.output_file);
+            file << result.dump(2) << std::endl;
+        }
+        return regressions > 0 ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "错误: " << e.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,255 @@
+#include <iostream>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/hash_utils.h"
+#include "libringsign/crypto_pool.h"
+#include "libringsign/transcript.h"
+
+using namespace ring_signature_lib;
+using namespace std::chrono;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+// 原有的逐成员验证实现：每个成员 3 次变基标量乘法，用作性能与结果对照
+bool legacy_verify(const EC_GROUP* group, const EC_POINT* system_public_key,
+                   const std::vector<HashUtils>& hash,
+                   const std::vector<EC_POINT*>& A, const BIGNUM* phi, const BIGNUM* psi, const EC_POINT* T,
+                   const std::string& msg, const std::string& event, const RingList& L) {
+    BN_CTX* ctx = BN_CTX_new();
+    const EC_POINT* P = EC_GROUP_get0_generator(group);
+    const BIGNUM* group_order = EC_GROUP_get0_order(group);
+    EC_POINT* lhs = EC_POINT_new(group);
+    EC_POINT* rhs = EC_POINT_new(group);
+    EC_POINT* temp_point = EC_POINT_new(group);
+    BIGNUM* temp_bn = BN_new();
+
+    BIGNUM* event_hash = hash[0].hashToBn(event);
+    EC_POINT* E = EC_POINT_new(group);
+    EC_POINT_mul(group, E, nullptr, P, event_hash, ctx);
+
+    EC_POINT_set_to_infinity(group, lhs);
+    for (const auto& Ai : A) {
+        EC_POINT_add(group, lhs, lhs, Ai, ctx);
+    }
+
+    auto hex = [group](const EC_POINT* p) {
+        char* s = EC_POINT_point2hex(group, p, POINT_CONVERSION_UNCOMPRESSED, nullptr);
+        std::string out(s);
+        OPENSSL_free(s);
+        return out;
+    };
+
+    EC_POINT_set_to_infinity(group, rhs);
+    for (size_t i = 0; i < L.size(); ++i) {
+        BIGNUM* a_i = hash[3].hashToBn(msg + event + L[i].first + hex(L[i].second.first) +
+                                       hex(L[i].second.second) + hex(A[i]));
+        BIGNUM* h_i = hash[1].hashToBn(L[i].first + hex(L[i].second.first) + hex(system_public_key));
+
+        EC_POINT_add(group, temp_point, L[i].second.first, L[i].second.second, ctx);
+        EC_POINT_add(group, temp_point, temp_point, T, ctx);
+        EC_POINT_mul(group, temp_point, nullptr, temp_point, a_i, ctx);
+        EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+
+        EC_POINT_mul(group, temp_point, nullptr, system_public_key, h_i, ctx);
+        EC_POINT_mul(group, temp_point, nullptr, temp_point, a_i, ctx);
+        EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+
+        BN_free(a_i);
+        BN_free(h_i);
+    }
+
+    EC_POINT_mul(group, temp_point, nullptr, E, psi, ctx);
+    EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+    BN_mod_add(temp_bn, phi, psi, group_order, ctx);
+    EC_POINT_mul(group, temp_point, nullptr, P, temp_bn, ctx);
+    EC_POINT_add(group, rhs, rhs, temp_point, ctx);
+
+    bool is_valid = (EC_POINT_cmp(group, lhs, rhs, ctx) == 0);
+
+    EC_POINT_free(lhs);
+    EC_POINT_free(rhs);
+    EC_POINT_free(E);
+    EC_POINT_free(temp_point);
+    BN_free(temp_bn);
+    BN_free(event_hash);
+    BN_CTX_free(ctx);
+    return is_valid;
+}
+
+template <typename F>
+double time_ms(F&& f, int iterations) {
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) f();
+    auto end = high_resolution_clock::now();
+    return duration_cast<microseconds>(end - start).count() / 1000.0 / iterations;
+}
+
+// 验证结果与原实现不一致时返回 false
+bool bench(int participant_count, const std::string& config_path, KeyGenerator& keygen) {
+    // 签名者共享一份系统参数，部分密钥一次批量签发
+    Signer parameters;
+    parameters.Initialize("", config_path);
+    std::vector<Signer> signers(participant_count);
+    std::vector<std::pair<std::string, const EC_POINT*>> entries;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, parameters);
+        entries.emplace_back(signer_id, signers[i].GeneratePartialKey().second);
+    }
+    auto keys = keygen.GenerateSignKeys(entries);
+    for (int i = 0; i < participant_count; ++i) {
+        signers[i].GenerateFullKey(keys[i].first.get(), keys[i].second.get());
+    }
+
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        ring.emplace_back("signer" + std::to_string(i + 1), signers[i].GetPublicKey());
+    }
+    RingList others(ring.begin() + 1, ring.end());
+    // Verify 要求环成员按 ID 字典序排列，与签名时一致
+    std::sort(ring.begin(), ring.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    std::string msg = "Benchmark message";
+    std::string event = "ring_signature_event";
+    Signature sig = signers[0].Sign(msg, event, others);
+    const std::vector<EC_POINT*>& A = sig.A;
+    BIGNUM* phi = sig.phi;
+    BIGNUM* psi = sig.psi;
+    EC_POINT* T = sig.T;
+
+    std::vector<HashUtils> hash;
+    for (const auto& key : keygen.GetHashKeys()) hash.emplace_back(key, keygen.GetHashType());
+    const EC_GROUP* group = keygen.GetGroup();
+    const EC_POINT* ppub = keygen.GetPublicKey();
+
+    // 复用环上下文的验证与批量验证：同一环与事件下的 16 个签名（此处重复使用同一签名）
+    RingContext ring_ctx = signers[1].CreateRingContext(ring);
+    const size_t batch_size = 16;
+    std::vector<SignatureInput> batch(batch_size, SignatureInput{sig, msg, event, ring_ctx});
+
+    // 接受/拒绝结果必须与原实现一致
+    bool new_ok = signers[1].Verify(A, phi, psi, T, msg, event, ring);
+    bool old_ok = legacy_verify(group, ppub, hash, A, phi, psi, T, msg, event, ring);
+    bool new_bad = signers[1].Verify(A, phi, psi, T, msg + "!", event, ring);
+    bool old_bad = legacy_verify(group, ppub, hash, A, phi, psi, T, msg + "!", event, ring);
+    bool ctx_ok = signers[1].Verify(A, phi, psi, T, msg, event, ring_ctx);
+    bool ctx_bad = signers[1].Verify(A, phi, psi, T, msg + "!", event, ring_ctx);
+    std::vector<bool> batch_results = signers[1].VerifyBatch(batch);
+    bool batch_ok = std::all_of(batch_results.begin(), batch_results.end(), [](bool ok) { return ok; });
+    bool consistent = new_ok && old_ok && !new_bad && !old_bad && ctx_ok && !ctx_bad && batch_ok;
+
+    if (consistent) {
+        int iterations = participant_count >= 500 ? 1 : (participant_count >= 100 ? 3 : 20);
+        double legacy_ms = time_ms([&] { legacy_verify(group, ppub, hash, A, phi, psi, T, msg, event, ring); }, iterations);
+        double msm_ms = time_ms([&] { signers[1].Verify(A, phi, psi, T, msg, event, ring); }, iterations);
+        double ctx_ms = time_ms([&] { signers[1].Verify(A, phi, psi, T, msg, event, ring_ctx); }, iterations);
+        double batch_ms = time_ms([&] { signers[1].VerifyBatch(batch); }, iterations) / batch_size;
+
+        std::cout << "n=" << participant_count
+                  << "  legacy: " << legacy_ms << " ms"
+                  << "  msm: " << msm_ms << " ms"
+                  << "  msm+ring context: " << ctx_ms << " ms"
+                  << "  batch(" << batch_size << "): " << batch_ms << " ms/sig"
+                  << "  speedup: " << (msm_ms > 0 ? legacy_ms / msm_ms : 0.0) << "x" << std::endl;
+    } else {
+        std::cerr << "n=" << participant_count << ": verification results differ from the legacy implementation"
+                  << " (msm " << new_ok << "/" << new_bad << ", legacy " << old_ok << "/" << old_bad
+                  << ", ring context " << ctx_ok << "/" << ctx_bad << ", batch " << batch_ok << ")" << std::endl;
+    }
+
+    for (auto* p : A) EC_POINT_free(p);
+    BN_free(phi);
+    BN_free(psi);
+    EC_POINT_free(T);
+    return consistent;
+}
+
+// 仿射化阶段：n 个射影坐标的点逐个编码（每点一次域求逆）与先批量仿射化再编码对比；
+// 两种方式的编码或点值不一致时返回 false
+bool bench_normalize(const EC_GROUP* group, int count) {
+    ScopedBnCtx scoped_ctx;
+    BN_CTX* ctx = scoped_ctx.get();
+    std::vector<EcPointPtr> jacobian;
+    std::vector<EcPointPtr> work;
+    std::vector<EC_POINT*> work_ptrs;
+    BnPtr k(BN_new());
+    EcPointPtr step(EC_POINT_new(group));
+    BN_rand_range(k.get(), EC_GROUP_get0_order(group));
+    EC_POINT_mul(group, step.get(), k.get(), nullptr, nullptr, ctx);
+    for (int i = 0; i < count; ++i) {
+        // 点加法的结果 Z ≠ 1，与签名中定基乘法的输出相同
+        EcPointPtr point(EC_POINT_new(group));
+        BN_rand_range(k.get(), EC_GROUP_get0_order(group));
+        EC_POINT_mul(group, point.get(), k.get(), nullptr, nullptr, ctx);
+        EC_POINT_add(group, point.get(), point.get(), step.get(), ctx);
+        jacobian.push_back(std::move(point));
+        work.emplace_back(EC_POINT_new(group));
+        work_ptrs.push_back(work.back().get());
+    }
+
+    std::vector<PointEncoding> single(count);
+    std::vector<PointEncoding> batched(count);
+    auto reset = [&] {
+        for (int i = 0; i < count; ++i) EC_POINT_copy(work_ptrs[i], jacobian[i].get());
+    };
+    int iterations = count >= 1000 ? 3 : 20;
+    double single_ms = time_ms([&] {
+        reset();
+        for (int i = 0; i < count; ++i) single[i] = PointEncoding::Encode(group, work_ptrs[i], ctx);
+    }, iterations);
+    double batch_ms = time_ms([&] {
+        reset();
+        MakeAffine(group, work_ptrs.data(), work_ptrs.size(), ctx);
+        for (int i = 0; i < count; ++i) batched[i] = PointEncoding::Encode(group, work_ptrs[i], ctx);
+    }, iterations);
+    for (int i = 0; i < count; ++i) {
+        if (single[i].compressed != batched[i].compressed || single[i].hex != batched[i].hex ||
+            EC_POINT_cmp(group, work_ptrs[i], jacobian[i].get(), ctx) != 0) {
+            std::cerr << "n=" << count << ": normalized point " << i << " differs" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "n=" << count
+              << "  encode: " << single_ms << " ms"
+              << "  normalize+encode: " << batch_ms << " ms"
+              << "  speedup: " << (batch_ms > 0 ? single_ms / batch_ms : 0.0) << "x" << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> test_counts = {2, 10, 100, 1000};
+    if (argc > 1) {
+        test_counts.clear();
+        for (int i = 1; i < argc; ++i) test_counts.push_back(std::stoi(argv[i]));
+    }
+
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "bench_verify_msm_config.json").string();
+    std::string key_path = (dir / "bench_verify_msm_key.json").string();
+
+    // 原实现按 v1 transcript 编码哈希输入，系统参数使用 v1 以便对照
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SetTranscriptVersion(TRANSCRIPT_VERSION_1);
+    keygen.SaveConfig(config_path, key_path);
+
+    bool consistent = true;
+    for (int count : test_counts) {
+        consistent = bench(count, config_path, keygen) && consistent;
+    }
+    for (int count : test_counts) {
+        consistent = bench_normalize(keygen.GetGroup(), count) && consistent;
+    }
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/hash_utils.h"
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+
+using namespace ring_signature_lib;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+// 统计 OpenSSL 与 operator new 的堆分配次数，以及尚未释放的 OpenSSL 分配数
+static std::atomic<size_t> g_allocs{0};
+static std::atomic<long> g_live{0};
+
+static void* count_malloc(size_t num, const char*, int) {
+    ++g_allocs;
+    ++g_live;
+    return std::malloc(num);
+}
+static void* count_realloc(void* addr, size_t num, const char*, int) {
+    ++g_allocs;
+    if (!addr) ++g_live;
+    return std::realloc(addr, num);
+}
+static void count_free(void* addr, const char*, int) {
+    if (addr) --g_live;
+    std::free(addr);
+}
+
+void* operator new(size_t size) {
+    ++g_allocs;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+void free_signature(Signature& sig) {
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+}
+
+// 借出的对象为零值/无穷远点，作用域结束后按后进先出复用，嵌套作用域互不覆盖
+void arena_test() {
+    EcGroupPtr group(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    BIGNUM* first = nullptr;
+    EC_POINT* first_point = nullptr;
+    {
+        ScopedArena arena(group.get());
+        first = arena.Bn();
+        assert(BN_is_zero(first));
+        BN_set_word(first, 42);
+        first_point = arena.Point();
+        assert(EC_POINT_is_at_infinity(group.get(), first_point));
+        EC_POINT_copy(first_point, EC_GROUP_get0_generator(group.get()));
+
+        {
+            ScopedArena inner(group.get());
+            BIGNUM* nested = inner.Bn();
+            assert(nested != first && BN_is_zero(nested));
+            std::vector<BIGNUM*>& list = inner.List<BIGNUM*>();
+            assert(list.empty());
+            list.push_back(nested);
+        }
+        assert(BN_is_word(first, 42));
+    }
+    {
+        ScopedArena arena(group.get());
+        BIGNUM* again = arena.Bn();
+        assert(again == first && BN_is_zero(again));
+        EC_POINT* point = arena.Point();
+        assert(point == first_point && EC_POINT_is_at_infinity(group.get(), point));
+        assert(arena.List<BIGNUM*>().empty());
+    }
+
+    // RandRange 的结果落在 [0, range) 内
+    ScopedArena arena(group.get());
+    BIGNUM* range = arena.Bn();
+    BIGNUM* r = arena.Bn();
+    BN_set_word(range, 1000);
+    for (int i = 0; i < 200; ++i) {
+        RandRange(r, range);
+        assert(BN_cmp(r, range) < 0 && !BN_is_negative(r));
+    }
+    RandRange(r, EC_GROUP_get0_order(group.get()));
+    assert(BN_cmp(r, EC_GROUP_get0_order(group.get())) < 0);
+    std::cout << "Arena reuse and RandRange checks passed." << std::endl;
+}
+
+// 低层摘要实现的 HMAC 与 OpenSSL 一次性 HMAC 结果一致，含长于分组的密钥与分段写入
+void hmac_test() {
+    const char* types[] = {"SHA256", "SHA512", "MD5", "SM3"};
+    std::string long_key(200, 'k');
+    std::string data(1500, 'x');
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>(i * 7);
+    for (const char* type : types) {
+        for (const std::string& key : {std::string("short key"), long_key}) {
+            HashUtils hash(key, type);
+            unsigned char mac[EVP_MAX_MD_SIZE];
+            unsigned int mac_len = 0;
+            HMAC(EVP_get_digestbyname(type), key.data(), static_cast<int>(key.size()),
+                 reinterpret_cast<const unsigned char*>(data.data()), data.size(), mac, &mac_len);
+            BnPtr expected(BN_bin2bn(mac, static_cast<int>(mac_len), nullptr));
+
+            BnPtr one_shot(hash.hashToBn(data));
+            assert(BN_cmp(one_shot.get(), expected.get()) == 0);
+
+            HashState state(hash);
+            state.Update(data.substr(0, 3));
+            HashState copy(state);
+            copy.Update(data.substr(3, 700));
+            copy.Update(data.substr(703));
+            BnPtr incremental(BN_new());
+            copy.FinalToBn(incremental.get());
+            assert(BN_cmp(incremental.get(), expected.get()) == 0);
+        }
+    }
+    std::cout << "HMAC states match one-shot HMAC." << std::endl;
+}
+
+// 预构建环上单线程签名与验证：预热后验证不分配堆内存，签名只分配返回给调用方的对象，且无泄漏
+void hot_path_test(const std::string& config_path, KeyGenerator& keygen) {
+    const int participant_count = 8;
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+
+    Signer& signer = signers[3];
+    RingContext context = signer.CreateRingContext(ring);
+    std::string msg = "allocation free message";
+    std::string event = "ring_signature_event";
+
+    // 预热：填充线程局部的对象池与事件表缓存
+    for (int round = 0; round < 2; ++round) {
+        Signature sig = signer.Sign(msg, event, context);
+        bool verified = signer.Verify(sig, msg, event, context);
+        assert(verified);
+        free_signature(sig);
+    }
+
+    // 池中 BIGNUM 的容量随数值大小增长，先用同一签名验证一次，使计数只反映稳定状态
+    Signature sig = signer.Sign(msg, event, context);
+    bool verified = signer.Verify(sig, msg, event, context);
+    assert(verified);
+    size_t before = g_allocs.load();
+    for (int round = 0; round < 5; ++round) {
+        verified = signer.Verify(sig, msg, event, context);
+        assert(verified);
+    }
+    size_t verify_allocs = g_allocs.load() - before;
+    std::cout << "Heap allocations in 5 verifications: " << verify_allocs << std::endl;
+    assert(verify_allocs == 0);
+
+    // 返回对象本身的分配：n + 1 个点、2 个 BIGNUM 及 A 的数组
+    before = g_allocs.load();
+    {
+        std::vector<EC_POINT*> copies;
+        copies.reserve(sig.A.size());
+        for (auto* p : sig.A) copies.push_back(EC_POINT_dup(p, signer.GetGroup()));
+        EC_POINT* T = EC_POINT_dup(sig.T, signer.GetGroup());
+        BIGNUM* phi = BN_dup(sig.phi);
+        BIGNUM* psi = BN_dup(sig.psi);
+        for (auto* p : copies) EC_POINT_free(p);
+        EC_POINT_free(T);
+        BN_free(phi);
+        BN_free(psi);
+    }
+    size_t output_allocs = g_allocs.load() - before;
+
+    // 秘密标量的乘法（n - 1 个随机数 r_i、T、(μ + ν)P 与 N）经由 EC_POINT_mul 的常数时间阶梯，
+    // 阶梯内部为临时点分配内存，取多次调用中的最大分配数
+    size_t secret_mul_allocs = 0;
+    {
+        ScopedArena arena(signer.GetGroup());
+        EC_POINT* r = arena.Point();
+        BIGNUM* k = arena.Bn();
+        for (int round = 0; round < 8; ++round) {
+            RandRange(k, EC_GROUP_get0_order(signer.GetGroup()));
+            before = g_allocs.load();
+            signer.GetPrecomputeCache()->Generator().MulSecret(r, k, nullptr);
+            secret_mul_allocs = std::max(secret_mul_allocs, g_allocs.load() - before);
+        }
+    }
+    size_t secret_muls = participant_count + 2;
+
+    long live = g_live.load();
+    before = g_allocs.load();
+    for (int round = 0; round < 5; ++round) {
+        Signature again = signer.Sign(msg, event, context);
+        free_signature(again);
+    }
+    size_t sign_allocs = (g_allocs.load() - before) / 5;
+    std::cout << "Heap allocations per signature: " << sign_allocs
+              << " (returned objects: " << output_allocs << ", constant-time multiplications: "
+              << secret_muls << " x " << secret_mul_allocs << ")" << std::endl;
+    assert(sign_allocs <= output_allocs + secret_muls * secret_mul_allocs);
+    assert(g_live.load() == live);
+
+    // 失败的验证同样不分配、不泄漏
+    std::string wrong = msg + "!";
+    before = g_allocs.load();
+    verified = signer.Verify(sig, wrong, event, context);
+    assert(!verified);
+    assert(g_allocs.load() == before);
+    free_signature(sig);
+    std::cout << "Hot path allocation checks passed." << std::endl;
+}
+
+int main() {
+    if (!CRYPTO_set_mem_functions(count_malloc, count_realloc, count_free)) {
+        std::cerr << "Failed to install OpenSSL allocation hooks" << std::endl;
+        return 1;
+    }
+
+    arena_test();
+    hmac_test();
+
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    // 文件名带进程号，并发运行的测试互不覆盖
+    std::string suffix = std::to_string(getpid()) + ".json";
+    std::string config_path = (dir / ("test_arena_config_" + suffix)).string();
+    std::string key_path = (dir / ("test_arena_key_" + suffix)).string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+
+    hot_path_test(config_path, keygen);
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,300 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include "libringsign/crypto_pool.h"
+#include "libringsign/ec_backend.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+
+using namespace ring_signature_lib;
+using namespace std::chrono;
+
+// 原生后端与 OpenSSL 后端对同一输入必须给出相同的点
+struct Fixture {
+    EcGroupPtr group{EC_GROUP_new_by_curve_name(NID_secp256k1)};
+    ScopedBnCtx ctx;
+    const EcBackend& native = *EcBackend::Native(NID_secp256k1);
+    const EcBackend& openssl = EcBackend::OpenSsl();
+
+    EcPointPtr random_point(bool jacobian) {
+        EcPointPtr point(EC_POINT_new(group.get()));
+        BnPtr k(BN_new());
+        BN_rand_range(k.get(), EC_GROUP_get0_order(group.get()));
+        EC_POINT_mul(group.get(), point.get(), k.get(), nullptr, nullptr, ctx.get());
+        if (jacobian) {
+            // 点加法的结果 Z ≠ 1
+            EC_POINT_add(group.get(), point.get(), point.get(), EC_GROUP_get0_generator(group.get()), ctx.get());
+        } else {
+            EC_POINT* points[] = {point.get()};
+            MakeAffine(group.get(), points, 1, ctx.get());
+        }
+        return point;
+    }
+
+    // 边界标量与随机标量：0、1、2、n - 1、n、2n + 7、λ 附近、负数、全 1 的低位
+    std::vector<BnPtr> scalars(size_t random_count) {
+        const BIGNUM* order = EC_GROUP_get0_order(group.get());
+        std::vector<BnPtr> out;
+        auto push = [&](BIGNUM* bn) { out.emplace_back(bn); };
+        BIGNUM* bn = BN_new();
+        BN_zero(bn);
+        push(bn);
+        bn = BN_new();
+        BN_one(bn);
+        push(bn);
+        bn = BN_new();
+        BN_set_word(bn, 2);
+        push(bn);
+        bn = BN_dup(order);
+        BN_sub_word(bn, 1);
+        push(bn);
+        push(BN_dup(order));
+        bn = BN_new();
+        BN_lshift1(bn, order);
+        BN_add_word(bn, 7);
+        push(bn);
+        bn = nullptr;
+        BN_hex2bn(&bn, "5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72");
+        push(bn);
+        bn = nullptr;
+        BN_hex2bn(&bn, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF");
+        push(bn);
+        bn = BN_new();
+        BN_set_word(bn, 12345);
+        BN_set_negative(bn, 1);
+        push(bn);
+        for (size_t i = 0; i < random_count; ++i) {
+            bn = BN_new();
+            BN_rand_range(bn, order);
+            push(bn);
+        }
+        return out;
+    }
+
+    bool same(const EC_POINT* a, const EC_POINT* b) {
+        return EC_POINT_cmp(group.get(), a, b, ctx.get()) == 0;
+    }
+};
+
+void mul_test(Fixture& f) {
+    EcPointPtr expected(EC_POINT_new(f.group.get()));
+    EcPointPtr actual(EC_POINT_new(f.group.get()));
+    EcPointPtr infinity(EC_POINT_new(f.group.get()));
+    EC_POINT_set_to_infinity(f.group.get(), infinity.get());
+    auto scalars = f.scalars(50);
+    for (int round = 0; round < 4; ++round) {
+        EcPointPtr base = round == 3 ? EcPointPtr(EC_POINT_dup(EC_GROUP_get0_generator(f.group.get()), f.group.get()))
+                                     : f.random_point(round == 1);
+        for (const auto& k : scalars) {
+            f.openssl.Mul(f.group.get(), expected.get(), base.get(), k.get(), f.ctx.get());
+            f.native.Mul(f.group.get(), actual.get(), base.get(), k.get(), f.ctx.get());
+            assert(f.same(expected.get(), actual.get()));
+        }
+        // 输出与输入为同一对象
+        EcPointPtr in_place(EC_POINT_dup(base.get(), f.group.get()));
+        f.native.Mul(f.group.get(), in_place.get(), in_place.get(), scalars.back().get(), f.ctx.get());
+        f.openssl.Mul(f.group.get(), expected.get(), base.get(), scalars.back().get(), f.ctx.get());
+        assert(f.same(expected.get(), in_place.get()));
+    }
+    f.native.Mul(f.group.get(), actual.get(), infinity.get(), scalars.back().get(), f.ctx.get());
+    assert(EC_POINT_is_at_infinity(f.group.get(), actual.get()));
+    std::cout << "Variable-base multiplication matches OpenSSL." << std::endl;
+}
+
+void fixed_base_test(Fixture& f) {
+    EcPointPtr expected(EC_POINT_new(f.group.get()));
+    EcPointPtr actual(EC_POINT_new(f.group.get()));
+    auto scalars = f.scalars(50);
+    for (bool jacobian : {false, true}) {
+        EcPointPtr base = f.random_point(jacobian);
+        auto native_table = f.native.NewFixedBase(f.group.get(), base.get(), 8);
+        auto openssl_table = f.openssl.NewFixedBase(f.group.get(), base.get(), 8);
+        assert(f.same(native_table->GetBase(), base.get()));
+        for (const auto& k : scalars) {
+            openssl_table->Mul(expected.get(), k.get(), f.ctx.get());
+            native_table->Mul(actual.get(), k.get(), nullptr);
+            assert(f.same(expected.get(), actual.get()));
+            // 秘密标量的常数时间路径与查表结果一致
+            native_table->MulSecret(actual.get(), k.get(), nullptr);
+            assert(f.same(expected.get(), actual.get()));
+            openssl_table->MulSecret(actual.get(), k.get(), f.ctx.get());
+            assert(f.same(expected.get(), actual.get()));
+        }
+    }
+    std::cout << "Fixed-base tables match OpenSSL." << std::endl;
+}
+
+void multi_mul_test(Fixture& f) {
+    EcPointPtr expected(EC_POINT_new(f.group.get()));
+    EcPointPtr actual(EC_POINT_new(f.group.get()));
+    // 跨越 Straus 与 Pippenger 的切换点
+    for (size_t n : {0, 1, 2, 3, 17, 47, 48, 49, 64, 200, 1500}) {
+        std::vector<EcPointPtr> owned;
+        std::vector<const EC_POINT*> points;
+        std::vector<BnPtr> scalar_owned = f.scalars(n);
+        std::vector<const BIGNUM*> scalars;
+        for (size_t i = 0; i < n; ++i) {
+            owned.push_back(f.random_point(i % 3 == 0));
+            points.push_back(owned.back().get());
+            scalars.push_back(scalar_owned[i + 9].get());
+        }
+        if (n >= 3) {
+            // 重复点与互为相反数的点触发加法中 H = 0 的分支；零标量、无穷远点与超出阶的标量被跳过或约化
+            EC_POINT_copy(owned[1].get(), owned[0].get());
+            EC_POINT_copy(owned[2].get(), owned[0].get());
+            EC_POINT_invert(f.group.get(), owned[2].get(), f.ctx.get());
+            scalars[1] = scalars[0];
+            scalars[2] = scalars[0];
+        }
+        if (n >= 17) {
+            scalars[3] = scalar_owned[0].get();   // 0
+            EC_POINT_set_to_infinity(f.group.get(), owned[4].get());
+            scalars[5] = scalar_owned[5].get();   // 2n + 7
+            scalars[6] = scalar_owned[8].get();   // 负数
+            scalars[7] = scalar_owned[3].get();   // n - 1
+        }
+        f.openssl.MultiMul(f.group.get(), expected.get(), points, scalars, f.ctx.get());
+        f.native.MultiMul(f.group.get(), actual.get(), points, scalars, f.ctx.get());
+        assert(f.same(expected.get(), actual.get()));
+    }
+
+    // 结果为无穷远点：a P + (n - a) P
+    EcPointPtr p = f.random_point(true);
+    BnPtr a(BN_new()), b(BN_new());
+    BN_rand_range(a.get(), EC_GROUP_get0_order(f.group.get()));
+    BN_sub(b.get(), EC_GROUP_get0_order(f.group.get()), a.get());
+    f.native.MultiMul(f.group.get(), actual.get(), {p.get(), p.get()}, {a.get(), b.get()}, f.ctx.get());
+    assert(EC_POINT_is_at_infinity(f.group.get(), actual.get()));
+    std::cout << "Multi-scalar multiplication matches OpenSSL." << std::endl;
+}
+
+void speed_test(Fixture& f) {
+    const size_t n = 1000;
+    std::vector<EcPointPtr> owned;
+    std::vector<const EC_POINT*> points;
+    std::vector<BnPtr> scalar_owned = f.scalars(n);
+    std::vector<const BIGNUM*> scalars;
+    for (size_t i = 0; i < n; ++i) {
+        owned.push_back(f.random_point(false));
+        points.push_back(owned.back().get());
+        scalars.push_back(scalar_owned[i + 9].get());
+    }
+    EcPointPtr r(EC_POINT_new(f.group.get()));
+    auto time_us = [](auto&& fn) {
+        auto start = high_resolution_clock::now();
+        fn();
+        return duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+    };
+    auto openssl_us = time_us([&] { f.openssl.MultiMul(f.group.get(), r.get(), points, scalars, f.ctx.get()); });
+    auto native_us = time_us([&] { f.native.MultiMul(f.group.get(), r.get(), points, scalars, f.ctx.get()); });
+    std::cout << "MSM of " << n << " points: openssl " << openssl_us / 1000.0 << " ms, native "
+              << native_us / 1000.0 << " ms" << std::endl;
+}
+
+void free_signature(Signature& sig) {
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+}
+
+// 两个后端生成的签名互相验证：同一签名者的密钥分别以原生后端与 OpenSSL 后端加载
+void cross_backend_test(const std::string& config_path, const std::string& sign_key_path, KeyGenerator& keygen) {
+    // 40 个成员，验证中每个分块的多标量乘法走 Pippenger
+    const int participant_count = 40;
+    std::vector<Signer> signers(participant_count);
+    std::vector<RingContext::Member> members;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        members.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+    Signer& native_signer = signers[6];
+    assert(std::string(native_signer.GetEcBackend().Name()) == "secp256k1");
+    assert(std::string(keygen.GetEcBackend().Name()) == "secp256k1");
+    native_signer.SaveConfig(sign_key_path);
+
+    EcBackend::SetNativeEnabled(false);
+    Signer openssl_signer;
+    openssl_signer.LoadConfig(config_path, sign_key_path);
+    EcBackend::SetNativeEnabled(true);
+    assert(std::string(openssl_signer.GetEcBackend().Name()) == "openssl");
+
+    // 两个后端构建的环上下文逐项相同（h_i 与 K_i）
+    RingContext native_ring = native_signer.CreateRingContext(members);
+    RingContext openssl_ring = openssl_signer.CreateRingContext(members);
+    const EC_GROUP* group = native_signer.GetGroup();
+    for (size_t i = 0; i < native_ring.Size(); ++i) {
+        assert(BN_cmp(native_ring[i].h, openssl_ring[i].h) == 0);
+        assert(EC_POINT_cmp(group, native_ring[i].K, openssl_ring[i].K, nullptr) == 0);
+    }
+
+    const std::string msg = "cross backend";
+    const std::string event = "backend event";
+    for (Signer* signer : {&native_signer, &openssl_signer}) {
+        Signature sig = signer->Sign(msg, event, native_ring);
+        bool verified = native_signer.Verify(sig, msg, event, native_ring);
+        assert(verified);
+        verified = openssl_signer.Verify(sig, msg, event, openssl_ring);
+        assert(verified);
+        verified = native_signer.Verify(sig, msg + "!", event, native_ring);
+        assert(!verified);
+        verified = openssl_signer.Verify(sig, msg + "!", event, openssl_ring);
+        assert(!verified);
+        std::vector<SignatureInput> batch(3, SignatureInput{sig, msg, event, native_ring});
+        for (bool ok : native_signer.VerifyBatch(batch)) assert(ok);
+        free_signature(sig);
+    }
+    std::cout << "Signatures verify across the native and OpenSSL backends." << std::endl;
+}
+
+int main() {
+    Fixture f;
+    assert(std::string(f.native.Name()) == "secp256k1");
+    // secp256k1 默认自动选择原生后端
+    if (!std::getenv("RINGSIGN_EC_BACKEND")) {
+        assert(EcBackend::NativeEnabled());
+        assert(&EcBackend::ForGroup(f.group.get()) == &f.native);
+    }
+    EcBackend::SetNativeEnabled(false);
+    assert(&EcBackend::ForGroup(f.group.get()) == &EcBackend::OpenSsl());
+    EcBackend::SetNativeEnabled(true);
+    assert(&EcBackend::ForGroup(f.group.get()) == &f.native);
+    EcGroupPtr p256(EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1));
+    assert(&EcBackend::ForGroup(p256.get()) == &EcBackend::OpenSsl());
+    assert(EcBackend::Native(NID_X9_62_prime256v1) == nullptr);
+
+    mul_test(f);
+    fixed_base_test(f);
+    multi_mul_test(f);
+    speed_test(f);
+
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_ec_backend_config.json").string();
+    std::string key_path = (dir / "test_ec_backend_key.json").string();
+    std::string sign_key_path = (dir / "test_ec_backend_sign_key.json").string();
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+    cross_backend_test(config_path, sign_key_path, keygen);
+    for (const auto& path : {config_path, key_path, sign_key_path}) {
+        std::filesystem::remove(path);
+    }
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
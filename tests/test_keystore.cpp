@@ -0,0 +1,177 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/keystore.h"
+
+using namespace ring_signature_lib;
+using namespace std::chrono;
+
+template <typename F>
+bool throws(F&& f) {
+    try {
+        f();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+bool same_entry(const EC_GROUP* group, const RingContext::Entry& a, const RingContext::Entry& b) {
+    return a.id == b.id && EC_POINT_cmp(group, a.X, b.X, nullptr) == 0 && EC_POINT_cmp(group, a.Y, b.Y, nullptr) == 0 &&
+           EC_POINT_cmp(group, a.XY, b.XY, nullptr) == 0 && BN_cmp(a.h, b.h) == 0 &&
+           a.X_enc.hex == b.X_enc.hex && a.Y_enc.compressed == b.Y_enc.compressed &&
+           (a.K == nullptr) == (b.K == nullptr) && (!a.K || EC_POINT_cmp(group, a.K, b.K, nullptr) == 0);
+}
+
+void free_signature(Signature& sig) {
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+}
+
+void keystore_test(const std::string& config_path, KeyGenerator& keygen, const std::string& other_config_path) {
+    const size_t count = 200;
+    Signer parameters;
+    parameters.Initialize("", config_path);
+    std::vector<Signer> signers(count);
+    std::vector<std::pair<std::string, const EC_POINT*>> partial;
+    for (size_t i = 0; i < count; ++i) {
+        // ID 不按字典序生成，检查目录内的排序
+        std::string signer_id = "member" + std::to_string((i * 7919) % count);
+        signers[i].Initialize(signer_id, parameters);
+        partial.emplace_back(signer_id, signers[i].GeneratePartialKey().second);
+    }
+    auto keys = keygen.GenerateSignKeys(partial);
+    std::vector<RingContext::Member> members;
+    for (size_t i = 0; i < count; ++i) {
+        signers[i].GenerateFullKey(keys[i].first.get(), keys[i].second.get());
+        members.emplace_back(partial[i].first, signers[i].GetPublicKey());
+    }
+    const EC_GROUP* group = parameters.GetGroup();
+
+    auto path = (std::filesystem::temp_directory_path() / "test_keystore.bin").string();
+    RingContext full = parameters.CreateRingContext(members);
+    Keystore::Save(path, full, parameters.SystemFingerprint(), parameters.GetTranscriptVersion());
+
+    Keystore keystore(path);
+    assert(keystore.Size() == count);
+    assert(keystore.CurveNid() == EC_GROUP_get_curve_name(group));
+    assert(keystore.Fingerprint() == parameters.SystemFingerprint());
+    for (size_t i = 0; i < count; ++i) {
+        assert(keystore.IndexOf(full[i].id) == static_cast<long>(i));
+        assert(keystore.Id(i) == full[i].id);
+        if (i > 0) assert(keystore.Id(i - 1) < keystore.Id(i));
+    }
+    assert(keystore.IndexOf("member") == -1);
+    assert(keystore.IndexOf("zzz") == -1);
+    assert(keystore.IndexOf("") == -1);
+    std::cout << "Keystore of " << count << " members, " << std::filesystem::file_size(path) << " bytes." << std::endl;
+
+    // 由目录构建的环与由公钥构建的环完全相同（包括 h_i 与 K_i）
+    std::vector<std::string> ids = {partial[5].first, partial[0].first, partial[77].first, partial[150].first};
+    std::vector<RingContext::Member> subset = {members[5], members[0], members[77], members[150]};
+    RingContext expected = parameters.CreateRingContext(subset);
+    RingContext loaded = parameters.CreateRingContext(keystore, ids);
+    assert(loaded.Size() == expected.Size() && loaded.HasCombinedPoints());
+    for (size_t i = 0; i < loaded.Size(); ++i) assert(same_entry(group, loaded[i], expected[i]));
+    RingContext lazy = parameters.CreateRingContext(keystore, ids, false);
+    assert(!lazy.HasCombinedPoints() && lazy[0].K == nullptr && BN_cmp(lazy[0].h, expected[0].h) == 0);
+
+    // 目录构建的环上签名，公钥构建的环上验证，反之亦然
+    Signature sig = signers[77].Sign("keystore message", "event", loaded);
+    bool verified = signers[0].Verify(sig, "keystore message", "event", expected);
+    assert(verified);
+    verified = signers[0].Verify(sig, "keystore message", "event", lazy);
+    assert(verified);
+    verified = signers[0].Verify(sig, "other message", "event", loaded);
+    assert(!verified);
+    free_signature(sig);
+    sig = signers[5].Sign("keystore message", "event", expected);
+    verified = signers[150].Verify(sig, "keystore message", "event", loaded);
+    assert(verified);
+    free_signature(sig);
+    std::cout << "Keystore ring matches the ring built from public keys." << std::endl;
+
+    // 整个目录作为一个环：单线程与多线程加载相同，且远快于重新计算 h_i 与 K_i
+    std::vector<std::string> all_ids;
+    for (const auto& member : members) all_ids.push_back(member.first);
+    auto start = high_resolution_clock::now();
+    RingContext rebuilt = parameters.CreateRingContext(members);
+    auto build_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+    start = high_resolution_clock::now();
+    RingContext serial = parameters.CreateRingContext(keystore, all_ids);
+    auto load_us = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+    parameters.SetThreadCount(3);
+    RingContext parallel = parameters.CreateRingContext(keystore, all_ids);
+    parameters.SetThreadCount(0);
+    for (size_t i = 0; i < count; ++i) {
+        assert(same_entry(group, serial[i], rebuilt[i]));
+        assert(same_entry(group, parallel[i], rebuilt[i]));
+    }
+    std::cout << "Ring of " << count << ": build " << build_us / 1000.0 << " ms, keystore load "
+              << load_us / 1000.0 << " ms" << std::endl;
+
+    // 不存在或重复的成员、其他系统参数、损坏的文件均被拒绝
+    bool threw = throws([&] { parameters.CreateRingContext(keystore, {partial[0].first, "nobody"}); });
+    assert(threw);
+    threw = throws([&] { parameters.CreateRingContext(keystore, {partial[0].first, partial[0].first}); });
+    assert(threw);
+    Signer other;
+    other.Initialize("", other_config_path);
+    assert(other.SystemFingerprint() != parameters.SystemFingerprint());
+    threw = throws([&] { other.CreateRingContext(keystore, ids); });
+    assert(threw);
+
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto corrupted_path = path + ".corrupted";
+    {
+        std::ofstream out(corrupted_path, std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+    }
+    threw = throws([&] { Keystore truncated(corrupted_path); });
+    assert(threw);
+    threw = throws([&] { Keystore missing(path + ".missing"); });
+    assert(threw);
+    std::cout << "Unknown members, foreign systems and corrupted files rejected." << std::endl;
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(corrupted_path);
+}
+
+int main() {
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_keystore_config.json").string();
+    std::string key_path = (dir / "test_keystore_key.json").string();
+    std::string other_config_path = (dir / "test_keystore_other_config.json").string();
+    std::string other_key_path = (dir / "test_keystore_other_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+    KeyGenerator other_keygen;
+    other_keygen.Initialize();
+    other_keygen.SaveConfig(other_config_path, other_key_path);
+
+    keystore_test(config_path, keygen, other_config_path);
+
+    for (const auto& path : {config_path, key_path, other_config_path, other_key_path}) {
+        std::filesystem::remove(path);
+    }
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,358 @@
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <sys/socket.h>
+#include <nlohmann/json.hpp>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/bulk_enrollment.h"
+#include "libringsign/ec_handles.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/kgc_server.h"
+#include "libringsign/network_utils.h"
+#include "libringsign/signer.h"
+
+using namespace ring_signature_lib;
+using json = nlohmann::json;
+using namespace std::chrono;
+
+// 服务端写完响应后关闭连接，读到连接关闭为止
+std::string recv_until_close(TCPClient& client) {
+    std::string response;
+    try {
+        for (;;) response += client.Recv();
+    } catch (const std::exception&) {
+    }
+    return response;
+}
+
+// 按阻塞版 keygen -signer 的流程完成一次密钥协商，并校验得到的完整密钥
+bool enroll(int port, const std::string& config_path, const std::string& signer_id, bool split) {
+    Signer signer;
+    signer.Initialize(signer_id, config_path);
+    auto partial_key = signer.GeneratePartialKey();
+    json req = {{"id", signer_id}, {"partial_pub", PointToHex(signer.GetGroup(), partial_key.second)}};
+    std::string payload = req.dump();
+
+    TCPClient client("127.0.0.1", port);
+    client.Connect();
+    if (split) {
+        // 请求分两次到达，服务端需等待 JSON 完整
+        client.Send(payload.substr(0, 10));
+        std::this_thread::sleep_for(milliseconds(20));
+        client.Send(payload.substr(10));
+    } else {
+        client.Send(payload);
+    }
+    json resp = json::parse(recv_until_close(client));
+    if (resp.contains("error")) return false;
+
+    EcPointPtr partial_system_pub = PointFromHex(signer.GetGroup(), resp["partial_system_pub"].get<std::string>());
+    BnPtr partial_priv = BnFromHex(resp["partial_priv"].get<std::string>());
+    signer.GenerateFullKey(partial_system_pub.get(), partial_priv.get());
+    return signer.VerifyKey();
+}
+
+// 用 KGC 的响应补全签名者密钥并校验
+bool finish_enrollment(Signer& signer, const std::string& response) {
+    json resp = json::parse(response);
+    if (resp.contains("error")) return false;
+    EcPointPtr partial_system_pub = PointFromHex(signer.GetGroup(), resp["partial_system_pub"].get<std::string>());
+    BnPtr partial_priv = BnFromHex(resp["partial_priv"].get<std::string>());
+    signer.GenerateFullKey(partial_system_pub.get(), partial_priv.get());
+    return signer.VerifyKey();
+}
+
+std::string enroll_request(Signer& signer, const std::string& signer_id) {
+    auto partial_key = signer.GeneratePartialKey();
+    return json{{"op", "enroll"}, {"id", signer_id},
+                {"partial_pub", PointToHex(signer.GetGroup(), partial_key.second)}}.dump();
+}
+
+// 分帧协议：同一连接上获取系统参数并多次签发，随后不等响应连续发送多个请求，响应按请求顺序返回
+void framed_test(const std::string& config_path, KeyGenerator& keygen) {
+    KgcServerOptions options;
+    options.port = 0;
+    options.workers = 3;
+    options.max_pipeline = 4;   // 小于流水线请求数，服务端需暂停读取再恢复
+    options.max_read_per_wakeup = 1000;  // 帧跨越多次可读事件
+    options.report_interval = 0;
+    KgcServer server(keygen, options);
+    std::thread loop([&] { server.Run(); });
+
+    TCPClient client("127.0.0.1", server.Port());
+    client.Connect();
+    std::string response;
+
+    client.SendFrame(json{{"op", "params"}}.dump());
+    bool received = client.RecvFrame(response);
+    assert(received);
+    assert(json::parse(response) == keygen.GetPublicConfig());
+
+    // 持久连接：请求—响应交替进行
+    for (int r = 0; r < 3; ++r) {
+        std::string id = "keepalive" + std::to_string(r);
+        Signer signer;
+        signer.Initialize(id, config_path);
+        client.SendFrame(enroll_request(signer, id));
+        received = client.RecvFrame(response);
+        assert(received);
+        bool finished = finish_enrollment(signer, response);
+        assert(finished);
+    }
+
+    // 流水线：先发送全部请求，其中夹有无效请求，再依次读取响应
+    const int pipelined = 12;
+    std::vector<Signer> signers(pipelined);
+    for (int r = 0; r < pipelined; ++r) {
+        std::string id = "pipelined" + std::to_string(r);
+        signers[r].Initialize(id, config_path);
+        if (r == 5) {
+            client.SendFrame(json{{"op", "unknown"}}.dump());
+        }
+        client.SendFrame(enroll_request(signers[r], id));
+    }
+    for (int r = 0; r < pipelined; ++r) {
+        if (r == 5) {
+            received = client.RecvFrame(response);
+            assert(received);
+            assert(json::parse(response).contains("error"));
+        }
+        received = client.RecvFrame(response);
+        assert(received);
+        bool finished = finish_enrollment(signers[r], response);
+        assert(finished);
+    }
+
+    // 关闭写端后服务端仍写出剩余的响应，再关闭连接
+    Signer last;
+    last.Initialize("half_closed", config_path);
+    client.SendFrame(enroll_request(last, "half_closed"));
+    shutdown(client.Fd(), SHUT_WR);
+    received = client.RecvFrame(response);
+    assert(received);
+    bool finished = finish_enrollment(last, response);
+    assert(finished);
+    received = client.RecvFrame(response);
+    assert(!received);
+    client.Close();
+
+    // 超过 max_request_size 的帧返回错误，随后连接关闭
+    {
+        TCPClient big("127.0.0.1", server.Port());
+        big.Connect();
+        big.SendFrame(std::string(options.max_request_size + 1, 'x'));
+        received = big.RecvFrame(response);
+        assert(received);
+        assert(json::parse(response).contains("error"));
+        received = big.RecvFrame(response);
+        assert(!received);
+    }
+
+    assert(server.Enrollments() == 3 + pipelined + 1);
+    assert(server.Errors() == 2);
+    server.Stop();
+    loop.join();
+    std::cout << "Framed persistent/pipelined KGC connections passed." << std::endl;
+}
+
+// 批量签发：与逐个签发的结果相同；超过普通请求上限的批量帧可以流水线发送，无效条目单独报错
+void bulk_test(const std::string& config_path, KeyGenerator& keygen) {
+    Signer parameters;
+    parameters.Initialize("", config_path);
+    EC_GROUP* group = parameters.GetGroup();
+
+    // GenerateSignKeys 与使用同一 seed 逐个调用 GenerateSignKey 的结果一致
+    {
+        std::vector<Signer> signers(3);
+        std::vector<std::pair<std::string, const EC_POINT*>> entries;
+        for (int i = 0; i < 3; ++i) {
+            signers[i].Initialize("batch" + std::to_string(i), parameters);
+            entries.emplace_back("batch" + std::to_string(i), signers[i].GeneratePartialKey().second);
+        }
+        auto keys = keygen.GenerateSignKeys(entries, 12345);
+        assert(keys.size() == entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            auto [Y, z] = keygen.GenerateSignKey(entries[i].first, entries[i].second, 12345);
+            EcPointPtr Y_handle(Y);
+            BnPtr z_handle(z);
+            assert(EC_POINT_cmp(group, Y, keys[i].first.get(), nullptr) == 0);
+            assert(BN_cmp(z, keys[i].second.get()) == 0);
+        }
+    }
+
+    // 编解码往返与截断检测
+    {
+        std::vector<BulkEnrollmentRequest> requests = {{"a", std::string(33, '\x02')}, {"", ""}};
+        std::string frame = EncodeBulkRequest(requests);
+        assert(IsBulkRequest(frame));
+        auto decoded = DecodeBulkRequest(frame);
+        assert(decoded.size() == 2 && decoded[0].id == "a" && decoded[0].partial_pub == requests[0].partial_pub);
+        bool threw = false;
+        try {
+            DecodeBulkRequest(std::string_view(frame).substr(0, frame.size() - 1));
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    KgcServerOptions options;
+    options.port = 0;
+    options.workers = 2;
+    options.report_interval = 0;
+    KgcServer server(keygen, options);
+    std::thread loop([&] { server.Run(); });
+
+    const size_t batches = 2;
+    const size_t per_batch = 2000;  // 每帧约 90 KB，超过普通请求的 64 KB 上限
+    std::vector<Signer> signers(batches * per_batch);
+    TCPClient client("127.0.0.1", server.Port());
+    client.Connect();
+    unsigned char buf[1 + 2 * 66];
+    for (size_t b = 0; b < batches; ++b) {
+        std::vector<BulkEnrollmentRequest> requests;
+        for (size_t k = 0; k < per_batch; ++k) {
+            size_t i = b * per_batch + k;
+            std::string id = "bulk" + std::to_string(i);
+            signers[i].Initialize(id, parameters);
+            auto partial_key = signers[i].GeneratePartialKey();
+            size_t len = EC_POINT_point2oct(group, partial_key.second, POINT_CONVERSION_COMPRESSED, buf, sizeof(buf), nullptr);
+            requests.push_back({id, std::string(reinterpret_cast<const char*>(buf), len)});
+        }
+        if (b == 1) requests[7].partial_pub = "not a point";
+        std::string frame = EncodeBulkRequest(requests);
+        assert(frame.size() > options.max_request_size);
+        client.SendFrame(frame);
+    }
+    // 批量帧之后的普通请求仍按顺序响应
+    client.SendFrame(json{{"op", "params"}}.dump());
+
+    auto start = steady_clock::now();
+    size_t enrolled = 0;
+    std::string response;
+    for (size_t b = 0; b < batches; ++b) {
+        bool received = client.RecvFrame(response);
+        assert(received);
+        auto results = DecodeBulkResponse(response);
+        assert(results.size() == per_batch);
+        for (size_t k = 0; k < per_batch; ++k) {
+            if (b == 1 && k == 7) {
+                assert(!results[k].ok && !results[k].error.empty());
+                continue;
+            }
+            assert(results[k].ok);
+            Signer& signer = signers[b * per_batch + k];
+            EcPointPtr Y(EC_POINT_new(group));
+            const std::string& pub = results[k].partial_system_pub;
+            bool decoded = EC_POINT_oct2point(group, Y.get(), reinterpret_cast<const unsigned char*>(pub.data()), pub.size(), nullptr);
+            assert(decoded);
+            const std::string& priv = results[k].partial_priv;
+            BnPtr z(BN_bin2bn(reinterpret_cast<const unsigned char*>(priv.data()), static_cast<int>(priv.size()), nullptr));
+            signer.GenerateFullKey(Y.get(), z.get());
+            bool key_valid = signer.VerifyKey();
+            assert(key_valid);
+            ++enrolled;
+        }
+    }
+    bool received = client.RecvFrame(response);
+    assert(received);
+    assert(json::parse(response) == keygen.GetPublicConfig());
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    client.Close();
+
+    assert(enrolled == batches * per_batch - 1);
+    assert(server.Enrollments() == enrolled);
+    assert(server.Errors() == 1);
+    server.Stop();
+    loop.join();
+    std::cout << "Bulk enrolled " << enrolled << " signers in " << batches << " frames: "
+              << enrolled / seconds << " enrollments/s (including client-side key checks)" << std::endl;
+}
+
+void kgc_server_test(const std::string& config_path, KeyGenerator& keygen) {
+    KgcServerOptions options;
+    options.port = 0;
+    options.max_connections = 4;   // 小于并发客户端数，超出的连接在 listen 队列中等待
+    options.workers = 2;
+    options.report_interval = 0;
+    KgcServer server(keygen, options);
+    int port = server.Port();
+    std::thread loop([&] { server.Run(); });
+
+    const int clients = 8;
+    const int per_client = 5;
+    std::atomic<int> ok{0};
+    std::vector<std::thread> threads;
+    auto start = steady_clock::now();
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            for (int r = 0; r < per_client; ++r) {
+                std::string id = "signer" + std::to_string(c * per_client + r);
+                if (enroll(port, config_path, id, r == 0)) ++ok;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    assert(ok == clients * per_client);
+    assert(server.Enrollments() == static_cast<size_t>(clients * per_client));
+    std::cout << "Enrolled " << ok << " signers over " << clients << " concurrent clients: "
+              << ok / seconds << " enrollments/s" << std::endl;
+
+    // 无效请求返回错误，不影响服务
+    {
+        TCPClient client("127.0.0.1", port);
+        client.Connect();
+        client.Send(R"({"id": "bad", "partial_pub": "zz"})");
+        json resp = json::parse(recv_until_close(client));
+        assert(resp.contains("error"));
+    }
+    // 超过 max_request_size 的请求：服务端读到上限即返回错误，其余输入丢弃，响应在连接关闭前到达
+    {
+        TCPClient client("127.0.0.1", port);
+        client.Connect();
+        client.Send("{" + std::string(options.max_request_size * 4, ' '));
+        json resp = json::parse(recv_until_close(client));
+        assert(resp.contains("error"));
+    }
+    // 请求不完整时对端关闭，连接被回收
+    {
+        TCPClient client("127.0.0.1", port);
+        client.Connect();
+        client.Send(R"({"id": "trunc)");
+        client.Close();
+    }
+    bool accepted = enroll(port, config_path, "after_errors", false);
+    assert(accepted);
+    assert(server.Errors() == 2);
+
+    server.Stop();
+    loop.join();
+    std::cout << "Concurrent KGC server passed." << std::endl;
+}
+
+int main() {
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_kgc_server_config.json").string();
+    std::string key_path = (dir / "test_kgc_server_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+
+    kgc_server_test(config_path, keygen);
+    framed_test(config_path, keygen);
+    bulk_test(config_path, keygen);
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
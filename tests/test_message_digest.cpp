@@ -0,0 +1,74 @@
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include "libringsign/mapped_file.h"
+#include "libringsign/message_digest.h"
+
+using namespace ring_signature_lib;
+
+int main() {
+    auto path = std::filesystem::temp_directory_path() / "test_message_digest.bin";
+    std::string content;
+    for (int i = 0; i < 300000; ++i) content.push_back(static_cast<char>(i * 31 + 7));
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    // 内存映射的视图与文件内容一致，可移动
+    {
+        MappedFile mapped(path.string());
+        assert(mapped.Size() == content.size());
+        assert(mapped.View() == content);
+        MappedFile moved(std::move(mapped));
+        assert(mapped.View().empty());
+        assert(moved.View() == content);
+    }
+    auto empty_path = std::filesystem::temp_directory_path() / "test_message_digest_empty.bin";
+    std::ofstream(empty_path, std::ios::binary).close();
+    {
+        MappedFile empty(empty_path.string());
+        assert(empty.Size() == 0 && empty.View().empty());
+        std::string digest = MessageDigest::DigestFile(empty_path.string());
+        assert(digest == MessageDigest::DigestString(""));
+    }
+    std::filesystem::remove(empty_path);
+
+    // 不同分块大小流式读取文件，结果与对内存中的消息计算一致
+    std::string expected = MessageDigest::DigestString(content);
+    for (size_t chunk_size : {1, 4096, 65536, 1 << 20}) {
+        std::string digest = MessageDigest::DigestFile(path.string(), MessageDigest::kDefaultAlgorithm, chunk_size);
+        assert(digest == expected);
+    }
+    for (const char* algorithm : {"SHA512", "SM3"}) {
+        std::string digest = MessageDigest::DigestFile(path.string(), algorithm, 4096);
+        assert(digest == MessageDigest::DigestString(content, algorithm));
+        assert(digest != expected);
+    }
+
+    // 方案中的 msg 带有域分隔前缀与算法名
+    assert(expected.compare(0, 26, "libringsign-digest:SHA256:") == 0);
+    assert(expected.size() == 26 + 32);
+
+    bool thrown = false;
+    try {
+        MessageDigest unsupported("NO_SUCH_DIGEST");
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        MessageDigest::DigestFile((path.string() + ".missing"));
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::filesystem::remove(path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
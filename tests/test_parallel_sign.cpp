@@ -0,0 +1,190 @@
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/thread_pool.h"
+
+using namespace ring_signature_lib;
+using namespace std::chrono;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+// 分块划分只取决于元素数、最小分块大小与线程数，异常在调用线程重新抛出，嵌套调用不死锁
+void thread_pool_test() {
+    ThreadPool pool(4);
+    assert(pool.Size() == 4);
+    assert(pool.ChunkCount(2) == 2);
+    assert(pool.ChunkCount(100) == 4);
+    assert(pool.ChunkCount(0) == 0);
+    assert(pool.ChunkCount(100, 64) == 1);   // 小规模任务留在调用线程
+    assert(pool.ChunkCount(200, 64) == 3);
+    assert(pool.ChunkCount(1000, 64) == 4);
+
+    std::vector<int> hits(103, 0);
+    std::vector<size_t> chunk_begin(pool.ChunkCount(hits.size()), 0);
+    pool.ParallelFor(hits.size(), [&](size_t chunk, size_t begin, size_t end) {
+        chunk_begin[chunk] = begin;
+        for (size_t i = begin; i < end; ++i) ++hits[i];
+    });
+    for (int h : hits) assert(h == 1);
+    for (size_t c = 1; c < chunk_begin.size(); ++c) assert(chunk_begin[c - 1] < chunk_begin[c]);
+
+    bool thrown = false;
+    try {
+        pool.ParallelFor(10, [](size_t chunk, size_t, size_t) {
+            if (chunk == 2) throw std::runtime_error("chunk failed");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::atomic<int> total{0};
+    pool.ParallelFor(4, [&](size_t, size_t begin, size_t end) {
+        pool.ParallelFor(8, [&](size_t, size_t b, size_t e) { total += static_cast<int>(e - b); });
+        total += static_cast<int>(end - begin);
+    });
+    assert(total == 4 * 8 + 4);
+    std::cout << "ThreadPool chunking, exceptions and nesting passed." << std::endl;
+}
+
+void parallel_sign_test(const std::string& config_path, KeyGenerator& keygen, int participant_count) {
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+    RingList others(ring.begin() + 1, ring.end());
+    std::string msg = "Test message";
+    std::string event = "Test event";
+
+    // 不同线程数生成的签名都能被单线程验证，多线程验证与单线程验证结果一致
+    Signer& verifier = signers[1];
+    for (size_t threads : {1, 2, 3, 8}) {
+        signers[0].SetThreadCount(threads);
+        signers[2].SetThreadCount(threads);
+        assert(signers[0].GetThreadCount() == threads);
+        auto start = high_resolution_clock::now();
+        Signature sig = signers[0].Sign(msg, event, others);
+        auto sign_elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+        bool verified = verifier.Verify(sig, msg, event, ring);
+        assert(verified);
+        verified = verifier.Verify(sig, msg + "!", event, ring);
+        assert(!verified);
+
+        start = high_resolution_clock::now();
+        bool parallel_ok = signers[2].Verify(sig, msg, event, ring);
+        auto verify_elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+        assert(parallel_ok);
+        verified = signers[2].Verify(sig, msg + "!", event, ring);
+        assert(!verified);
+        std::cout << "n=" << participant_count << "  threads: " << threads
+                  << "  sign: " << sign_elapsed / 1000.0 << " ms"
+                  << "  verify: " << verify_elapsed / 1000.0 << " ms" << std::endl;
+
+        for (auto* p : sig.A) EC_POINT_free(p);
+        BN_free(sig.phi);
+        BN_free(sig.psi);
+        EC_POINT_free(sig.T);
+    }
+    signers[0].SetThreadCount(0);
+    assert(signers[0].GetThreadCount() == 1);
+}
+
+// 批量签发：不同线程数的结果按输入顺序排列且与逐个签发相同；未指定 seed 时各批次的 ξ 不同；
+// GenerateSignKey 可在多个线程中并发调用
+void parallel_keygen_test(const std::string& config_path, KeyGenerator& keygen) {
+    const size_t count = 300;
+    Signer parameters;
+    parameters.Initialize("", config_path);
+    std::vector<Signer> signers(count);
+    std::vector<std::pair<std::string, const EC_POINT*>> entries;
+    for (size_t i = 0; i < count; ++i) {
+        std::string signer_id = "batch" + std::to_string(i);
+        signers[i].Initialize(signer_id, parameters);
+        entries.emplace_back(signer_id, signers[i].GeneratePartialKey().second);
+    }
+    const EC_GROUP* group = keygen.GetGroup();
+
+    keygen.SetThreadCount(0);
+    auto expected = keygen.GenerateSignKeys(entries, 777);
+    for (size_t threads : {2, 3, 8}) {
+        keygen.SetThreadCount(threads);
+        assert(keygen.GetThreadCount() == threads);
+        auto start = high_resolution_clock::now();
+        auto keys = keygen.GenerateSignKeys(entries, 777);
+        auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+        assert(keys.size() == count);
+        for (size_t i = 0; i < count; ++i) {
+            assert(EC_POINT_cmp(group, keys[i].first.get(), expected[i].first.get(), nullptr) == 0);
+            assert(BN_cmp(keys[i].second.get(), expected[i].second.get()) == 0);
+        }
+        std::cout << "GenerateSignKeys n=" << count << "  threads: " << threads << "  " << elapsed / 1000.0
+                  << " ms" << std::endl;
+    }
+
+    // 随机的 ξ：每批不同，签发的密钥仍然有效
+    auto first = keygen.GenerateSignKeys(entries.data(), 1);
+    auto second = keygen.GenerateSignKeys(entries.data(), 1);
+    assert(BN_cmp(first[0].second.get(), second[0].second.get()) != 0);
+    signers[0].GenerateFullKey(first[0].first.get(), first[0].second.get());
+    bool key_valid = signers[0].VerifyKey();
+    assert(key_valid);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> valid{0};
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = t; i < 40; i += 4) {
+                auto [Y, z] = keygen.GenerateSignKey(entries[i].first, entries[i].second, 777);
+                if (EC_POINT_cmp(group, Y, expected[i].first.get(), nullptr) == 0 &&
+                    BN_cmp(z, expected[i].second.get()) == 0) {
+                    ++valid;
+                }
+                EC_POINT_free(Y);
+                BN_free(z);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    assert(valid == 40);
+    keygen.SetThreadCount(0);
+    std::cout << "Parallel GenerateSignKeys passed." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int participant_count = argc > 1 ? std::stoi(argv[1]) : 50;
+
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_parallel_sign_config.json").string();
+    std::string key_path = (dir / "test_parallel_sign_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+
+    thread_pool_test();
+    parallel_sign_test(config_path, keygen, participant_count);
+    parallel_keygen_test(config_path, keygen);
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cassert>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include "libringsign/precompute.h"
+
+using namespace ring_signature_lib;
+
+// 固定基点表的结果必须与 EC_POINT_mul 一致
+void fixed_base_test(const EC_GROUP* group, BN_CTX* ctx) {
+    const BIGNUM* order = EC_GROUP_get0_order(group);
+    BIGNUM* k = BN_new();
+    EC_POINT* base = EC_POINT_new(group);
+    EC_POINT* expected = EC_POINT_new(group);
+    EC_POINT* actual = EC_POINT_new(group);
+
+    BN_rand_range(k, order);
+    EC_POINT_mul(group, base, k, nullptr, nullptr, ctx);
+
+    for (int teeth : {1, 4, 5, 8}) {
+        FixedBaseTable table(group, base, teeth);
+        for (int i = 0; i < 20; ++i) {
+            if (i == 0) {
+                BN_zero(k);
+            } else if (i == 1) {
+                BN_sub(k, order, BN_value_one());
+            } else if (i == 2) {
+                BN_lshift(k, order, 1);  // 超出群阶的标量
+                BN_add_word(k, 7);
+            } else {
+                BN_rand_range(k, order);
+            }
+            EC_POINT_mul(group, expected, nullptr, base, k, ctx);
+            table.Mul(actual, k, ctx);
+            assert(EC_POINT_cmp(group, expected, actual, ctx) == 0);
+        }
+    }
+    std::cout << "Fixed-base table matches EC_POINT_mul." << std::endl;
+
+    BN_free(k);
+    EC_POINT_free(base);
+    EC_POINT_free(expected);
+    EC_POINT_free(actual);
+}
+
+// 事件表 LRU 的命中、未命中与淘汰计数
+void event_cache_test(const EC_GROUP* group, BN_CTX* ctx) {
+    HashUtils h0("test_key");
+    EC_POINT* ppub = EC_POINT_new(group);
+    BIGNUM* s = BN_new();
+    BN_rand_range(s, EC_GROUP_get0_order(group));
+    EC_POINT_mul(group, ppub, s, nullptr, nullptr, ctx);
+
+    PrecomputeCache cache(group, ppub, h0, 2);
+    auto e1 = cache.EventTable("event1");
+    auto e1_again = cache.EventTable("event1");
+    assert(e1 == e1_again);
+
+    // E = H_0(event) * G
+    BIGNUM* e_scalar = h0.hashToBn("event1");
+    EC_POINT* E = EC_POINT_new(group);
+    EC_POINT_mul(group, E, e_scalar, nullptr, nullptr, ctx);
+    assert(EC_POINT_cmp(group, E, e1->GetBase(), ctx) == 0);
+
+    cache.EventTable("event2");
+    cache.EventTable("event3");  // 淘汰 event1
+    cache.EventTable("event1");
+
+    PrecomputeCache::Stats stats = cache.GetStats();
+    assert(stats.hits == 1);
+    assert(stats.misses == 4);
+    assert(stats.evictions == 2);
+    assert(stats.size == 2);
+    assert(stats.capacity == 2);
+    std::cout << "Event cache hits: " << stats.hits << ", misses: " << stats.misses
+              << ", evictions: " << stats.evictions << std::endl;
+
+    BN_free(s);
+    BN_free(e_scalar);
+    EC_POINT_free(E);
+    EC_POINT_free(ppub);
+}
+
+int main() {
+    EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+    BN_CTX* ctx = BN_CTX_new();
+    fixed_base_test(group, ctx);
+    event_cache_test(group, ctx);
+    BN_CTX_free(ctx);
+    EC_GROUP_free(group);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
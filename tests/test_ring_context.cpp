@@ -0,0 +1,108 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <filesystem>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+
+using namespace ring_signature_lib;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+void free_signature(Signature& sig) {
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+}
+
+void ring_context_test(const std::string& config_path, KeyGenerator& keygen) {
+    const int participant_count = 5;
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(participant_count - i);  // 乱序 ID
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+
+    RingContext ctx = signers[0].CreateRingContext(ring);
+    assert(ctx.Size() == participant_count);
+    assert(ctx.HasCombinedPoints());
+    for (size_t i = 1; i < ctx.Size(); ++i) {
+        assert(ctx[i - 1].id < ctx[i].id);  // 按 ID 排序
+    }
+    assert(ctx.IndexOf("signer3") == 2);
+    assert(ctx.IndexOf("nobody") == -1);
+
+    // 使用环上下文签名，新旧接口交叉验证
+    std::string msg = "Test message";
+    std::string event = "Test event";
+    Signature sig = signers[0].Sign(msg, event, ctx);
+    bool verified = signers[1].Verify(sig, msg, event, ctx);
+    assert(verified);
+    verified = signers[1].Verify(sig, msg, event, ring);
+    assert(verified);
+    verified = signers[1].Verify(sig, "Wrong message", event, ctx);
+    assert(!verified);
+    free_signature(sig);
+
+    RingList others(ring.begin() + 1, ring.end());
+    Signature sig_legacy = signers[0].Sign(msg, event, others);
+    verified = signers[2].Verify(sig_legacy, msg, event, ctx);
+    assert(verified);
+    free_signature(sig_legacy);
+    std::cout << "Sign/Verify with RingContext passed." << std::endl;
+
+    // 签名者不在环中
+    RingContext without_signer = signers[1].CreateRingContext(others);
+    bool thrown = false;
+    try {
+        signers[0].Sign(msg, event, without_signer);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 重复 ID
+    RingList duplicated = ring;
+    duplicated.push_back(ring[0]);
+    thrown = false;
+    try {
+        signers[0].CreateRingContext(duplicated);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    // 直接传入成员列表的验证接口不抛出异常，重复 ID 视为验证失败
+    Signature sig_duplicated = signers[0].Sign(msg, event, ctx);
+    verified = signers[1].Verify(sig_duplicated, msg, event, duplicated);
+    assert(!verified);
+    free_signature(sig_duplicated);
+    std::cout << "Invalid rings rejected." << std::endl;
+}
+
+int main() {
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_ring_context_config.json").string();
+    std::string key_path = (dir / "test_ring_context_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+
+    ring_context_test(config_path, keygen);
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+#include <openssl/bn.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+#include "libringsign/hash_utils.h"
+#include "libringsign/sha256_multi.h"
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/transcript.h"
+
+using namespace ring_signature_lib;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+const uint32_t kSha256Iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                               0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+std::string random_bytes(std::mt19937& rng, size_t len) {
+    std::string data(len, '\0');
+    for (auto& c : data) c = static_cast<char>(rng());
+    return data;
+}
+
+// 各实现对分组数不同的多条通道与标量实现逐字一致，且 SHA-256("abc") 与标准值相同
+void kernel_test() {
+    std::mt19937 rng(1);
+    for (int k = Sha256MultiBuffer::kScalar; k <= Sha256MultiBuffer::kAvx512; ++k) {
+        auto kernel = static_cast<Sha256MultiBuffer::Kernel>(k);
+        std::cout << Sha256MultiBuffer::Name(kernel) << (Sha256MultiBuffer::IsSupported(kernel) ? " supported" : " not supported")
+                  << std::endl;
+    }
+    std::cout << "Active kernel: " << Sha256MultiBuffer::Name(Sha256MultiBuffer::Active()) << std::endl;
+
+    unsigned char abc[64] = {'a', 'b', 'c', 0x80};
+    abc[63] = 24;
+    const uint32_t expected_abc[8] = {0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223,
+                                      0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad};
+
+    for (int trial = 0; trial < 200; ++trial) {
+        size_t count = rng() % 40 + 1;
+        std::vector<std::string> data(count);
+        std::vector<std::vector<uint32_t>> initial(count, std::vector<uint32_t>(8));
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = random_bytes(rng, 64 * (rng() % 6));
+            for (auto& word : initial[i]) word = rng();
+        }
+        auto expected = initial;
+        std::vector<Sha256MultiBuffer::Lane> lanes(count);
+        for (size_t i = 0; i < count; ++i) {
+            lanes[i] = {expected[i].data(), reinterpret_cast<const unsigned char*>(data[i].data()), data[i].size() / 64};
+        }
+        Sha256MultiBuffer::Compress(Sha256MultiBuffer::kScalar, lanes.data(), count);
+
+        for (int k = Sha256MultiBuffer::kShaNi; k <= Sha256MultiBuffer::kAvx512; ++k) {
+            auto kernel = static_cast<Sha256MultiBuffer::Kernel>(k);
+            if (!Sha256MultiBuffer::IsSupported(kernel)) continue;
+            auto actual = initial;
+            for (size_t i = 0; i < count; ++i) lanes[i].state = actual[i].data();
+            Sha256MultiBuffer::Compress(kernel, lanes.data(), count);
+            assert(actual == expected);
+
+            uint32_t state[8];
+            std::memcpy(state, kSha256Iv, sizeof(state));
+            Sha256MultiBuffer::Lane lane = {state, abc, 1};
+            Sha256MultiBuffer::Compress(kernel, &lane, 1);
+            assert(std::memcmp(state, expected_abc, sizeof(state)) == 0);
+        }
+    }
+    std::cout << "Multi-buffer kernels match scalar compression." << std::endl;
+}
+
+// 增量写入与批量结束的摘要与 OpenSSL 的一次性 SHA-256 一致：覆盖分组边界、
+// 超出尾部缓冲区的剩余数据与超过通道数的批次
+void state_test() {
+    std::mt19937 rng(3);
+    for (int trial = 0; trial < 50; ++trial) {
+        size_t count = rng() % 40 + 1;
+        std::vector<std::string> prefix(count), rest(count);
+        std::vector<Sha256MultiBuffer::State> states(count);
+        std::vector<Sha256MultiBuffer::State*> pointers(count);
+        std::vector<const unsigned char*> data(count);
+        std::vector<size_t> len(count);
+        for (size_t i = 0; i < count; ++i) {
+            prefix[i] = random_bytes(rng, rng() % 300);
+            rest[i] = random_bytes(rng, rng() % (trial % 5 == 0 ? 2000 : 130));
+            Sha256MultiBuffer::Init(states[i]);
+            // 分两段写入，跨越分组边界
+            size_t split = prefix[i].size() / 3;
+            Sha256MultiBuffer::Update(states[i], prefix[i].data(), split);
+            Sha256MultiBuffer::Update(states[i], prefix[i].data() + split, prefix[i].size() - split);
+            pointers[i] = &states[i];
+            data[i] = reinterpret_cast<const unsigned char*>(rest[i].data());
+            len[i] = rest[i].size();
+        }
+        Sha256MultiBuffer::State single = states[0];
+        std::vector<unsigned char> out(32 * count);
+        Sha256MultiBuffer::FinalBatch(pointers.data(), data.data(), len.data(), out.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            std::string message = prefix[i] + rest[i];
+            unsigned char expected[SHA256_DIGEST_LENGTH];
+            SHA256(reinterpret_cast<const unsigned char*>(message.data()), message.size(), expected);
+            assert(std::memcmp(out.data() + 32 * i, expected, sizeof(expected)) == 0);
+            if (i == 0) {
+                unsigned char actual[SHA256_DIGEST_LENGTH];
+                Sha256MultiBuffer::Update(single, rest[0].data(), rest[0].size());
+                Sha256MultiBuffer::Final(single, actual);
+                assert(std::memcmp(actual, expected, sizeof(expected)) == 0);
+            }
+        }
+    }
+    std::cout << "SHA-256 states match one-shot hashing." << std::endl;
+}
+
+BIGNUM* reference_hmac(const EVP_MD* md, const std::string& key, const std::string& data) {
+    unsigned char out[EVP_MAX_MD_SIZE];
+    unsigned int len = 0;
+    HMAC(md, key.data(), static_cast<int>(key.size()), reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+         out, &len);
+    return BN_bin2bn(out, static_cast<int>(len), nullptr);
+}
+
+// 批量输出与 OpenSSL 的一次性 HMAC 一致：覆盖空数据、缓冲区刚满与溢出、已吸收的不满分组、
+// 超过分组长度的密钥、复制的公共前缀，以及与其他摘要混合的批次
+void hmac_batch_test() {
+    std::mt19937 rng(2);
+    for (size_t key_len : {0, 18, 64, 65, 100}) {
+        std::string key = random_bytes(rng, key_len);
+        HashUtils hash(key);
+        HashUtils sha512(key, "SHA512");
+        HashUtils sm3(key, "SM3");
+
+        for (int trial = 0; trial < 20; ++trial) {
+            size_t count = rng() % 40 + 1;
+            // 一半批次从同一前缀复制，前缀较长时已有分组写入了中间状态
+            std::string prefix = trial % 2 ? random_bytes(rng, rng() % 1200) : std::string();
+            HashState base(hash);
+            base.Update(prefix);
+
+            std::vector<std::string> inputs(count);
+            std::vector<HashState> states;
+            std::vector<BIGNUM*> out(count);
+            std::vector<BIGNUM*> expected(count);
+            states.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                size_t len = rng() % 6 == 0 ? HashState::kBufferSize + rng() % 3 - 1 : rng() % 700;
+                std::string suffix = random_bytes(rng, len);
+                const HashUtils& used = i % 7 == 3 ? sha512 : (i % 11 == 5 ? sm3 : hash);
+                if (&used == &hash) {
+                    states.push_back(base);
+                    // 分两次写入，后一次可能触发缓冲区写出
+                    states.back().Update(suffix.data(), len / 3);
+                    states.back().Update(suffix.data() + len / 3, len - len / 3);
+                    inputs[i] = prefix + suffix;
+                } else {
+                    states.emplace_back(used);
+                    states.back().Update(suffix);
+                    inputs[i] = suffix;
+                }
+                const EVP_MD* md = &used == &sha512 ? EVP_sha512() : (&used == &sm3 ? EVP_sm3() : EVP_sha256());
+                expected[i] = reference_hmac(md, key, inputs[i]);
+                out[i] = BN_new();
+            }
+            std::vector<HashState*> pointers;
+            for (auto& state : states) pointers.push_back(&state);
+            HashState::FinalToBnBatch(pointers.data(), out.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                assert(BN_cmp(out[i], expected[i]) == 0);
+                BN_free(out[i]);
+                BN_free(expected[i]);
+            }
+        }
+
+        // hashToBnBatch 与逐条 hashToBn 一致
+        std::vector<std::string> data;
+        for (int i = 0; i < 37; ++i) data.push_back(random_bytes(rng, rng() % 300));
+        std::vector<std::string_view> views(data.begin(), data.end());
+        std::vector<BIGNUM*> out;
+        for (size_t i = 0; i < data.size(); ++i) out.push_back(BN_new());
+        hash.hashToBnBatch(views.data(), out.data(), views.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            BIGNUM* expected = hash.hashToBn(data[i]);
+            assert(BN_cmp(out[i], expected) == 0);
+            BN_free(expected);
+            BN_free(out[i]);
+        }
+    }
+    std::cout << "Batched HMAC matches one-shot HMAC." << std::endl;
+}
+
+// 批量 transcript 与逐个输出一致，跨越多组（16 个一组）并在签名中跳过签名者
+void signer_test(const std::string& config_path, KeyGenerator& keygen) {
+    const int participant_count = 37;
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+
+    HashUtils hash("transcript_key");
+    std::vector<Transcript> transcripts;
+    std::vector<BIGNUM*> expected;
+    std::vector<BIGNUM*> out;
+    for (int i = 0; i < participant_count; ++i) {
+        Transcript transcript(hash, i % 2 ? TRANSCRIPT_VERSION_1 : TRANSCRIPT_VERSION_2);
+        transcript.AppendString("message");
+        transcript.AppendString(ring[i].first);
+        transcript.AppendPoint(signers[i].GetGroup(), ring[i].second.first, nullptr);
+        transcript.AppendPoint(signers[i].GetGroup(), ring[i].second.second, nullptr);
+        Transcript copy(transcript);
+        expected.push_back(copy.FinalToBn());
+        transcripts.push_back(std::move(transcript));
+        out.push_back(BN_new());
+    }
+    std::vector<Transcript*> pointers;
+    for (auto& transcript : transcripts) pointers.push_back(&transcript);
+    Transcript::FinalToBnBatch(pointers.data(), out.data(), out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        assert(BN_cmp(out[i], expected[i]) == 0);
+        BN_free(out[i]);
+        BN_free(expected[i]);
+    }
+
+    RingContext context = signers[0].CreateRingContext(ring);
+    for (int index : {0, 15, 16, 36}) {
+        Signature sig = signers[index].Sign("batched member hashes", "event", context);
+        bool verified = signers[5].Verify(sig, "batched member hashes", "event", context);
+        assert(verified);
+        verified = signers[5].Verify(sig, "batched member hashes!", "event", context);
+        assert(!verified);
+        std::vector<SignatureInput> inputs = {{sig, "batched member hashes", "event", context}};
+        verified = signers[5].VerifyBatch(inputs)[0];
+        assert(verified);
+        for (auto* p : sig.A) EC_POINT_free(p);
+        BN_free(sig.phi);
+        BN_free(sig.psi);
+        EC_POINT_free(sig.T);
+    }
+    std::cout << "Signatures with batched member hashes verify." << std::endl;
+}
+
+int main() {
+    kernel_test();
+    state_test();
+    hmac_batch_test();
+
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_sha256_multi_config.json").string();
+    std::string key_path = (dir / "test_sha256_multi_key.json").string();
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+    signer_test(config_path, keygen);
+    for (const auto& path : {config_path, key_path}) {
+        std::filesystem::remove(path);
+    }
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
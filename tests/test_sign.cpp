@@ -66,11 +66,12 @@ void sign_test(int participant_count) {
         print_ec_point("Full Public Key (Y_i) for " + signer_id, signer.GetGroup(), signer.GetPublicKey().second);
 
         // 验证 Signer 密钥的正确性
-        assert(signer.VerifyKey() == true);
+        bool key_valid = signer.VerifyKey();
+        assert(key_valid);
         std::cout << signer_id << " full key verification passed." << std::endl;
 
         // 将 signer 添加到列表中
-        signers.push_back(signer);
+        signers.push_back(std::move(signer));
     }
 
     // 准备 other_signer_pkc 列表用于签名（排除 signer1 自身）
@@ -87,7 +88,7 @@ void sign_test(int participant_count) {
 
     // 生成 signer1 的环签名
     std::cout << "Generating ring signature by signer1..." << std::endl;
-    auto [A, phi, psi, T] = signers[0].Sign(msg, event, other_signer_pkc);
+    auto [A, phi, psi, T, transcript_version] = signers[0].Sign(msg, event, other_signer_pkc);
 
     // 输出签名结果
     std::cout << "Ring Signature generated by signer1:" << std::endl;
@@ -9,6 +9,7 @@
 #include "libringsign/signer.h"
 #include "libringsign/key_generator.h"
 #include "libringsign/config_manager.h"
+#include "libringsign/thread_pool.h"
 
 using namespace ring_signature_lib;
 using namespace std::chrono;
@@ -24,18 +25,22 @@ std::pair<long long, long long> sign_test(int participant_count) {
     std::string msg = "Test message";
     std::string event = "Test event";
 
-    std::vector<Signer> signers;
+    // 签名者共享一份系统参数，部分密钥按硬件并发数并行批量签发
+    Signer parameters;
+    parameters.Initialize("", "config/system_config.json");
+    std::vector<Signer> signers(participant_count);
+    std::vector<std::pair<std::string, const EC_POINT*>> entries;
     for (int i = 0; i < participant_count; ++i) {
         std::string signer_id = "signer" + std::to_string(i + 1);
-        Signer signer;
-        signer.Initialize(signer_id, "config/system_config.json");
-
-        auto partial_key = signer.GeneratePartialKey();
-        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
-        signer.GenerateFullKey(partial_system_public_key, partial_private_key);
-        assert(signer.VerifyKey() == true);
-
-        signers.push_back(std::move(signer));
+        signers[i].Initialize(signer_id, parameters);
+        entries.emplace_back(signer_id, signers[i].GeneratePartialKey().second);
+    }
+    keygen.SetThreadCount(ThreadPool::DefaultThreadCount());
+    auto keys = keygen.GenerateSignKeys(entries);
+    for (int i = 0; i < participant_count; ++i) {
+        signers[i].GenerateFullKey(keys[i].first.get(), keys[i].second.get());
+        bool key_valid = signers[i].VerifyKey();
+        assert(key_valid);
     }
 
     auto keygen_end = high_resolution_clock::now();
@@ -49,7 +54,7 @@ std::pair<long long, long long> sign_test(int participant_count) {
 
     // 计时签名
     auto sign_start = high_resolution_clock::now();
-    auto [A, phi, psi, T] = signers[0].Sign(msg, event, other_signer_pkc);
+    auto [A, phi, psi, T, transcript_version] = signers[0].Sign(msg, event, other_signer_pkc);
     auto sign_end = high_resolution_clock::now();
     auto sign_duration = duration_cast<milliseconds>(sign_end - sign_start).count();
 
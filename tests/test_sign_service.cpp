@@ -0,0 +1,231 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <sys/stat.h>
+#include <nlohmann/json.hpp>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/ec_handles.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/message_digest.h"
+#include "libringsign/network_utils.h"
+#include "libringsign/sign_service.h"
+#include "libringsign/signer.h"
+
+using namespace ring_signature_lib;
+using json = nlohmann::json;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+// 按签名 JSON 验证（与 ./verify 读取签名文件的方式相同）
+bool verify_json(Signer& verifier, const json& sig_json, const std::string& msg, const std::string& event,
+                 const RingList& ring) {
+    EC_GROUP* group = verifier.GetGroup();
+    std::vector<EcPointPtr> A_handles;
+    std::vector<EC_POINT*> A;
+    for (const auto& a_hex : sig_json["A"]) {
+        A_handles.push_back(PointFromHex(group, a_hex.get<std::string>()));
+        A.push_back(A_handles.back().get());
+    }
+    BnPtr phi = BnFromHex(sig_json["phi"].get<std::string>());
+    BnPtr psi = BnFromHex(sig_json["psi"].get<std::string>());
+    EcPointPtr T = PointFromHex(group, sig_json["T"].get<std::string>());
+    return verifier.Verify(A, phi.get(), psi.get(), T.get(), msg, event, ring,
+                           sig_json["transcript_version"].get<int>());
+}
+
+json request(int fd, const json& header, const std::string& payload) {
+    SendFrame(fd, header.dump());
+    if (SignService::NeedsPayload(header)) SendFrame(fd, payload);
+    std::string response;
+    bool received = RecvFrame(fd, response);
+    assert(received);
+    return json::parse(response);
+}
+
+// 服务只加载一次密钥；环按成员集合缓存（与顺序、重复及是否包含签名者无关），按最近使用淘汰
+void service_test(const std::filesystem::path& dir, Signer& verifier, const RingList& ring) {
+    SignService service((dir / "system_config.json").string(), (dir / "signer2_config.json").string(),
+                        dir.string(), 2);
+    assert(service.SignerId() == "signer2");
+
+    json sig = service.Sign("hello", "event", {"signer1", "signer3", "signer2"});
+    assert(sig["message_mode"] == MESSAGE_MODE_RAW);
+    assert(sig["A"].size() == 3);
+    RingList ring3(ring.begin(), ring.begin() + 3);
+    bool verified = verify_json(verifier, sig, "hello", "event", ring3);
+    assert(verified);
+    verified = verify_json(verifier, sig, "hello!", "event", ring3);
+    assert(!verified);
+
+    sig = service.Sign("digest bytes", "event", {"signer3", "signer1", "signer1"}, "SHA256");
+    assert(sig["message_digest"] == "SHA256");
+    verified = verify_json(verifier, sig, "digest bytes", "event", ring3);
+    assert(verified);
+    assert(service.RingCacheMisses() == 1 && service.RingCacheHits() == 1);
+
+    // 容量为 2：加入两个新环后最早的环被淘汰
+    service.Sign("m", "event", {"signer1", "signer4"});
+    service.Sign("m", "event", {"signer3", "signer4"});
+    service.Sign("m", "event", {"signer1", "signer3"});
+    assert(service.RingCacheMisses() == 4 && service.RingCacheHits() == 1);
+
+    // 错误以响应返回，不影响服务
+    json bad = service.HandleRequest({{"op", "sign"}, {"ring", {"signer1", "nobody"}}}, "m");
+    assert(bad["status"] == "error");
+    bad = service.HandleRequest({{"op", "sign"}, {"ring", {"signer2"}}}, "m");
+    assert(bad["status"] == "error");
+    bad = service.HandleRequest({{"op", "unknown"}}, "");
+    assert(bad["status"] == "error");
+
+    // 成员 ID 拼入配置文件路径：路径分隔符、".." 与其他字符被拒绝，即使目标文件存在
+    std::string escaped = "../" + dir.filename().string() + "/signer1";
+    for (const std::string& id : {escaped, std::string("signer1/"), std::string(".."), std::string(""),
+                                  std::string("signer 1")}) {
+        bad = service.HandleRequest({{"op", "sign"}, {"ring", {"signer3", id}}, {"event", "event"}}, "m");
+        assert(bad["status"] == "error");
+    }
+
+    // 成员配置文件的修改时间变化后重新读取公钥
+    auto signer5_path = dir / "signer5_config.json";
+    std::filesystem::copy_file(dir / "signer3_config.json", signer5_path,
+                               std::filesystem::copy_options::overwrite_existing);
+    service.Sign("m", "event", {"signer5"});
+    auto mtime = std::filesystem::last_write_time(signer5_path);
+    std::filesystem::copy_file(dir / "signer4_config.json", signer5_path,
+                               std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::last_write_time(signer5_path, mtime + std::chrono::seconds(1));
+    sig = service.Sign("updated", "event", {"signer1", "signer5"});
+    RingList ring5 = {ring[0], ring[1], {"signer5", ring[3].second}};
+    verified = verify_json(verifier, sig, "updated", "event", ring5);
+    assert(verified);
+    std::filesystem::remove(signer5_path);
+    std::cout << "Sign service and ring cache passed." << std::endl;
+}
+
+// 通过 Unix 域套接字并发请求，每个连接顺序发送多条请求
+void socket_test(const std::filesystem::path& dir, Signer& verifier, const RingList& ring) {
+    SignService service((dir / "system_config.json").string(), (dir / "signer1_config.json").string(),
+                        dir.string());
+    std::string socket_path = (dir / "signd.sock").string();
+
+    // 套接字仅属主可连接；已有服务监听的路径不能再次启动（探测连接留在单独的服务端）
+    {
+        std::string probe_path = (dir / "probe.sock").string();
+        UnixSocketServer first(probe_path);
+        struct stat st;
+        int stat_result = stat(probe_path.c_str(), &st);
+        assert(stat_result == 0 && (st.st_mode & 0777) == 0600);
+        bool refused = false;
+        try {
+            UnixSocketServer second(probe_path);
+        } catch (const std::runtime_error&) {
+            refused = true;
+        }
+        assert(refused);
+    }
+
+    UnixSocketServer server(socket_path);
+
+    const int clients = 3;
+    const int requests_per_client = 3;
+    std::vector<std::thread> workers;
+    for (int c = 0; c < clients; ++c) {
+        workers.emplace_back([&] {
+            int fd = server.Accept();
+            try {
+                service.ServeConnection(fd, 1 << 20);
+            } catch (const std::exception&) {
+                // 超过大小限制的连接被关闭
+            }
+            server.Close(fd);
+        });
+    }
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            UnixSocketClient client(socket_path);
+            client.Connect();
+            for (int r = 0; r < requests_per_client; ++r) {
+                std::string msg = "client " + std::to_string(c) + " request " + std::to_string(r);
+                json response = request(client.Fd(), {{"op", "sign"}, {"ring", {"signer1", "signer2", "signer3", "signer4"}},
+                                                      {"event", "event"}}, msg);
+                assert(response["status"] == "ok");
+                assert(response["signer_id"] == "signer1");
+                bool verified = verify_json(verifier, response["signature"], msg, "event", ring);
+                assert(verified);
+            }
+            // 超过大小限制的消息帧导致服务端关闭连接
+            if (c == 0) {
+                std::string response;
+                bool received = true;
+                try {
+                    SendFrame(client.Fd(), json{{"op", "sign"}, {"ring", {"signer2"}}}.dump());
+                    SendFrame(client.Fd(), std::string((1 << 20) + 1, 'x'));
+                    received = RecvFrame(client.Fd(), response);
+                } catch (const std::exception&) {
+                    received = false;
+                }
+                assert(!received);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    UnixSocketClient client(socket_path);
+    std::thread status_worker([&] {
+        int fd = server.Accept();
+        service.ServeConnection(fd, 1 << 20);
+        server.Close(fd);
+    });
+    client.Connect();
+    json status = request(client.Fd(), {{"op", "status"}}, "");
+    assert(status["status"] == "ok");
+    assert(status["requests"] == clients * requests_per_client);
+    assert(status["cached_rings"] == 1);
+    client.Close();
+    status_worker.join();
+    for (auto& t : workers) t.join();
+
+    server.CloseServer();
+    assert(!std::filesystem::exists(socket_path));
+    std::cout << "Unix socket service passed." << std::endl;
+}
+
+int main() {
+    // 系统参数与成员配置写入临时目录，避免覆盖 config/ 下的文件
+    auto dir = std::filesystem::temp_directory_path() / "test_sign_service";
+    std::filesystem::create_directories(dir);
+    std::string config_path = (dir / "system_config.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, (dir / "system_key.json").string());
+
+    const int participant_count = 4;
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        signers[i].SaveConfig((dir / (signer_id + "_config.json")).string());
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+
+    service_test(dir, signers[3], ring);
+    socket_test(dir, signers[3], ring);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/sign_service.h"
+#include "libringsign/signature_codec.h"
+#include "libringsign/thread_pool.h"
+
+using namespace ring_signature_lib;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+void free_signature(Signature& sig) {
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+}
+
+bool same_signature(const EC_GROUP* group, const Signature& a, const Signature& b) {
+    if (a.A.size() != b.A.size() || a.transcript_version != b.transcript_version) return false;
+    for (size_t i = 0; i < a.A.size(); ++i) {
+        if (EC_POINT_cmp(group, a.A[i], b.A[i], nullptr) != 0) return false;
+    }
+    return EC_POINT_cmp(group, a.T, b.T, nullptr) == 0 && BN_cmp(a.phi, b.phi) == 0 && BN_cmp(a.psi, b.psi) == 0;
+}
+
+template <typename F>
+bool throws(F&& f) {
+    try {
+        f();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+void round_trip_test(const std::string& config_path, KeyGenerator& keygen) {
+    const int participant_count = 5;
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+    Signer& signer = signers[2];
+    const EC_GROUP* group = signer.GetGroup();
+    RingContext L = signer.CreateRingContext(ring);
+    const std::string msg = "binary signature";
+    const std::string event = "codec event";
+    Signature sig = signer.Sign(msg, event, L);
+
+    // secp256k1：每个点 33 字节、每个标量 32 字节
+    std::string encoded = EncodeSignature(group, sig, "SHA256");
+    assert(IsBinarySignature(encoded));
+    SignatureView view(encoded);
+    assert(view.RingSize() == participant_count);
+    assert(view.PointSize() == 33 && view.ScalarSize() == 32);
+    assert(view.TranscriptVersion() == sig.transcript_version);
+    assert(view.HasChecksum());
+    assert(view.MessageDigest() == "SHA256");
+    size_t body_size = (participant_count + 1) * 33 + 2 * 32;
+    assert(encoded.size() == 4 + 6 + 6 + 4 + body_size + kSignatureChecksumSize);
+
+    Signature decoded = view.Decode(group);
+    assert(same_signature(group, sig, decoded));
+    bool verified = signer.Verify(decoded, msg, event, L);
+    assert(verified);
+    free_signature(decoded);
+
+    std::string json_size_reference = SignatureToJson(group, sig, "SHA256").dump(4);
+    std::cout << "Binary signature " << encoded.size() << " bytes, JSON " << json_size_reference.size()
+              << " bytes." << std::endl;
+    assert(encoded.size() * 3 < json_size_reference.size());
+
+    // 不带校验和、原文模式
+    std::string plain = EncodeSignature(group, sig, "", false);
+    SignatureView plain_view(plain);
+    assert(!plain_view.HasChecksum() && plain_view.MessageDigest().empty());
+    assert(plain.size() == encoded.size() - kSignatureChecksumSize - 6);
+    decoded = plain_view.Decode(group);
+    assert(same_signature(group, sig, decoded));
+    free_signature(decoded);
+    std::cout << "Round trip preserved the signature." << std::endl;
+
+    // 校验和发现任意字节的损坏；截断与多余字节均被拒绝
+    for (size_t pos : {size_t(5), size_t(30), encoded.size() - 40, encoded.size() - 1}) {
+        std::string corrupted = encoded;
+        corrupted[pos] ^= 0x01;
+        bool threw = throws([&] { SignatureView v(corrupted); });
+        assert(threw);
+    }
+    bool threw = throws([&] { SignatureView v(std::string_view(encoded).substr(0, encoded.size() - 1)); });
+    assert(threw);
+    threw = throws([&] { SignatureView v(encoded + '\0'); });
+    assert(threw);
+    threw = throws([&] { SignatureView v(std::string_view(encoded).substr(0, 12)); });
+    assert(threw);
+    threw = throws([&] { SignatureView v("{\"A\": []}"); });
+    assert(threw);
+
+    // 无校验和时由解码逐项检查：无效的点前缀、不在曲线上的 x、超出阶的标量
+    size_t a0 = 4 + 6 + 4;
+    std::string bad_prefix = plain;
+    bad_prefix[a0] = 0x05;
+    threw = throws([&] { SignatureView(bad_prefix).Decode(group); });
+    assert(threw);
+
+    std::string off_curve = plain;
+    for (unsigned char x = 1;; ++x) {
+        // 约一半的 x 不对应曲线上的点
+        off_curve[a0] = 0x02;
+        for (size_t i = 1; i < 33; ++i) off_curve[a0 + i] = 0;
+        off_curve[a0 + 32] = static_cast<char>(x);
+        if (throws([&] { Signature s = SignatureView(off_curve).Decode(group); free_signature(s); })) break;
+    }
+
+    std::string big_scalar = plain;
+    size_t phi_offset = a0 + (participant_count + 1) * 33;
+    for (size_t i = 0; i < 32; ++i) big_scalar[phi_offset + i] = static_cast<char>(0xFF);
+    threw = throws([&] { SignatureView(big_scalar).Decode(group); });
+    assert(threw);
+
+    // 与曲线宽度不一致的签名被拒绝
+    EcGroupPtr p384(EC_GROUP_new_by_curve_name(NID_secp384r1));
+    threw = throws([&] { SignatureView(plain).Decode(p384.get()); });
+    assert(threw);
+    std::cout << "Corrupted and malformed signatures rejected." << std::endl;
+
+    free_signature(sig);
+}
+
+void bulk_decode_test() {
+    // 无穷远点与并行解压缩：构造一个大环的签名（点为随机倍点，不是有效签名）
+    EcGroupPtr group(EC_GROUP_new_by_curve_name(NID_secp256k1));
+    const size_t ring_size = 3000;
+    std::vector<EC_POINT*> A;
+    BnPtr k(BN_new());
+    for (size_t i = 0; i < ring_size; ++i) {
+        EC_POINT* point = EC_POINT_new(group.get());
+        BN_rand_range(k.get(), EC_GROUP_get0_order(group.get()));
+        EC_POINT_mul(group.get(), point, k.get(), nullptr, nullptr, nullptr);
+        A.push_back(point);
+    }
+    EC_POINT* T = EC_POINT_new(group.get());
+    EC_POINT_set_to_infinity(group.get(), T);
+    BIGNUM* phi = BN_new();
+    BIGNUM* psi = BN_new();
+    BN_set_word(phi, 1);
+    BN_zero(psi);
+    Signature sig(std::move(A), phi, psi, T, TRANSCRIPT_VERSION_2);
+
+    std::string encoded = EncodeSignature(group.get(), sig);
+    SignatureView view(encoded);
+    ThreadPool pool(4);
+    Signature serial = view.Decode(group.get());
+    Signature parallel = view.Decode(group.get(), &pool);
+    assert(same_signature(group.get(), sig, serial));
+    assert(same_signature(group.get(), sig, parallel));
+    assert(EC_POINT_is_at_infinity(group.get(), parallel.T));
+
+    // 并行解码中任一分块遇到无效点都使整体失败
+    std::string bad = EncodeSignature(group.get(), sig, "", false);
+    bad[4 + 6 + 4 + 2500 * 33] = 0x07;
+    bool threw = throws([&] { SignatureView(bad).Decode(group.get(), &pool); });
+    assert(threw);
+    std::cout << "Bulk decode of " << ring_size << " points matches serial decode." << std::endl;
+
+    free_signature(serial);
+    free_signature(parallel);
+    free_signature(sig);
+}
+
+int main() {
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_signature_codec_config.json").string();
+    std::string key_path = (dir / "test_signature_codec_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+
+    round_trip_test(config_path, keygen);
+    bulk_decode_test();
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
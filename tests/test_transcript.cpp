@@ -0,0 +1,221 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <vector>
+#include <filesystem>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+#include "libringsign/transcript.h"
+
+using namespace ring_signature_lib;
+using namespace std::chrono;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+// v1 编码必须与原先拼接十六进制字符串后哈希的结果逐字节一致
+void encoding_test() {
+    EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_secp256k1);
+    BN_CTX* ctx = BN_CTX_new();
+    BIGNUM* k = BN_new();
+    EC_POINT* point = EC_POINT_new(group);
+    HashUtils hash("test_key");
+
+    for (int i = 0; i < 10; ++i) {
+        BN_rand_range(k, EC_GROUP_get0_order(group));
+        EC_POINT_mul(group, point, k, nullptr, nullptr, ctx);
+
+        char* hex = EC_POINT_point2hex(group, point, POINT_CONVERSION_UNCOMPRESSED, ctx);
+        PointEncoding encoding = PointEncoding::Encode(group, point, ctx);
+        assert(encoding.hex == hex);
+
+        unsigned char compressed[33];
+        size_t compressed_len = EC_POINT_point2oct(group, point, POINT_CONVERSION_COMPRESSED, compressed, sizeof(compressed), ctx);
+        assert(compressed_len == 33);
+        assert(encoding.compressed == std::string(reinterpret_cast<char*>(compressed), 33));
+
+        BIGNUM* expected = hash.hashToBn("msg" + std::string("id") + hex + hex);
+        Transcript v1(hash, TRANSCRIPT_VERSION_1);
+        v1.AppendString("msg");
+        v1.AppendString("id");
+        v1.AppendPoint(group, point, ctx);
+        v1.AppendPoint(encoding);
+        BIGNUM* actual = v1.FinalToBn();
+        assert(BN_cmp(expected, actual) == 0);
+
+        // v2：长度前缀与压缩编码，两种写入方式结果一致
+        std::string v2_input = std::string("\0\0\0\3msg", 7) + std::string("\0\0\0\2id", 6) +
+                               std::string("\0\0\0\x21", 4) + encoding.compressed;
+        BIGNUM* expected_v2 = hash.hashToBn(v2_input);
+        Transcript v2(hash, TRANSCRIPT_VERSION_2);
+        v2.AppendString("msg");
+        v2.AppendString("id");
+        v2.AppendPoint(group, point, ctx);
+        BIGNUM* actual_v2 = v2.FinalToBn();
+        assert(BN_cmp(expected_v2, actual_v2) == 0);
+
+        OPENSSL_free(hex);
+        BN_free(expected);
+        BN_free(actual);
+        BN_free(expected_v2);
+        BN_free(actual_v2);
+    }
+
+    bool thrown = false;
+    try {
+        Transcript unsupported(hash, 3);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "Transcript encodings passed." << std::endl;
+
+    BN_free(k);
+    EC_POINT_free(point);
+    BN_CTX_free(ctx);
+    EC_GROUP_free(group);
+}
+
+// 跨越写入缓冲区边界的各种分段方式，结果都与对拼接后的数据一次哈希一致
+void buffer_test() {
+    HashUtils hash("test_key");
+    std::string data;
+    for (size_t i = 0; i < 5 * HashState::kBufferSize; ++i) data.push_back(static_cast<char>(i * 13));
+    BIGNUM* expected = hash.hashToBn(data);
+
+    for (size_t step : {1, 7, 33, 500, 511, 512, 513, 2000}) {
+        HashState state(hash);
+        for (size_t offset = 0; offset < data.size(); offset += step) {
+            state.Update(std::string_view(data).substr(offset, step));
+        }
+        state.Update("", 0);
+        BIGNUM* actual = state.FinalToBn();
+        assert(BN_cmp(expected, actual) == 0);
+        BN_free(actual);
+    }
+
+    // 在缓冲区中留有未写入数据时复制与移动
+    HashState state(hash);
+    state.Update(std::string_view(data).substr(0, 100));
+    HashState copy(state);
+    HashState moved(std::move(state));
+    copy.Update(std::string_view(data).substr(100));
+    moved.Update(std::string_view(data).substr(100));
+    BIGNUM* copied = copy.FinalToBn();
+    BIGNUM* moved_bn = moved.FinalToBn();
+    assert(BN_cmp(expected, copied) == 0);
+    assert(BN_cmp(expected, moved_bn) == 0);
+    BN_free(copied);
+    BN_free(moved_bn);
+    BN_free(expected);
+    std::cout << "Hash state buffering passed." << std::endl;
+}
+
+// 复制已写入公共前缀的 transcript 后继续写入，结果与从头写入完整输入一致
+void midstate_test() {
+    HashUtils hash("test_key");
+    std::string msg(100000, 'm');
+    std::string event = "event";
+
+    for (int version : {TRANSCRIPT_VERSION_1, TRANSCRIPT_VERSION_2}) {
+        Transcript prefix(hash, version);
+        prefix.AppendString(msg);
+        prefix.AppendString(event);
+
+        for (int i = 0; i < 5; ++i) {
+            std::string id = "member" + std::to_string(i);
+            Transcript full(hash, version);
+            full.AppendString(msg);
+            full.AppendString(event);
+            full.AppendString(id);
+            BIGNUM* expected = full.FinalToBn();
+
+            Transcript copy(prefix);
+            copy.AppendString(id);
+            BIGNUM* actual = copy.FinalToBn();
+            assert(BN_cmp(expected, actual) == 0);
+
+            Transcript assigned(hash, version);
+            assigned = prefix;
+            assigned.AppendString(id);
+            BIGNUM* actual_assigned = assigned.FinalToBn();
+            assert(BN_cmp(expected, actual_assigned) == 0);
+
+            BN_free(expected);
+            BN_free(actual);
+            BN_free(actual_assigned);
+        }
+    }
+    std::cout << "Transcript midstate copies passed." << std::endl;
+}
+
+// 在指定版本的系统下签名与验证，v1 签名仍可验证，版本不匹配时验证失败
+void version_test(int system_version, int participant_count) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_transcript_config.json").string();
+    std::string key_path = (dir / "test_transcript_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SetTranscriptVersion(system_version);
+    keygen.SaveConfig(config_path, key_path);
+
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        assert(signers[i].GetTranscriptVersion() == system_version);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        bool key_valid = signers[i].VerifyKey();
+        assert(key_valid);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+    RingList others(ring.begin() + 1, ring.end());
+    std::string msg = "Test message";
+    std::string event = "Test event";
+
+    auto start = high_resolution_clock::now();
+    Signature sig = signers[0].Sign(msg, event, others);
+    auto sign_elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+    assert(sig.transcript_version == system_version);
+
+    start = high_resolution_clock::now();
+    bool ok = signers[1].Verify(sig, msg, event, ring);
+    auto verify_elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+    assert(ok);
+    bool verified = signers[1].Verify(sig.A, sig.phi, sig.psi, sig.T, msg, event, ring, system_version);
+    assert(verified);
+    int other_version = system_version == TRANSCRIPT_VERSION_1 ? TRANSCRIPT_VERSION_2 : TRANSCRIPT_VERSION_1;
+    verified = signers[1].Verify(sig.A, sig.phi, sig.psi, sig.T, msg, event, ring, other_version);
+    assert(!verified);
+    verified = signers[1].Verify(sig.A, sig.phi, sig.psi, sig.T, msg, event, ring, 3);
+    assert(!verified);
+    std::cout << "transcript v" << system_version << "  n=" << participant_count
+              << "  sign: " << sign_elapsed / 1000.0 << " ms"
+              << "  verify: " << verify_elapsed / 1000.0 << " ms" << std::endl;
+
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+}
+
+int main(int argc, char* argv[]) {
+    int participant_count = argc > 1 ? std::stoi(argv[1]) : 20;
+    encoding_test();
+    buffer_test();
+    midstate_test();
+    version_test(TRANSCRIPT_VERSION_1, participant_count);
+    version_test(TRANSCRIPT_VERSION_2, participant_count);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <filesystem>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include "libringsign/signer.h"
+#include "libringsign/key_generator.h"
+
+using namespace ring_signature_lib;
+
+using RingList = std::vector<std::pair<std::string, std::pair<EC_POINT*, EC_POINT*>>>;
+
+void free_signature(Signature& sig) {
+    for (auto* p : sig.A) EC_POINT_free(p);
+    BN_free(sig.phi);
+    BN_free(sig.psi);
+    EC_POINT_free(sig.T);
+}
+
+void verify_batch_test(const std::string& config_path, KeyGenerator& keygen) {
+    const int participant_count = 6;
+    std::vector<Signer> signers(participant_count);
+    RingList ring;
+    for (int i = 0; i < participant_count; ++i) {
+        std::string signer_id = "signer" + std::to_string(i + 1);
+        signers[i].Initialize(signer_id, config_path);
+        auto partial_key = signers[i].GeneratePartialKey();
+        auto [partial_system_public_key, partial_private_key] = keygen.GenerateSignKey(signer_id, partial_key.second);
+        signers[i].GenerateFullKey(partial_system_public_key, partial_private_key);
+        EC_POINT_free(partial_system_public_key);
+        BN_free(partial_private_key);
+        ring.emplace_back(signer_id, signers[i].GetPublicKey());
+    }
+
+    // 两个环（一个预计算 K_i，一个不预计算）、两个事件，混合在同一批中
+    Signer& verifier = signers[0];
+    RingContext full_ring = verifier.CreateRingContext(ring);
+    RingContext small_ring = verifier.CreateRingContext(RingList(ring.begin(), ring.begin() + 3), false);
+
+    const int batch_size = 8;
+    std::vector<std::string> msgs, events;
+    std::vector<Signature> sigs;
+    std::vector<const RingContext*> rings;
+    for (int j = 0; j < batch_size; ++j) {
+        msgs.push_back("message " + std::to_string(j));
+        events.push_back(j % 2 == 0 ? "event A" : "event B");
+        const RingContext* L = j % 3 == 0 ? &small_ring : &full_ring;
+        rings.push_back(L);
+        sigs.push_back(signers[j % 3].Sign(msgs[j], events[j], *L));
+    }
+
+    std::vector<SignatureInput> inputs;
+    for (int j = 0; j < batch_size; ++j) {
+        inputs.push_back({sigs[j], msgs[j], events[j], *rings[j]});
+    }
+    std::vector<bool> results = verifier.VerifyBatch(inputs);
+    assert(results.size() == batch_size);
+    for (bool ok : results) assert(ok);
+    std::cout << "Batch of valid signatures accepted." << std::endl;
+
+    // 篡改两个签名的消息，批量验证必须准确定位
+    std::vector<std::string> tampered = msgs;
+    tampered[2] += "!";
+    tampered[7] += "!";
+    std::vector<SignatureInput> bad_inputs;
+    for (int j = 0; j < batch_size; ++j) {
+        bad_inputs.push_back({sigs[j], tampered[j], events[j], *rings[j]});
+    }
+    results = verifier.VerifyBatch(bad_inputs);
+    for (int j = 0; j < batch_size; ++j) {
+        assert(results[j] == (j != 2 && j != 7));
+        bool verified = verifier.Verify(sigs[j], tampered[j], events[j], *rings[j]);
+        assert(results[j] == verified);
+    }
+
+    // 环大小不匹配的签名直接判为无效
+    std::vector<SignatureInput> mismatched = {{sigs[0], msgs[0], events[0], full_ring},
+                                              {sigs[1], msgs[1], events[1], full_ring}};
+    results = verifier.VerifyBatch(mismatched);
+    assert(!results[0] && results[1]);
+    assert(verifier.VerifyBatch(nullptr, 0).empty());
+
+    // A_i 为空指针的签名在单个与批量验证中都判为无效
+    EC_POINT* saved = sigs[1].A[0];
+    sigs[1].A[0] = nullptr;
+    bool verified = verifier.Verify(sigs[1], msgs[1], events[1], *rings[1]);
+    assert(!verified);
+    results = verifier.VerifyBatch(&inputs[1], 1);
+    assert(!results[0]);
+    sigs[1].A[0] = saved;
+    std::cout << "Invalid signatures located by bisection." << std::endl;
+
+    for (auto& sig : sigs) free_signature(sig);
+}
+
+int main() {
+    // 配置写入临时目录，避免覆盖 config/ 下的系统参数
+    auto dir = std::filesystem::temp_directory_path();
+    std::string config_path = (dir / "test_verify_batch_config.json").string();
+    std::string key_path = (dir / "test_verify_batch_key.json").string();
+
+    KeyGenerator keygen;
+    keygen.Initialize();
+    keygen.SaveConfig(config_path, key_path);
+
+    verify_batch_test(config_path, keygen);
+
+    std::filesystem::remove(config_path);
+    std::filesystem::remove(key_path);
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}